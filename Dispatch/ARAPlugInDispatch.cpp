@@ -21,394 +21,16 @@
 namespace ARA {
 namespace PlugIn {
 
-/*******************************************************************************/
-// DocumentControllerDispatcher
-/*******************************************************************************/
-
-namespace DocumentControllerDispatcher
-{
-    // Destruction
-
-    static void ARA_CALL destroyDocumentController (ARADocumentControllerRef controllerRef) noexcept
-    {
-        fromRef (controllerRef)->destroyDocumentController ();
-    }
-
-    // Factory
-
-    static const ARAFactory* ARA_CALL getFactory (ARADocumentControllerRef controllerRef) noexcept
-    {
-        return fromRef (controllerRef)->getFactory ();
-    }
-
-    // Update Management
-
-    static void ARA_CALL beginEditing (ARADocumentControllerRef controllerRef) noexcept
-    {
-        fromRef (controllerRef)->beginEditing ();
-    }
-
-    static void ARA_CALL endEditing (ARADocumentControllerRef controllerRef) noexcept
-    {
-        fromRef (controllerRef)->endEditing ();
-    }
-
-    static void ARA_CALL notifyModelUpdates (ARADocumentControllerRef controllerRef) noexcept
-    {
-        fromRef (controllerRef)->notifyModelUpdates ();
-    }
-
-    // Archiving
-
-    static ARABool ARA_CALL beginRestoringDocumentFromArchive (ARADocumentControllerRef controllerRef, ARAArchiveReaderHostRef /*archiveReaderHostRef*/) noexcept
-    {
-        // begin-/endRestoringDocumentFromArchive () is deprecated, but can be fully mapped to supported calls
-        fromRef (controllerRef)->beginEditing ();
-        return kARATrue;
-    }
-
-    static ARABool ARA_CALL endRestoringDocumentFromArchive (ARADocumentControllerRef controllerRef, ARAArchiveReaderHostRef archiveReaderHostRef) noexcept
-    {
-        // begin-/endRestoringDocumentFromArchive () is deprecated, but can be fully mapped to supported calls
-        const auto result { fromRef (controllerRef)->restoreObjectsFromArchive (archiveReaderHostRef, nullptr) };
-        fromRef (controllerRef)->endEditing ();
-        return (result) ? kARATrue : kARAFalse;
-    }
-
-    static ARABool ARA_CALL storeDocumentToArchive (ARADocumentControllerRef controllerRef, ARAArchiveWriterHostRef archiveWriterHostRef) noexcept
-    {
-        // storeDocumentToArchive () is deprecated, but can be fully mapped to supported calls
-        return (fromRef (controllerRef)->storeObjectsToArchive (archiveWriterHostRef, nullptr)) ? kARATrue : kARAFalse;
-    }
-
-    static ARABool ARA_CALL restoreObjectsFromArchive (ARADocumentControllerRef controllerRef, ARAArchiveReaderHostRef archiveReaderHostRef, const ARARestoreObjectsFilter* filter) noexcept
-    {
-        return (fromRef (controllerRef)->restoreObjectsFromArchive (archiveReaderHostRef, filter)) ? kARATrue : kARAFalse;
-    }
-
-    static ARABool ARA_CALL storeObjectsToArchive (ARADocumentControllerRef controllerRef, ARAArchiveWriterHostRef archiveWriterHostRef, const ARAStoreObjectsFilter* filter) noexcept
-    {
-        return (fromRef (controllerRef)->storeObjectsToArchive (archiveWriterHostRef, filter)) ? kARATrue : kARAFalse;
-    }
-
-    static ARABool ARA_CALL storeAudioSourceToAudioFileChunk (ARADocumentControllerRef controllerRef, ARAArchiveWriterHostRef archiveWriterHostRef, ARAAudioSourceRef audioSourceRef, ARAPersistentID* documentArchiveID, ARABool* openAutomatically) noexcept
-    {
-        bool autoOpen { false };
-        const auto result {fromRef (controllerRef)->storeAudioSourceToAudioFileChunk (archiveWriterHostRef, audioSourceRef, documentArchiveID, &autoOpen) };
-        *openAutomatically = (autoOpen) ? kARATrue : kARAFalse;
-        return (result) ? kARATrue : kARAFalse;
-    }
-
-    // Document Management
-
-    static void ARA_CALL updateDocumentProperties (ARADocumentControllerRef controllerRef, const ARADocumentProperties* properties) noexcept
-    {
-        fromRef (controllerRef)->updateDocumentProperties (properties);
-    }
-
-    // Musical Context Management
-
-    static ARAMusicalContextRef ARA_CALL createMusicalContext (ARADocumentControllerRef controllerRef, ARAMusicalContextHostRef hostRef, const ARAMusicalContextProperties* properties) noexcept
-    {
-        return fromRef (controllerRef)->createMusicalContext (hostRef, properties);
-    }
-
-    static void ARA_CALL updateMusicalContextProperties (ARADocumentControllerRef controllerRef, ARAMusicalContextRef musicalContext, const ARAMusicalContextProperties* properties) noexcept
-    {
-        fromRef (controllerRef)->updateMusicalContextProperties (musicalContext, properties);
-    }
-
-    static void ARA_CALL destroyMusicalContext (ARADocumentControllerRef controllerRef, ARAMusicalContextRef musicalContext) noexcept
-    {
-        fromRef (controllerRef)->destroyMusicalContext (musicalContext);
-    }
-
-    static void ARA_CALL updateMusicalContextContent (ARADocumentControllerRef controllerRef, ARAMusicalContextRef musicalContextRef, const ARAContentTimeRange* range, ARAContentUpdateFlags flags) noexcept
-    {
-        fromRef (controllerRef)->updateMusicalContextContent (musicalContextRef, range, flags);
-    }
-
-    // Region Sequence Management
-
-    static ARARegionSequenceRef ARA_CALL createRegionSequence (ARADocumentControllerRef controllerRef, ARARegionSequenceHostRef hostRef, const ARARegionSequenceProperties* properties) noexcept
-    {
-        return fromRef (controllerRef)->createRegionSequence (hostRef, properties);
-    }
-
-    static void ARA_CALL updateRegionSequenceProperties (ARADocumentControllerRef controllerRef, ARARegionSequenceRef regionSequenceRef, const ARARegionSequenceProperties* properties) noexcept
-    {
-        fromRef (controllerRef)->updateRegionSequenceProperties (regionSequenceRef, properties);
-    }
-
-    static void ARA_CALL destroyRegionSequence (ARADocumentControllerRef controllerRef, ARARegionSequenceRef regionSequenceRef) noexcept
-    {
-        fromRef (controllerRef)->destroyRegionSequence (regionSequenceRef);
-    }
-
-    // Audio Source Management
-
-    static ARAAudioSourceRef ARA_CALL createAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceHostRef hostRef, const ARAAudioSourceProperties* properties) noexcept
-    {
-        return fromRef (controllerRef)->createAudioSource (hostRef, properties);
-    }
-
-    static void ARA_CALL updateAudioSourceProperties (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, const ARAAudioSourceProperties* properties) noexcept
-    {
-        fromRef (controllerRef)->updateAudioSourceProperties (audioSourceRef, properties);
-    }
-
-    static void ARA_CALL updateAudioSourceContent (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, const ARAContentTimeRange* range, ARAContentUpdateFlags flags) noexcept
-    {
-        fromRef (controllerRef)->updateAudioSourceContent (audioSourceRef, range, flags);
-    }
-
-    static void ARA_CALL enableAudioSourceSamplesAccess (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARABool enable) noexcept
-    {
-        fromRef (controllerRef)->enableAudioSourceSamplesAccess (audioSourceRef, enable != kARAFalse);
-    }
-
-    static void ARA_CALL deactivateAudioSourceForUndoHistory (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARABool enable) noexcept
-    {
-        fromRef (controllerRef)->deactivateAudioSourceForUndoHistory (audioSourceRef, enable != kARAFalse);
-    }
-
-    static void ARA_CALL destroyAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef) noexcept
-    {
-        fromRef (controllerRef)->destroyAudioSource (audioSourceRef);
-    }
-
-    // Audio Modification Management
-
-    static ARAAudioModificationRef ARA_CALL createAudioModification (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef,
-                                                                     ARAAudioModificationHostRef hostRef, const ARAAudioModificationProperties* properties) noexcept
-    {
-        return fromRef (controllerRef)->createAudioModification (audioSourceRef, hostRef, properties);
-    }
-
-    static ARAAudioModificationRef ARA_CALL cloneAudioModification (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef,
-                                                                    ARAAudioModificationHostRef hostRef, const ARAAudioModificationProperties* properties) noexcept
-    {
-        return fromRef (controllerRef)->cloneAudioModification (audioModificationRef, hostRef, properties);
-    }
-
-    static void ARA_CALL updateAudioModificationProperties (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, const ARAAudioModificationProperties* properties) noexcept
-    {
-        fromRef (controllerRef)->updateAudioModificationProperties (audioModificationRef, properties);
-    }
-
-    static ARABool ARA_CALL isAudioModificationPreservingAudioSourceSignal (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef) noexcept
-    {
-        return fromRef (controllerRef)->isAudioModificationPreservingAudioSourceSignal (audioModificationRef) ? kARATrue : kARAFalse;
-    }
-
-    static void ARA_CALL deactivateAudioModificationForUndoHistory (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, ARABool enable) noexcept
-    {
-        fromRef (controllerRef)->deactivateAudioModificationForUndoHistory (audioModificationRef, enable != kARAFalse);
-    }
-
-    static void ARA_CALL destroyAudioModification (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef) noexcept
-    {
-        fromRef (controllerRef)->destroyAudioModification (audioModificationRef);
-    }
-
-    // Playback Region Management
-
-    static ARAPlaybackRegionRef ARA_CALL createPlaybackRegion (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef,
-                                                               ARAPlaybackRegionHostRef hostRef, const ARAPlaybackRegionProperties* properties) noexcept
-    {
-        return fromRef (controllerRef)->createPlaybackRegion (audioModificationRef, hostRef, properties);
-    }
-
-    static void ARA_CALL updatePlaybackRegionProperties (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef, const ARAPlaybackRegionProperties* properties) noexcept
-    {
-        fromRef (controllerRef)->updatePlaybackRegionProperties (playbackRegionRef, properties);
-    }
-
-    static void ARA_CALL destroyPlaybackRegion (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef) noexcept
-    {
-        fromRef (controllerRef)->destroyPlaybackRegion (playbackRegionRef);
-    }
-
-    static void ARA_CALL getPlaybackRegionHeadAndTailTime (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef,
-                                                           ARATimeDuration* headTime, ARATimeDuration* tailTime) noexcept
-    {
-        fromRef (controllerRef)->getPlaybackRegionHeadAndTailTime (playbackRegionRef, headTime, tailTime);
-    }
-
-    // Content Reader Management
-
-    static ARABool ARA_CALL isAudioSourceContentAvailable (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
-    {
-        return (fromRef (controllerRef)->isAudioSourceContentAvailable (audioSourceRef, type)) ? kARATrue : kARAFalse;
-    }
-
-    static ARAContentGrade ARA_CALL getAudioSourceContentGrade (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
-    {
-        return fromRef (controllerRef)->getAudioSourceContentGrade (audioSourceRef, type);
-    }
-
-    static ARAContentReaderRef ARA_CALL createAudioSourceContentReader (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef,
-                                                                        ARAContentType type, const ARAContentTimeRange* range) noexcept
-    {
-        return fromRef (controllerRef)->createAudioSourceContentReader (audioSourceRef, type, range);
-    }
-
-    static ARABool ARA_CALL isAudioModificationContentAvailable (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, ARAContentType type) noexcept
-    {
-        return (fromRef (controllerRef)->isAudioModificationContentAvailable (audioModificationRef, type)) ? kARATrue : kARAFalse;
-    }
-
-    static ARAContentGrade ARA_CALL getAudioModificationContentGrade (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, ARAContentType type) noexcept
-    {
-        return fromRef (controllerRef)->getAudioModificationContentGrade (audioModificationRef, type);
-    }
-
-    static ARAContentReaderRef ARA_CALL createAudioModificationContentReader (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef,
-                                                                              ARAContentType type, const ARAContentTimeRange* range) noexcept
-    {
-        return fromRef (controllerRef)->createAudioModificationContentReader (audioModificationRef, type, range);
-    }
-
-    static ARABool ARA_CALL isPlaybackRegionContentAvailable (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef, ARAContentType type) noexcept
-    {
-        return (fromRef (controllerRef)->isPlaybackRegionContentAvailable (playbackRegionRef, type)) ? kARATrue : kARAFalse;
-    }
-
-    static ARAContentGrade ARA_CALL getPlaybackRegionContentGrade (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef, ARAContentType type) noexcept
-    {
-        return fromRef (controllerRef)->getPlaybackRegionContentGrade (playbackRegionRef, type);
-    }
-
-    static ARAContentReaderRef ARA_CALL createPlaybackRegionContentReader (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef,
-                                                                           ARAContentType type, const ARAContentTimeRange* range) noexcept
-    {
-        return fromRef (controllerRef)->createPlaybackRegionContentReader (playbackRegionRef, type, range);
-    }
-
-    static ARAInt32 ARA_CALL getContentReaderEventCount (ARADocumentControllerRef controllerRef, ARAContentReaderRef contentReaderRef) noexcept
-    {
-        return fromRef (controllerRef)->getContentReaderEventCount (contentReaderRef);
-    }
-
-    static const void* ARA_CALL getContentReaderDataForEvent (ARADocumentControllerRef controllerRef, ARAContentReaderRef contentReaderRef, ARAInt32 eventIndex) noexcept
-    {
-        return fromRef (controllerRef)->getContentReaderDataForEvent (contentReaderRef, eventIndex);
-    }
-
-    static void ARA_CALL destroyContentReader (ARADocumentControllerRef controllerRef, ARAContentReaderRef contentReaderRef) noexcept
-    {
-        fromRef (controllerRef)->destroyContentReader (contentReaderRef);
-    }
-
-    // Controlling Analysis
-
-    static ARABool ARA_CALL isAudioSourceContentAnalysisIncomplete (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
-    {
-        return (fromRef (controllerRef)->isAudioSourceContentAnalysisIncomplete (audioSourceRef, type)) ? kARATrue : kARAFalse;
-    }
-
-    static void ARA_CALL requestAudioSourceContentAnalysis (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef,
-                                                            ARASize contentTypesCount, const ARAContentType contentTypes[]) noexcept
-    {
-        fromRef (controllerRef)->requestAudioSourceContentAnalysis (audioSourceRef, contentTypesCount, contentTypes);
-    }
-
-    static ARAInt32 ARA_CALL getProcessingAlgorithmsCount (ARADocumentControllerRef controllerRef) noexcept
-    {
-        return fromRef (controllerRef)->getProcessingAlgorithmsCount ();
-    }
-
-    static const ARAProcessingAlgorithmProperties* ARA_CALL getProcessingAlgorithmProperties (ARADocumentControllerRef controllerRef, ARAInt32 algorithmIndex) noexcept
-    {
-        return fromRef (controllerRef)->getProcessingAlgorithmProperties (algorithmIndex);
-    }
-
-    static ARAInt32 ARA_CALL getProcessingAlgorithmForAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef) noexcept
-    {
-        return fromRef (controllerRef)->getProcessingAlgorithmForAudioSource (audioSourceRef);
-    }
-
-    static void ARA_CALL requestProcessingAlgorithmForAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAInt32 algorithmIndex) noexcept
-    {
-        fromRef (controllerRef)->requestProcessingAlgorithmForAudioSource (audioSourceRef, algorithmIndex);
-    }
-
-    // License Management
-
-    static ARABool ARA_CALL isLicensedForCapabilities (ARADocumentControllerRef controllerRef, ARABool runModalActivationDialogIfNeeded, ARASize contentTypesCount, const ARAContentType contentTypes[], ARAPlaybackTransformationFlags transformationFlags) noexcept
-    {
-        return (fromRef (controllerRef)->isLicensedForCapabilities ((runModalActivationDialogIfNeeded != kARAFalse), contentTypesCount, contentTypes, transformationFlags)) ? kARATrue : kARAFalse;
-    }
-
-    static const ARADocumentControllerInterface* getInterface () noexcept
-    {
-        static const SizedStruct<ARA_STRUCT_MEMBER (ARADocumentControllerInterface, isAudioModificationPreservingAudioSourceSignal)> ifc =
-        {
-            DocumentControllerDispatcher::destroyDocumentController,
-            DocumentControllerDispatcher::getFactory,
-            DocumentControllerDispatcher::beginEditing,
-            DocumentControllerDispatcher::endEditing,
-            DocumentControllerDispatcher::notifyModelUpdates,
-            DocumentControllerDispatcher::beginRestoringDocumentFromArchive,
-            DocumentControllerDispatcher::endRestoringDocumentFromArchive,
-            DocumentControllerDispatcher::storeDocumentToArchive,
-            DocumentControllerDispatcher::updateDocumentProperties,
-            DocumentControllerDispatcher::createMusicalContext,
-            DocumentControllerDispatcher::updateMusicalContextProperties,
-            DocumentControllerDispatcher::updateMusicalContextContent,
-            DocumentControllerDispatcher::destroyMusicalContext,
-            DocumentControllerDispatcher::createAudioSource,
-            DocumentControllerDispatcher::updateAudioSourceProperties,
-            DocumentControllerDispatcher::updateAudioSourceContent,
-            DocumentControllerDispatcher::enableAudioSourceSamplesAccess,
-            DocumentControllerDispatcher::deactivateAudioSourceForUndoHistory,
-            DocumentControllerDispatcher::destroyAudioSource,
-            DocumentControllerDispatcher::createAudioModification,
-            DocumentControllerDispatcher::cloneAudioModification,
-            DocumentControllerDispatcher::updateAudioModificationProperties,
-            DocumentControllerDispatcher::deactivateAudioModificationForUndoHistory,
-            DocumentControllerDispatcher::destroyAudioModification,
-            DocumentControllerDispatcher::createPlaybackRegion,
-            DocumentControllerDispatcher::updatePlaybackRegionProperties,
-            DocumentControllerDispatcher::destroyPlaybackRegion,
-            DocumentControllerDispatcher::isAudioSourceContentAvailable,
-            DocumentControllerDispatcher::isAudioSourceContentAnalysisIncomplete,
-            DocumentControllerDispatcher::requestAudioSourceContentAnalysis,
-            DocumentControllerDispatcher::getAudioSourceContentGrade,
-            DocumentControllerDispatcher::createAudioSourceContentReader,
-            DocumentControllerDispatcher::isAudioModificationContentAvailable,
-            DocumentControllerDispatcher::getAudioModificationContentGrade,
-            DocumentControllerDispatcher::createAudioModificationContentReader,
-            DocumentControllerDispatcher::isPlaybackRegionContentAvailable,
-            DocumentControllerDispatcher::getPlaybackRegionContentGrade,
-            DocumentControllerDispatcher::createPlaybackRegionContentReader,
-            DocumentControllerDispatcher::getContentReaderEventCount,
-            DocumentControllerDispatcher::getContentReaderDataForEvent,
-            DocumentControllerDispatcher::destroyContentReader,
-            DocumentControllerDispatcher::createRegionSequence,
-            DocumentControllerDispatcher::updateRegionSequenceProperties,
-            DocumentControllerDispatcher::destroyRegionSequence,
-            DocumentControllerDispatcher::getPlaybackRegionHeadAndTailTime,
-            DocumentControllerDispatcher::restoreObjectsFromArchive,
-            DocumentControllerDispatcher::storeObjectsToArchive,
-            DocumentControllerDispatcher::getProcessingAlgorithmsCount,
-            DocumentControllerDispatcher::getProcessingAlgorithmProperties,
-            DocumentControllerDispatcher::getProcessingAlgorithmForAudioSource,
-            DocumentControllerDispatcher::requestProcessingAlgorithmForAudioSource,
-            DocumentControllerDispatcher::isLicensedForCapabilities,
-            DocumentControllerDispatcher::storeAudioSourceToAudioFileChunk,
-            DocumentControllerDispatcher::isAudioModificationPreservingAudioSourceSignal
-        };
-        return &ifc;
-    }
-}
-
 /*******************************************************************************/
 // DocumentControllerInstance
 /*******************************************************************************/
 
 DocumentControllerInstance::DocumentControllerInstance (DocumentControllerInterface* documentController) noexcept
-: BaseType { toRef (documentController), DocumentControllerDispatcher::getInterface () }
+: DocumentControllerInstance { documentController, DocumentControllerDispatcher<>::getInterface () }
+{}
+
+DocumentControllerInstance::DocumentControllerInstance (DocumentControllerInterface* documentController, const ARADocumentControllerInterface* controllerInterface) noexcept
+: BaseType { toRef (documentController), controllerInterface }
 {}
 
 /*******************************************************************************/
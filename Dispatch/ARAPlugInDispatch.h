@@ -245,6 +245,413 @@ public:
 };
 ARA_MAP_REF (DocumentControllerInterface, ARADocumentControllerRef)
 
+/*******************************************************************************/
+// DocumentControllerDispatcher
+/** Provides the ARADocumentControllerInterface function table which forwards each call to the
+    DocumentControllerInterface implementation referenced by the ARADocumentControllerRef.
+    By default, the calls are dispatched through the virtual functions of DocumentControllerInterface.
+    Alternatively, the table can be bound at compile time to the final implementation class by using
+    it as \p DocumentControllerType (for ARAPlug-based plug-ins, see DocumentController::enableStaticDispatch ()).
+    That class must be declared final, so that the compiler can resolve the calls statically and inline
+    the implementation, removing the virtual indirection from frequent calls such as
+    getContentReaderDataForEvent (). This is enforced when compiling as C++14 or later - with C++11,
+    a class that is not final still compiles, but all calls then remain virtual.
+ */
+/*******************************************************************************/
+
+template <typename DocumentControllerType = DocumentControllerInterface>
+class DocumentControllerDispatcher
+{
+    static_assert (std::is_base_of<DocumentControllerInterface, DocumentControllerType>::value, "DocumentControllerType must implement DocumentControllerInterface");
+#if __cplusplus >= 201402L
+    static_assert (std::is_same<DocumentControllerInterface, DocumentControllerType>::value || std::is_final<DocumentControllerType>::value,
+                   "DocumentControllerType must be declared final, otherwise the calls cannot be resolved statically");
+#endif
+
+public:
+    //! The function table to be used as ARADocumentControllerInstance::documentControllerInterface.
+    static const ARADocumentControllerInterface* getInterface () noexcept
+    {
+        static const SizedStruct<ARA_STRUCT_MEMBER (ARADocumentControllerInterface, isAudioModificationPreservingAudioSourceSignal)> ifc =
+        {
+            DocumentControllerDispatcher::destroyDocumentController,
+            DocumentControllerDispatcher::getFactory,
+            DocumentControllerDispatcher::beginEditing,
+            DocumentControllerDispatcher::endEditing,
+            DocumentControllerDispatcher::notifyModelUpdates,
+            DocumentControllerDispatcher::beginRestoringDocumentFromArchive,
+            DocumentControllerDispatcher::endRestoringDocumentFromArchive,
+            DocumentControllerDispatcher::storeDocumentToArchive,
+            DocumentControllerDispatcher::updateDocumentProperties,
+            DocumentControllerDispatcher::createMusicalContext,
+            DocumentControllerDispatcher::updateMusicalContextProperties,
+            DocumentControllerDispatcher::updateMusicalContextContent,
+            DocumentControllerDispatcher::destroyMusicalContext,
+            DocumentControllerDispatcher::createAudioSource,
+            DocumentControllerDispatcher::updateAudioSourceProperties,
+            DocumentControllerDispatcher::updateAudioSourceContent,
+            DocumentControllerDispatcher::enableAudioSourceSamplesAccess,
+            DocumentControllerDispatcher::deactivateAudioSourceForUndoHistory,
+            DocumentControllerDispatcher::destroyAudioSource,
+            DocumentControllerDispatcher::createAudioModification,
+            DocumentControllerDispatcher::cloneAudioModification,
+            DocumentControllerDispatcher::updateAudioModificationProperties,
+            DocumentControllerDispatcher::deactivateAudioModificationForUndoHistory,
+            DocumentControllerDispatcher::destroyAudioModification,
+            DocumentControllerDispatcher::createPlaybackRegion,
+            DocumentControllerDispatcher::updatePlaybackRegionProperties,
+            DocumentControllerDispatcher::destroyPlaybackRegion,
+            DocumentControllerDispatcher::isAudioSourceContentAvailable,
+            DocumentControllerDispatcher::isAudioSourceContentAnalysisIncomplete,
+            DocumentControllerDispatcher::requestAudioSourceContentAnalysis,
+            DocumentControllerDispatcher::getAudioSourceContentGrade,
+            DocumentControllerDispatcher::createAudioSourceContentReader,
+            DocumentControllerDispatcher::isAudioModificationContentAvailable,
+            DocumentControllerDispatcher::getAudioModificationContentGrade,
+            DocumentControllerDispatcher::createAudioModificationContentReader,
+            DocumentControllerDispatcher::isPlaybackRegionContentAvailable,
+            DocumentControllerDispatcher::getPlaybackRegionContentGrade,
+            DocumentControllerDispatcher::createPlaybackRegionContentReader,
+            DocumentControllerDispatcher::getContentReaderEventCount,
+            DocumentControllerDispatcher::getContentReaderDataForEvent,
+            DocumentControllerDispatcher::destroyContentReader,
+            DocumentControllerDispatcher::createRegionSequence,
+            DocumentControllerDispatcher::updateRegionSequenceProperties,
+            DocumentControllerDispatcher::destroyRegionSequence,
+            DocumentControllerDispatcher::getPlaybackRegionHeadAndTailTime,
+            DocumentControllerDispatcher::restoreObjectsFromArchive,
+            DocumentControllerDispatcher::storeObjectsToArchive,
+            DocumentControllerDispatcher::getProcessingAlgorithmsCount,
+            DocumentControllerDispatcher::getProcessingAlgorithmProperties,
+            DocumentControllerDispatcher::getProcessingAlgorithmForAudioSource,
+            DocumentControllerDispatcher::requestProcessingAlgorithmForAudioSource,
+            DocumentControllerDispatcher::isLicensedForCapabilities,
+            DocumentControllerDispatcher::storeAudioSourceToAudioFileChunk,
+            DocumentControllerDispatcher::isAudioModificationPreservingAudioSourceSignal
+        };
+        return &ifc;
+    }
+
+private:
+    static inline DocumentControllerType* fromControllerRef (ARADocumentControllerRef controllerRef) noexcept
+    {
+        return static_cast<DocumentControllerType*> (fromRef (controllerRef));
+    }
+
+    // Destruction
+
+    static void ARA_CALL destroyDocumentController (ARADocumentControllerRef controllerRef) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyDocumentController ();
+    }
+
+    // Factory
+
+    static const ARAFactory* ARA_CALL getFactory (ARADocumentControllerRef controllerRef) noexcept
+    {
+        return fromControllerRef (controllerRef)->getFactory ();
+    }
+
+    // Update Management
+
+    static void ARA_CALL beginEditing (ARADocumentControllerRef controllerRef) noexcept
+    {
+        fromControllerRef (controllerRef)->beginEditing ();
+    }
+
+    static void ARA_CALL endEditing (ARADocumentControllerRef controllerRef) noexcept
+    {
+        fromControllerRef (controllerRef)->endEditing ();
+    }
+
+    static void ARA_CALL notifyModelUpdates (ARADocumentControllerRef controllerRef) noexcept
+    {
+        fromControllerRef (controllerRef)->notifyModelUpdates ();
+    }
+
+    // Archiving
+
+    static ARABool ARA_CALL beginRestoringDocumentFromArchive (ARADocumentControllerRef controllerRef, ARAArchiveReaderHostRef /*archiveReaderHostRef*/) noexcept
+    {
+        // begin-/endRestoringDocumentFromArchive () is deprecated, but can be fully mapped to supported calls
+        fromControllerRef (controllerRef)->beginEditing ();
+        return kARATrue;
+    }
+
+    static ARABool ARA_CALL endRestoringDocumentFromArchive (ARADocumentControllerRef controllerRef, ARAArchiveReaderHostRef archiveReaderHostRef) noexcept
+    {
+        // begin-/endRestoringDocumentFromArchive () is deprecated, but can be fully mapped to supported calls
+        const auto result { fromControllerRef (controllerRef)->restoreObjectsFromArchive (archiveReaderHostRef, nullptr) };
+        fromControllerRef (controllerRef)->endEditing ();
+        return (result) ? kARATrue : kARAFalse;
+    }
+
+    static ARABool ARA_CALL storeDocumentToArchive (ARADocumentControllerRef controllerRef, ARAArchiveWriterHostRef archiveWriterHostRef) noexcept
+    {
+        // storeDocumentToArchive () is deprecated, but can be fully mapped to supported calls
+        return (fromControllerRef (controllerRef)->storeObjectsToArchive (archiveWriterHostRef, nullptr)) ? kARATrue : kARAFalse;
+    }
+
+    static ARABool ARA_CALL restoreObjectsFromArchive (ARADocumentControllerRef controllerRef, ARAArchiveReaderHostRef archiveReaderHostRef, const ARARestoreObjectsFilter* filter) noexcept
+    {
+        return (fromControllerRef (controllerRef)->restoreObjectsFromArchive (archiveReaderHostRef, filter)) ? kARATrue : kARAFalse;
+    }
+
+    static ARABool ARA_CALL storeObjectsToArchive (ARADocumentControllerRef controllerRef, ARAArchiveWriterHostRef archiveWriterHostRef, const ARAStoreObjectsFilter* filter) noexcept
+    {
+        return (fromControllerRef (controllerRef)->storeObjectsToArchive (archiveWriterHostRef, filter)) ? kARATrue : kARAFalse;
+    }
+
+    static ARABool ARA_CALL storeAudioSourceToAudioFileChunk (ARADocumentControllerRef controllerRef, ARAArchiveWriterHostRef archiveWriterHostRef, ARAAudioSourceRef audioSourceRef, ARAPersistentID* documentArchiveID, ARABool* openAutomatically) noexcept
+    {
+        bool autoOpen { false };
+        const auto result {fromControllerRef (controllerRef)->storeAudioSourceToAudioFileChunk (archiveWriterHostRef, audioSourceRef, documentArchiveID, &autoOpen) };
+        *openAutomatically = (autoOpen) ? kARATrue : kARAFalse;
+        return (result) ? kARATrue : kARAFalse;
+    }
+
+    // Document Management
+
+    static void ARA_CALL updateDocumentProperties (ARADocumentControllerRef controllerRef, const ARADocumentProperties* properties) noexcept
+    {
+        fromControllerRef (controllerRef)->updateDocumentProperties (properties);
+    }
+
+    // Musical Context Management
+
+    static ARAMusicalContextRef ARA_CALL createMusicalContext (ARADocumentControllerRef controllerRef, ARAMusicalContextHostRef hostRef, const ARAMusicalContextProperties* properties) noexcept
+    {
+        return fromControllerRef (controllerRef)->createMusicalContext (hostRef, properties);
+    }
+
+    static void ARA_CALL updateMusicalContextProperties (ARADocumentControllerRef controllerRef, ARAMusicalContextRef musicalContext, const ARAMusicalContextProperties* properties) noexcept
+    {
+        fromControllerRef (controllerRef)->updateMusicalContextProperties (musicalContext, properties);
+    }
+
+    static void ARA_CALL destroyMusicalContext (ARADocumentControllerRef controllerRef, ARAMusicalContextRef musicalContext) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyMusicalContext (musicalContext);
+    }
+
+    static void ARA_CALL updateMusicalContextContent (ARADocumentControllerRef controllerRef, ARAMusicalContextRef musicalContextRef, const ARAContentTimeRange* range, ARAContentUpdateFlags flags) noexcept
+    {
+        fromControllerRef (controllerRef)->updateMusicalContextContent (musicalContextRef, range, flags);
+    }
+
+    // Region Sequence Management
+
+    static ARARegionSequenceRef ARA_CALL createRegionSequence (ARADocumentControllerRef controllerRef, ARARegionSequenceHostRef hostRef, const ARARegionSequenceProperties* properties) noexcept
+    {
+        return fromControllerRef (controllerRef)->createRegionSequence (hostRef, properties);
+    }
+
+    static void ARA_CALL updateRegionSequenceProperties (ARADocumentControllerRef controllerRef, ARARegionSequenceRef regionSequenceRef, const ARARegionSequenceProperties* properties) noexcept
+    {
+        fromControllerRef (controllerRef)->updateRegionSequenceProperties (regionSequenceRef, properties);
+    }
+
+    static void ARA_CALL destroyRegionSequence (ARADocumentControllerRef controllerRef, ARARegionSequenceRef regionSequenceRef) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyRegionSequence (regionSequenceRef);
+    }
+
+    // Audio Source Management
+
+    static ARAAudioSourceRef ARA_CALL createAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceHostRef hostRef, const ARAAudioSourceProperties* properties) noexcept
+    {
+        return fromControllerRef (controllerRef)->createAudioSource (hostRef, properties);
+    }
+
+    static void ARA_CALL updateAudioSourceProperties (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, const ARAAudioSourceProperties* properties) noexcept
+    {
+        fromControllerRef (controllerRef)->updateAudioSourceProperties (audioSourceRef, properties);
+    }
+
+    static void ARA_CALL updateAudioSourceContent (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, const ARAContentTimeRange* range, ARAContentUpdateFlags flags) noexcept
+    {
+        fromControllerRef (controllerRef)->updateAudioSourceContent (audioSourceRef, range, flags);
+    }
+
+    static void ARA_CALL enableAudioSourceSamplesAccess (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARABool enable) noexcept
+    {
+        fromControllerRef (controllerRef)->enableAudioSourceSamplesAccess (audioSourceRef, enable != kARAFalse);
+    }
+
+    static void ARA_CALL deactivateAudioSourceForUndoHistory (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARABool enable) noexcept
+    {
+        fromControllerRef (controllerRef)->deactivateAudioSourceForUndoHistory (audioSourceRef, enable != kARAFalse);
+    }
+
+    static void ARA_CALL destroyAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyAudioSource (audioSourceRef);
+    }
+
+    // Audio Modification Management
+
+    static ARAAudioModificationRef ARA_CALL createAudioModification (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef,
+                                                                     ARAAudioModificationHostRef hostRef, const ARAAudioModificationProperties* properties) noexcept
+    {
+        return fromControllerRef (controllerRef)->createAudioModification (audioSourceRef, hostRef, properties);
+    }
+
+    static ARAAudioModificationRef ARA_CALL cloneAudioModification (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef,
+                                                                    ARAAudioModificationHostRef hostRef, const ARAAudioModificationProperties* properties) noexcept
+    {
+        return fromControllerRef (controllerRef)->cloneAudioModification (audioModificationRef, hostRef, properties);
+    }
+
+    static void ARA_CALL updateAudioModificationProperties (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, const ARAAudioModificationProperties* properties) noexcept
+    {
+        fromControllerRef (controllerRef)->updateAudioModificationProperties (audioModificationRef, properties);
+    }
+
+    static ARABool ARA_CALL isAudioModificationPreservingAudioSourceSignal (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef) noexcept
+    {
+        return fromControllerRef (controllerRef)->isAudioModificationPreservingAudioSourceSignal (audioModificationRef) ? kARATrue : kARAFalse;
+    }
+
+    static void ARA_CALL deactivateAudioModificationForUndoHistory (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, ARABool enable) noexcept
+    {
+        fromControllerRef (controllerRef)->deactivateAudioModificationForUndoHistory (audioModificationRef, enable != kARAFalse);
+    }
+
+    static void ARA_CALL destroyAudioModification (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyAudioModification (audioModificationRef);
+    }
+
+    // Playback Region Management
+
+    static ARAPlaybackRegionRef ARA_CALL createPlaybackRegion (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef,
+                                                               ARAPlaybackRegionHostRef hostRef, const ARAPlaybackRegionProperties* properties) noexcept
+    {
+        return fromControllerRef (controllerRef)->createPlaybackRegion (audioModificationRef, hostRef, properties);
+    }
+
+    static void ARA_CALL updatePlaybackRegionProperties (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef, const ARAPlaybackRegionProperties* properties) noexcept
+    {
+        fromControllerRef (controllerRef)->updatePlaybackRegionProperties (playbackRegionRef, properties);
+    }
+
+    static void ARA_CALL destroyPlaybackRegion (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyPlaybackRegion (playbackRegionRef);
+    }
+
+    static void ARA_CALL getPlaybackRegionHeadAndTailTime (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef,
+                                                           ARATimeDuration* headTime, ARATimeDuration* tailTime) noexcept
+    {
+        fromControllerRef (controllerRef)->getPlaybackRegionHeadAndTailTime (playbackRegionRef, headTime, tailTime);
+    }
+
+    // Content Reader Management
+
+    static ARABool ARA_CALL isAudioSourceContentAvailable (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
+    {
+        return (fromControllerRef (controllerRef)->isAudioSourceContentAvailable (audioSourceRef, type)) ? kARATrue : kARAFalse;
+    }
+
+    static ARAContentGrade ARA_CALL getAudioSourceContentGrade (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
+    {
+        return fromControllerRef (controllerRef)->getAudioSourceContentGrade (audioSourceRef, type);
+    }
+
+    static ARAContentReaderRef ARA_CALL createAudioSourceContentReader (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef,
+                                                                        ARAContentType type, const ARAContentTimeRange* range) noexcept
+    {
+        return fromControllerRef (controllerRef)->createAudioSourceContentReader (audioSourceRef, type, range);
+    }
+
+    static ARABool ARA_CALL isAudioModificationContentAvailable (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, ARAContentType type) noexcept
+    {
+        return (fromControllerRef (controllerRef)->isAudioModificationContentAvailable (audioModificationRef, type)) ? kARATrue : kARAFalse;
+    }
+
+    static ARAContentGrade ARA_CALL getAudioModificationContentGrade (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef, ARAContentType type) noexcept
+    {
+        return fromControllerRef (controllerRef)->getAudioModificationContentGrade (audioModificationRef, type);
+    }
+
+    static ARAContentReaderRef ARA_CALL createAudioModificationContentReader (ARADocumentControllerRef controllerRef, ARAAudioModificationRef audioModificationRef,
+                                                                              ARAContentType type, const ARAContentTimeRange* range) noexcept
+    {
+        return fromControllerRef (controllerRef)->createAudioModificationContentReader (audioModificationRef, type, range);
+    }
+
+    static ARABool ARA_CALL isPlaybackRegionContentAvailable (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef, ARAContentType type) noexcept
+    {
+        return (fromControllerRef (controllerRef)->isPlaybackRegionContentAvailable (playbackRegionRef, type)) ? kARATrue : kARAFalse;
+    }
+
+    static ARAContentGrade ARA_CALL getPlaybackRegionContentGrade (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef, ARAContentType type) noexcept
+    {
+        return fromControllerRef (controllerRef)->getPlaybackRegionContentGrade (playbackRegionRef, type);
+    }
+
+    static ARAContentReaderRef ARA_CALL createPlaybackRegionContentReader (ARADocumentControllerRef controllerRef, ARAPlaybackRegionRef playbackRegionRef,
+                                                                           ARAContentType type, const ARAContentTimeRange* range) noexcept
+    {
+        return fromControllerRef (controllerRef)->createPlaybackRegionContentReader (playbackRegionRef, type, range);
+    }
+
+    static ARAInt32 ARA_CALL getContentReaderEventCount (ARADocumentControllerRef controllerRef, ARAContentReaderRef contentReaderRef) noexcept
+    {
+        return fromControllerRef (controllerRef)->getContentReaderEventCount (contentReaderRef);
+    }
+
+    static const void* ARA_CALL getContentReaderDataForEvent (ARADocumentControllerRef controllerRef, ARAContentReaderRef contentReaderRef, ARAInt32 eventIndex) noexcept
+    {
+        return fromControllerRef (controllerRef)->getContentReaderDataForEvent (contentReaderRef, eventIndex);
+    }
+
+    static void ARA_CALL destroyContentReader (ARADocumentControllerRef controllerRef, ARAContentReaderRef contentReaderRef) noexcept
+    {
+        fromControllerRef (controllerRef)->destroyContentReader (contentReaderRef);
+    }
+
+    // Controlling Analysis
+
+    static ARABool ARA_CALL isAudioSourceContentAnalysisIncomplete (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
+    {
+        return (fromControllerRef (controllerRef)->isAudioSourceContentAnalysisIncomplete (audioSourceRef, type)) ? kARATrue : kARAFalse;
+    }
+
+    static void ARA_CALL requestAudioSourceContentAnalysis (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef,
+                                                            ARASize contentTypesCount, const ARAContentType contentTypes[]) noexcept
+    {
+        fromControllerRef (controllerRef)->requestAudioSourceContentAnalysis (audioSourceRef, contentTypesCount, contentTypes);
+    }
+
+    static ARAInt32 ARA_CALL getProcessingAlgorithmsCount (ARADocumentControllerRef controllerRef) noexcept
+    {
+        return fromControllerRef (controllerRef)->getProcessingAlgorithmsCount ();
+    }
+
+    static const ARAProcessingAlgorithmProperties* ARA_CALL getProcessingAlgorithmProperties (ARADocumentControllerRef controllerRef, ARAInt32 algorithmIndex) noexcept
+    {
+        return fromControllerRef (controllerRef)->getProcessingAlgorithmProperties (algorithmIndex);
+    }
+
+    static ARAInt32 ARA_CALL getProcessingAlgorithmForAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef) noexcept
+    {
+        return fromControllerRef (controllerRef)->getProcessingAlgorithmForAudioSource (audioSourceRef);
+    }
+
+    static void ARA_CALL requestProcessingAlgorithmForAudioSource (ARADocumentControllerRef controllerRef, ARAAudioSourceRef audioSourceRef, ARAInt32 algorithmIndex) noexcept
+    {
+        fromControllerRef (controllerRef)->requestProcessingAlgorithmForAudioSource (audioSourceRef, algorithmIndex);
+    }
+
+    // License Management
+
+    static ARABool ARA_CALL isLicensedForCapabilities (ARADocumentControllerRef controllerRef, ARABool runModalActivationDialogIfNeeded, ARASize contentTypesCount, const ARAContentType contentTypes[], ARAPlaybackTransformationFlags transformationFlags) noexcept
+    {
+        return (fromControllerRef (controllerRef)->isLicensedForCapabilities ((runModalActivationDialogIfNeeded != kARAFalse), contentTypesCount, contentTypes, transformationFlags)) ? kARATrue : kARAFalse;
+    }
+};
+
 /*******************************************************************************/
 // DocumentControllerInstance
 /** Wrapper class for the ARADocumentControllerInstance. */
@@ -253,7 +660,10 @@ ARA_MAP_REF (DocumentControllerInterface, ARADocumentControllerRef)
 class DocumentControllerInstance : public SizedStruct<ARA_STRUCT_MEMBER (ARADocumentControllerInstance, documentControllerInterface)>
 {
 public:
+    //! Construct using the default DocumentControllerDispatcher.
     explicit DocumentControllerInstance (DocumentControllerInterface* documentController) noexcept;
+    //! Construct using a custom function table, e.g. from a statically bound DocumentControllerDispatcher.
+    DocumentControllerInstance (DocumentControllerInterface* documentController, const ARADocumentControllerInterface* controllerInterface) noexcept;
 
     DocumentControllerInterface* getDocumentController () const noexcept
     { return fromRef (documentControllerRef); }
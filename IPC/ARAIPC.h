@@ -30,7 +30,7 @@
 
 //! switch to bypass all IPC code
 #if !defined (ARA_ENABLE_IPC)
-    #if defined (__APPLE__) || defined (_WIN32)
+    #if defined (__APPLE__) || defined (_WIN32) || defined (__linux__)
         #define ARA_ENABLE_IPC 1
     #else
         #define ARA_ENABLE_IPC 0
@@ -167,6 +167,15 @@ typedef void (ARA_CALL *ARAIPCReplyHandler) (const ARAIPCMessageDecoder decoder,
 //! @{
 typedef struct ARAIPCMessageSenderImplementation * ARAIPCMessageSenderRef;
 
+//! statistics of a message sender, for monitoring purposes
+typedef struct ARAIPCMessageSenderStatistics
+{
+    //! total count of sends that gave up waiting because their timeout passed
+    int32_t timedOutSendsCount;
+    //! total count of replies that arrived after their send had timed out, and thus were discarded
+    int32_t droppedRepliesCount;
+} ARAIPCMessageSenderStatistics;
+
 typedef struct ARAIPCMessageSenderInterface
 {
     //! generate an encoder to encode a new message
@@ -183,6 +192,28 @@ typedef struct ARAIPCMessageSenderInterface
 
     //! Test if the receiver runs on a different architecture with different endianess.
     bool (ARA_CALL *receiverEndianessMatches) (ARAIPCMessageSenderRef messageSenderRef);
+
+    //! optional send function with deadline: same as sendMessage(), but gives up waiting for the reply
+    //! once timeoutMilliseconds have passed (a timeout <= 0 waits indefinitely).
+    //! Returns false if no reply has been received, either because of the timeout or because the
+    //! connection has been lost - the replyHandler will not be called then, and a late reply will be
+    //! discarded by the implementation.
+    //! Note that the receiver still handles a message after its sender timed out, so the message
+    //! may or may not have taken effect - see RemoteCaller for the consequences.
+    //! May be NULL if the implementation does not support timeouts.
+    bool (ARA_CALL *sendMessageWithTimeout) (const bool stackable, ARAIPCMessageSenderRef messageSenderRef, ARAIPCMessageID messageID,
+                                             const ARAIPCMessageEncoder * encoder, ARAIPCReplyHandler * const replyHandler, void * replyHandlerUserData,
+                                             int32_t timeoutMilliseconds);
+
+    //! optional test whether the receiver still is reachable, e.g. to detect that the remote process
+    //! has crashed. Once this returns false, it will never return true again - sending messages will
+    //! then no longer invoke the reply handler, and a new connection must be established.
+    //! May be NULL if the implementation cannot detect a lost connection.
+    bool (ARA_CALL *isReceiverConnected) (ARAIPCMessageSenderRef messageSenderRef);
+
+    //! optional query of the current statistics of the sender, e.g. to report timeouts.
+    //! May be NULL if the implementation does not maintain statistics.
+    void (ARA_CALL *getStatistics) (ARAIPCMessageSenderRef messageSenderRef, ARAIPCMessageSenderStatistics * statistics);
 } ARAIPCMessageSenderInterface;
 
 typedef struct ARAIPCMessageSender
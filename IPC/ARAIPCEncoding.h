@@ -31,8 +31,11 @@
 #include "ARA_Library/Utilities/ARAChannelArrangement.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
-#include <map>
+#include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -109,6 +112,141 @@ struct ArrayArgument
 };
 
 
+//------------------------------------------------------------------------------
+// scratch storage for decoding variable-sized arguments
+//------------------------------------------------------------------------------
+
+// Decoding variable arrays (e.g. the content types of an analysis request or the arrays in
+// ARAViewSelection) needs storage that remains valid while the decoded values are being used.
+// Instead of allocating this for each message, each thread owns an arena that hands out storage
+// from memory blocks which are retained across messages, so that in steady state message handling
+// does not need to allocate.
+// Storage is released when leaving the innermost enclosing DecodeScratchScope - handlers open such
+// a scope for the duration of each handled call. Scopes nest, e.g. when handling stacked messages.
+// Storage obtained outside of any scope remains valid until the next allocation outside of any scope.
+class _DecodeScratchArena
+{
+public:
+    struct Mark
+    {
+        size_t blockIndex;
+        size_t offset;
+    };
+
+    static _DecodeScratchArena& get ()
+    {
+        static thread_local _DecodeScratchArena arena;
+        return arena;
+    }
+
+    template<typename ElementT>
+    ElementT* allocateArray (const size_t count)
+    {
+        static_assert (std::is_trivially_destructible<ElementT>::value, "scratch storage is released without calling destructors");
+        auto elements { static_cast<ElementT*> (_allocate (count * sizeof (ElementT), alignof (ElementT))) };
+        for (auto i { 0U }; i < count; ++i)
+            new (elements + i) ElementT {};
+        return elements;
+    }
+
+    Mark enterScope ()
+    {
+        ++_scopeDepth;
+        return _current;
+    }
+    void leaveScope (const Mark& mark)
+    {
+        ARA_INTERNAL_ASSERT (_scopeDepth > 0);
+        --_scopeDepth;
+        _current = mark;
+    }
+
+private:
+    void* _allocate (const size_t size, const size_t alignment)
+    {
+        if (_scopeDepth == 0)
+            _current = { 0, 0 };
+
+        while (true)
+        {
+            if (_current.blockIndex < _blocks.size ())
+            {
+                const auto& block { _blocks[_current.blockIndex] };
+                const auto base { reinterpret_cast<uintptr_t> (block.first.get ()) };
+                const auto aligned { (base + _current.offset + alignment - 1) & ~static_cast<uintptr_t> (alignment - 1) };
+                const auto end { static_cast<size_t> (aligned - base) + size };
+                if (end <= block.second)
+                {
+                    _current.offset = end;
+                    return reinterpret_cast<void*> (aligned);
+                }
+
+                // the remainder of this block is too small, continue with the next (larger) one
+                ++_current.blockIndex;
+                _current.offset = 0;
+            }
+            else
+            {
+                const auto blockSize { std::max (size + alignment, (_blocks.empty ()) ? _kMinBlockSize : 2 * _blocks.back ().second) };
+                _blocks.emplace_back (std::unique_ptr<uint8_t[]> { new uint8_t[blockSize] }, blockSize);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t _kMinBlockSize { 4096 };
+
+    std::vector<std::pair<std::unique_ptr<uint8_t[]>, size_t>> _blocks {};
+    Mark _current { 0, 0 };
+    int _scopeDepth { 0 };
+};
+
+// RAII helper to release all scratch storage obtained on the current thread while in scope
+class DecodeScratchScope
+{
+public:
+    DecodeScratchScope () noexcept
+    : _mark { _DecodeScratchArena::get ().enterScope () }
+    {}
+    ~DecodeScratchScope () noexcept
+    {
+        _DecodeScratchArena::get ().leaveScope (_mark);
+    }
+
+private:
+    const _DecodeScratchArena::Mark _mark;
+
+    ARA_DISABLE_COPY_AND_MOVE (DecodeScratchScope)
+};
+
+// variable array argument decoded into scratch storage - can be used instead of std::vector<>
+// when decoding message arguments that are only used while handling the message
+template<typename ElementT>
+struct ScratchArray
+{
+    static_assert (sizeof(ElementT) > sizeof(ARAByte), "byte-sized arrays should be sent as raw bytes");
+    ScratchArray () noexcept
+    : elements { nullptr }, count { 0 }
+    {}
+    ScratchArray (ElementT* const scratchElements, const size_t scratchCount) noexcept
+    : elements { scratchElements }, count { scratchCount }
+    {}
+
+    ElementT* elements;
+    size_t count;
+
+    ElementT* data () const { return elements; }
+    size_t size () const { return count; }
+    ElementT& operator[] (const size_t index) const { return elements[index]; }
+};
+
+template<typename ElementT>
+inline ScratchArray<ElementT> allocateScratchArray (const size_t count)
+{
+    return { _DecodeScratchArena::get ().allocateArray<ElementT> (count), count };
+}
+
+
 //------------------------------------------------------------------------------
 // various private helpers
 //------------------------------------------------------------------------------
@@ -414,6 +552,145 @@ struct _ValueDecoder<std::vector<ElementT>> : public _CompoundValueDecoderBase<s
 };
 
 
+// specialization for decoding variable arrays into scratch storage
+template<typename ElementT>
+struct _ValueDecoder<ScratchArray<ElementT>> : public _CompoundValueDecoderBase<ScratchArray<ElementT>>
+{
+    static inline bool decode (ScratchArray<ElementT>& result, const ARAIPCMessageDecoder& decoder)
+    {
+        bool success { true };
+        ARAIPCMessageKey count;
+        success &= _readAndDecode (count, decoder, 0);
+        result = allocateScratchArray<ElementT> (static_cast<size_t> (count));
+        for (auto i { 0 }; i < count; ++i)
+            success &= _readAndDecode (result.elements[static_cast<size_t> (i)], decoder, i + 1);
+        return success;
+    }
+};
+
+
+// fast path for structs that contain only plain numbers (no pointers, strings or refs):
+// if the receiver uses the same data representation, these are sent as a single raw bytes blob
+// instead of a keyed sub-message, so that en- and decoding boils down to a memcpy.
+// The blob starts with a small header containing a format tag (which also serves as byte order
+// mark) and the struct size, so that representation mismatches are detected instead of silently
+// misinterpreting the data. Decoding transparently handles both the blob and the keyed variant.
+template<typename StructT>
+struct _IsPODStruct
+{
+    static constexpr bool value { false };
+};
+#define ARA_IPC_SPECIALIZE_FOR_POD_STRUCT(StructT)                                              \
+template<>                                                                                      \
+struct _IsPODStruct<StructT>                                                                    \
+{                                                                                               \
+    static_assert (std::is_trivially_copyable<StructT>::value &&                                \
+                   std::is_standard_layout<StructT>::value, "struct can not be sent as raw bytes"); \
+    static constexpr bool value { true };                                                       \
+};
+ARA_IPC_SPECIALIZE_FOR_POD_STRUCT (ARAColor)
+ARA_IPC_SPECIALIZE_FOR_POD_STRUCT (ARAContentTimeRange)
+ARA_IPC_SPECIALIZE_FOR_POD_STRUCT (ARAContentTempoEntry)
+ARA_IPC_SPECIALIZE_FOR_POD_STRUCT (ARAContentBarSignature)
+ARA_IPC_SPECIALIZE_FOR_POD_STRUCT (ARAContentNote)
+
+// message key for the POD blob - struct members are keyed by their offset, so this never collides
+constexpr ARAIPCMessageKey _kPODBytesKey { 0x7FFFFFFF };
+
+struct _PODBytesHeader
+{
+    uint32_t formatTag;             // _kPODBytesFormatTag in the sender's byte order
+    uint32_t structSize;            // sizeof () of the struct on the sending side
+};
+constexpr uint32_t _kPODBytesFormatTag { 0x41524101 };     // 'ARA' + format version 1
+
+// the fast path must only be used if the receiver has a matching data representation, which the
+// encoding code can not determine on its own - PODEncodingScope enables it for the current thread.
+inline bool& _isPODEncodingEnabled ()
+{
+    static thread_local bool enabled { false };
+    return enabled;
+}
+
+// RAII helper to enable the POD fast path for all messages encoded on the current thread while
+// in scope, typically initialized with RemoteCaller::receiverEndianessMatches () of the receiver.
+class PODEncodingScope
+{
+public:
+    PODEncodingScope (const bool enable) noexcept
+    : _wasEnabled { _isPODEncodingEnabled () }
+    {
+        _isPODEncodingEnabled () = enable;
+    }
+    ~PODEncodingScope () noexcept
+    {
+        _isPODEncodingEnabled () = _wasEnabled;
+    }
+
+private:
+    const bool _wasEnabled;
+
+    ARA_DISABLE_COPY_AND_MOVE (PODEncodingScope)
+};
+
+// primary template: structs that are not eligible always use the keyed encoding
+template<typename StructT, bool isPOD = _IsPODStruct<StructT>::value>
+struct _PODBytesCodec
+{
+    static inline bool tryEncode (ARAIPCMessageEncoder& /*encoder*/, const StructT& /*value*/)
+    {
+        return false;
+    }
+    static inline bool tryDecode (StructT& /*result*/, const ARAIPCMessageDecoder& /*decoder*/, bool& /*success*/)
+    {
+        return false;
+    }
+};
+template<typename StructT>
+struct _PODBytesCodec<StructT, true>
+{
+    static constexpr size_t blobSize { sizeof (_PODBytesHeader) + sizeof (StructT) };
+
+    static inline bool tryEncode (ARAIPCMessageEncoder& encoder, const StructT& value)
+    {
+        if (!_isPODEncodingEnabled ())
+            return false;
+
+        uint8_t blob[blobSize];
+        const _PODBytesHeader header { _kPODBytesFormatTag, static_cast<uint32_t> (sizeof (StructT)) };
+        std::memcpy (blob, &header, sizeof (header));
+        std::memcpy (blob + sizeof (header), &value, sizeof (StructT));
+        encoder.methods->appendBytes (encoder.ref, _kPODBytesKey, blob, blobSize, true);
+        return true;
+    }
+
+    // returns false if no blob is present, so that the caller can fall back to keyed decoding
+    static inline bool tryDecode (StructT& result, const ARAIPCMessageDecoder& decoder, bool& success)
+    {
+        size_t receivedSize;
+        if (!decoder.methods->readBytesSize (decoder.ref, _kPODBytesKey, &receivedSize))
+            return false;
+
+        // the struct size and format tag guard against representation mismatches
+        // such as differing byte order or struct alignment across architectures
+        success = (receivedSize == blobSize);
+        ARA_INTERNAL_ASSERT (success);
+        if (success)
+        {
+            uint8_t blob[blobSize];
+            decoder.methods->readBytes (decoder.ref, _kPODBytesKey, blob);
+            _PODBytesHeader header;
+            std::memcpy (&header, blob, sizeof (header));
+            success = (header.formatTag == _kPODBytesFormatTag) && (header.structSize == sizeof (StructT));
+            ARA_INTERNAL_ASSERT (success);
+            if (success)
+                std::memcpy (&result, blob + sizeof (header), sizeof (StructT));
+        }
+        return true;
+    }
+};
+
+
 // specializations for en/decoding each ARA struct
 
 #define ARA_IPC_BEGIN_ENCODE(StructT)                                                           \
@@ -421,7 +698,9 @@ template<> struct _ValueEncoder<StructT> : public _CompoundValueEncoderBase<Stru
 {                                               /* specialization for given struct */           \
     using StructType = StructT;                                                                 \
     static inline void encode (ARAIPCMessageEncoder& encoder, const StructType& value)          \
-    {
+    {                                                                                           \
+        if (_PODBytesCodec<StructType>::tryEncode (encoder, value))                             \
+            return;
 #define ARA_IPC_ENCODE_MEMBER(member)                                                           \
         _encodeAndAppend (encoder, offsetof (StructType, member), value.member);
 #define ARA_IPC_ENCODE_EMBEDDED_BYTES(member)                                                   \
@@ -465,7 +744,9 @@ template<> struct _ValueDecoder<StructT> : public _CompoundValueDecoderBase<Stru
     using StructType = StructT;                                                                 \
     static inline bool decode (StructType& result, const ARAIPCMessageDecoder& decoder)         \
     {                                                                                           \
-        bool success { true };
+        bool success { true };                                                                  \
+        if (_PODBytesCodec<StructType>::tryDecode (result, decoder, success))                   \
+            return success;
 #define ARA_IPC_BEGIN_DECODE_SIZED(StructT)                                                     \
         ARA_IPC_BEGIN_DECODE (StructT)                                                          \
         result.structSize = k##StructT##MinSize;
@@ -483,9 +764,9 @@ template<> struct _ValueDecoder<StructT> : public _CompoundValueDecoderBase<Stru
         success &= _readAndDecode (tmp_##member, decoder, offsetof (StructType, member));       \
         ARA_INTERNAL_ASSERT (success);
 #define ARA_IPC_DECODE_VARIABLE_ARRAY(member, count, updateCount)                               \
-        /* \todo the outer struct contains a pointer to the inner array, so we need some  */    \
-        /* place to store it - this static only works as long as this is single-threaded! */    \
-        static std::vector<typename std::remove_const<std::remove_pointer<decltype (result.member)>::type>::type> tmp_##member; \
+        /* the outer struct contains a pointer to the inner array, which is stored in the */    \
+        /* scratch arena of the decoding thread (see DecodeScratchScope)                  */    \
+        ScratchArray<typename std::remove_const<std::remove_pointer<decltype (result.member)>::type>::type> tmp_##member; \
         if (_readAndDecode (tmp_##member, decoder, offsetof (StructType, member))) {            \
             result.member = tmp_##member.data ();                                               \
             if (updateCount) { result.count = tmp_##member.size (); }                           \
@@ -871,6 +1152,7 @@ struct GetPlaybackRegionHeadAndTailTimeReply
     ARATimeDuration headTime;
     ARATimeDuration tailTime;
 };
+ARA_IPC_SPECIALIZE_FOR_POD_STRUCT (GetPlaybackRegionHeadAndTailTimeReply)
 ARA_IPC_BEGIN_ENCODE (GetPlaybackRegionHeadAndTailTimeReply)
     ARA_IPC_ENCODE_MEMBER (headTime)
     ARA_IPC_ENCODE_MEMBER (tailTime)
@@ -881,6 +1163,8 @@ ARA_IPC_BEGIN_DECODE (GetPlaybackRegionHeadAndTailTimeReply)
 ARA_IPC_END_DECODE
 
 
+#undef ARA_IPC_SPECIALIZE_FOR_POD_STRUCT
+
 #undef ARA_IPC_BEGIN_ENCODE
 #undef ARA_IPC_ENCODE_MEMBER
 #undef ARA_IPC_ENCODE_EMBEDDED_BYES
@@ -1028,7 +1312,14 @@ constexpr ARAIPCMessageID _encodeMessageID ()
 #define ARA_IPC_PLUGIN_METHOD_ID(StructT, member) IPC::_encodeMessageID <IPC::_getPlugInInterfaceID<StructT> (), offsetof (StructT, member)> ()
 
 
+// all encoded message IDs are smaller than this, so that they can be used to index dense tables
+// (method offsets of the interface structs are well below 8*16*16 bytes, even when shifted on 32 bit)
+constexpr ARAIPCMessageID kMessageIDsCount { 8 * 16 * 16 };
+
+
 // "global" messages that are not passed based on interface structs
+// Method IDs are always >= 8 and use interface IDs 0..4 in their lower 3 bits, so IDs below 8 are
+// available for global messages, as are all IDs with interface ID 7 (i.e. (n << 3) + 7).
 enum : ARA::IPC::ARAIPCMessageID
 {
     kGetFactoriesCountMessageID = 1,
@@ -1036,7 +1327,12 @@ enum : ARA::IPC::ARAIPCMessageID
     kInitializeARAMessageID = 3,
     kCreateDocumentControllerMessageID = 4,
     kBindToDocumentControllerMessageID = 5,
-    kUninitializeARAMessageID = 6
+    kUninitializeARAMessageID = 6,
+    // batched equivalent of getContentReaderDataForEvent (), used in both directions:
+    // arguments are the (host) controller ref, (host) content reader ref, first event index and event count
+    kGetContentReaderDataForEventsMessageID = 7,
+    // argument is the controller ref, reply is the name to pass to ModelMirrorReader::open (), or an empty string
+    kGetModelMirrorMessageID = (1 << 3) + 7
 };
 
 
@@ -1087,146 +1383,440 @@ inline void encodeReply (ARAIPCMessageEncoder* encoder, const ValueT& value)
 }
 
 
-// for debugging only: decoding method IDs
-inline const char* _decodeMessageID (std::map<ARAIPCMessageID, std::string>& cache, const char* interfaceName, const ARAIPCMessageID messageID)
+// for debugging only: decoding message IDs
+// The names are stored in dense tables indexed by message ID, which are filled once from the
+// compile-time lists below, so that decoding neither searches nor allocates. Methods that are not
+// listed because the proxies do not call them are reported by their interface name only.
+struct _MessageName
 {
-    auto it { cache.find (messageID) };
-    if (it == cache.end ())
-        it = cache.emplace (messageID, std::string { interfaceName } + " method " + std::to_string (messageID >> 3)).first;
-    return it->second.c_str();
-}
-inline const char* decodeHostMessageID (const ARAIPCMessageID messageID)
+    ARAIPCMessageID messageID;
+    const char* name;
+};
+#define ARA_IPC_HOST_MESSAGE_NAME(StructT, member) { ARA_IPC_HOST_METHOD_ID (StructT, member), #StructT "::" #member }
+#define ARA_IPC_PLUGIN_MESSAGE_NAME(StructT, member) { ARA_IPC_PLUGIN_METHOD_ID (StructT, member), #StructT "::" #member }
+#define ARA_IPC_GLOBAL_MESSAGE_NAME(messageID) { messageID, #messageID }
+
+constexpr _MessageName _globalMessageNames[]
 {
-    static std::map<ARAIPCMessageID, std::string> cache;
-    const char* interfaceName;
-    switch (messageID & 0x7)
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kGetFactoriesCountMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kGetFactoryMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kInitializeARAMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kCreateDocumentControllerMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kBindToDocumentControllerMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kUninitializeARAMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kGetContentReaderDataForEventsMessageID),
+    ARA_IPC_GLOBAL_MESSAGE_NAME (kGetModelMirrorMessageID)
+};
+
+constexpr _MessageName _hostMessageNames[]
+{
+    ARA_IPC_HOST_MESSAGE_NAME (ARAAudioAccessControllerInterface, createAudioReaderForSource),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAAudioAccessControllerInterface, readAudioSamples),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAAudioAccessControllerInterface, destroyAudioReader),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAArchivingControllerInterface, getArchiveSize),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAArchivingControllerInterface, readBytesFromArchive),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAArchivingControllerInterface, writeBytesToArchive),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAArchivingControllerInterface, notifyDocumentArchivingProgress),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAArchivingControllerInterface, notifyDocumentUnarchivingProgress),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAArchivingControllerInterface, getDocumentArchiveID),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, isMusicalContextContentAvailable),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, getMusicalContextContentGrade),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, createMusicalContextContentReader),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, isAudioSourceContentAvailable),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, getAudioSourceContentGrade),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, createAudioSourceContentReader),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, getContentReaderEventCount),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, getContentReaderDataForEvent),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAContentAccessControllerInterface, destroyContentReader),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAModelUpdateControllerInterface, notifyAudioSourceAnalysisProgress),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAModelUpdateControllerInterface, notifyAudioSourceContentChanged),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAModelUpdateControllerInterface, notifyAudioModificationContentChanged),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAModelUpdateControllerInterface, notifyPlaybackRegionContentChanged),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAPlaybackControllerInterface, requestStartPlayback),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAPlaybackControllerInterface, requestStopPlayback),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAPlaybackControllerInterface, requestSetPlaybackPosition),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAPlaybackControllerInterface, requestSetCycleRange),
+    ARA_IPC_HOST_MESSAGE_NAME (ARAPlaybackControllerInterface, requestEnableCycle)
+};
+
+constexpr _MessageName _plugInMessageNames[]
+{
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyDocumentController),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getFactory),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, beginEditing),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, endEditing),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, notifyModelUpdates),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, restoreObjectsFromArchive),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, storeObjectsToArchive),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, storeAudioSourceToAudioFileChunk),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateDocumentProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createMusicalContext),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateMusicalContextProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateMusicalContextContent),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyMusicalContext),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createRegionSequence),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateRegionSequenceProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyRegionSequence),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createAudioSource),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateAudioSourceProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateAudioSourceContent),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, enableAudioSourceSamplesAccess),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, deactivateAudioSourceForUndoHistory),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyAudioSource),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createAudioModification),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, cloneAudioModification),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updateAudioModificationProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, isAudioModificationPreservingAudioSourceSignal),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, deactivateAudioModificationForUndoHistory),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyAudioModification),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createPlaybackRegion),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, updatePlaybackRegionProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getPlaybackRegionHeadAndTailTime),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyPlaybackRegion),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, isAudioSourceContentAvailable),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, isAudioSourceContentAnalysisIncomplete),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, requestAudioSourceContentAnalysis),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getAudioSourceContentGrade),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createAudioSourceContentReader),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, isAudioModificationContentAvailable),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getAudioModificationContentGrade),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createAudioModificationContentReader),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, isPlaybackRegionContentAvailable),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getPlaybackRegionContentGrade),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, createPlaybackRegionContentReader),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getContentReaderEventCount),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getContentReaderDataForEvent),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, destroyContentReader),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getProcessingAlgorithmsCount),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getProcessingAlgorithmProperties),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, getProcessingAlgorithmForAudioSource),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, requestProcessingAlgorithmForAudioSource),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARADocumentControllerInterface, isLicensedForCapabilities),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAPlaybackRendererInterface, addPlaybackRegion),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAPlaybackRendererInterface, removePlaybackRegion),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAEditorRendererInterface, addPlaybackRegion),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAEditorRendererInterface, removePlaybackRegion),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAEditorRendererInterface, addRegionSequence),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAEditorRendererInterface, removeRegionSequence),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAEditorViewInterface, notifySelection),
+    ARA_IPC_PLUGIN_MESSAGE_NAME (ARAEditorViewInterface, notifyHideRegionSequences)
+};
+
+#undef ARA_IPC_HOST_MESSAGE_NAME
+#undef ARA_IPC_PLUGIN_MESSAGE_NAME
+#undef ARA_IPC_GLOBAL_MESSAGE_NAME
+
+class _MessageNamesTable
+{
+public:
+    template<size_t methodsCount>
+    _MessageNamesTable (const _MessageName (&methodNames)[methodsCount], const char* const (&interfaceNames)[8]) noexcept
+    {
+        for (ARAIPCMessageID messageID { 0 }; messageID < kMessageIDsCount; ++messageID)
+            _names[messageID] = (_isGlobalMessageID (messageID)) ? "(unknown global message)" : interfaceNames[messageID & 0x7];
+        for (const auto& entry : _globalMessageNames)
+        {
+            ARA_INTERNAL_ASSERT (_isGlobalMessageID (entry.messageID));
+            _setName (entry);
+        }
+        for (const auto& entry : methodNames)
+        {
+            ARA_INTERNAL_ASSERT (!_isGlobalMessageID (entry.messageID));
+            _setName (entry);
+        }
+    }
+
+    const char* getName (const ARAIPCMessageID messageID) const noexcept
+    {
+        ARA_INTERNAL_ASSERT (messageID < kMessageIDsCount);
+        return (messageID < kMessageIDsCount) ? _names[messageID] : "(invalid message ID)";
+    }
+
+private:
+    static bool _isGlobalMessageID (const ARAIPCMessageID messageID) noexcept
+    {
+        return (messageID < 8) || ((messageID & 0x7) == 7);
+    }
+
+    void _setName (const _MessageName& entry) noexcept
     {
-        case 0: interfaceName = "ARAAudioAccessControllerInterface"; break;
-        case 1: interfaceName = "ARAArchivingControllerInterface"; break;
-        case 2: interfaceName = "ARAContentAccessControllerInterface"; break;
-        case 3: interfaceName = "ARAModelUpdateControllerInterface"; break;
-        case 4: interfaceName = "ARAPlaybackControllerInterface"; break;
-        default: ARA_INTERNAL_ASSERT (false); interfaceName = "(unknown)"; break;
+        ARA_INTERNAL_ASSERT (entry.messageID < kMessageIDsCount);
+        _names[entry.messageID] = entry.name;
     }
-    return _decodeMessageID (cache, interfaceName, messageID);
+
+private:
+    const char* _names[kMessageIDsCount];
+};
+
+inline const char* decodeHostMessageID (const ARAIPCMessageID messageID)
+{
+    static const _MessageNamesTable table { _hostMessageNames,
+        { "ARAAudioAccessControllerInterface (unlisted method)", "ARAArchivingControllerInterface (unlisted method)",
+          "ARAContentAccessControllerInterface (unlisted method)", "ARAModelUpdateControllerInterface (unlisted method)",
+          "ARAPlaybackControllerInterface (unlisted method)", "(unknown interface)", "(unknown interface)", "(unknown interface)" } };
+    return table.getName (messageID);
 }
 inline const char* decodePlugInMessageID (const ARAIPCMessageID messageID)
 {
-    static std::map<ARAIPCMessageID, std::string> cache;
-    const char* interfaceName;
-    switch (messageID & 0x7)
-    {
-        case 0: interfaceName = "ARADocumentControllerInterface"; break;
-        case 1: interfaceName = "ARAPlaybackRendererInterface"; break;
-        case 2: interfaceName = "ARAEditorRendererInterface"; break;
-        case 3: interfaceName = "ARAEditorViewInterface"; break;
-        default: ARA_INTERNAL_ASSERT (false); interfaceName = "(unknown)"; break;
-    }
-    return _decodeMessageID (cache, interfaceName, messageID);
+    static const _MessageNamesTable table { _plugInMessageNames,
+        { "ARADocumentControllerInterface (unlisted method)", "ARAPlaybackRendererInterface (unlisted method)",
+          "ARAEditorRendererInterface (unlisted method)", "ARAEditorViewInterface (unlisted method)",
+          "(unknown interface)", "(unknown interface)", "(unknown interface)", "(unknown interface)" } };
+    return table.getName (messageID);
 }
 
 //------------------------------------------------------------------------------
 // support for content readers
+// En- and decoding of content events is generated from ContentTypeMapper: for each content type
+// listed in _AllContentTypes, the codec functions are instantiated for the associated event struct.
+// They are selected once when creating the content reader, so that en-/decoding an event does not
+// need to dispatch on the content type. Adding a content type thus only requires adding it to
+// _AllContentTypes, plus specializing _ContentEventStringMember if its struct contains a string.
+// Events can be transferred one at a time (as reply to getContentReaderDataForEvent ()) or in
+// batches of consecutive events (as reply to kGetContentReaderDataForEventsMessageID).
 //------------------------------------------------------------------------------
 
-inline void encodeContentEvent (ARAIPCMessageEncoder* encoder, const ARAContentType type, const void* eventData)
+// all content types that can be transferred
+template<ARAContentType... contentTypes>
+struct _ContentTypeList {};
+using _AllContentTypes = _ContentTypeList<kARAContentTypeNotes, kARAContentTypeTempoEntries, kARAContentTypeBarSignatures,
+                                          kARAContentTypeStaticTuning, kARAContentTypeKeySignatures, kARAContentTypeSheetChords>;
+
+// access to the string member of content event structs, which needs to be copied when decoding
+// because the decoded string is only valid as long as the message
+template<typename DataT>
+struct _ContentEventStringMember
+{
+    static constexpr bool exists { false };
+    static inline ARAUtf8String* get (DataT& /*event*/) { return nullptr; }
+};
+#define ARA_IPC_SPECIALIZE_CONTENT_EVENT_STRING_MEMBER(DataT, member)                         \
+template<>                                                                                      \
+struct _ContentEventStringMember<DataT>                                                         \
+{                                                                                               \
+    static constexpr bool exists { true };                                                      \
+    static inline ARAUtf8String* get (DataT& event) { return &event.member; }                   \
+};
+ARA_IPC_SPECIALIZE_CONTENT_EVENT_STRING_MEMBER (ARAContentTuning, name)
+ARA_IPC_SPECIALIZE_CONTENT_EVENT_STRING_MEMBER (ARAContentKeySignature, name)
+ARA_IPC_SPECIALIZE_CONTENT_EVENT_STRING_MEMBER (ARAContentChord, name)
+#undef ARA_IPC_SPECIALIZE_CONTENT_EVENT_STRING_MEMBER
+
+// storage for decoded events of any content type
+union _ContentEventData
+{
+    ARAContentTempoEntry _tempoEntry;
+    ARAContentBarSignature _barSignature;
+    ARAContentNote _note;
+    ARAContentTuning _tuning;
+    ARAContentKeySignature _keySignature;
+    ARAContentChord _chord;
+};
+struct _ContentEventsStorage
+{
+    std::vector<_ContentEventData> events;
+    std::vector<std::string> strings;
+};
+
+// accessor for the events of a content reader, used when encoding batches
+using ContentEventDataGetter = std::function<const void* (const ARAInt32 eventIndex)>;
+
+// codec functions for a given content type
+struct _ContentEventCodecFunctions
 {
-    switch (type)
+    void (*encodeEvent) (ARAIPCMessageEncoder* encoder, const void* eventData);
+    void (*encodeEvents) (ARAIPCMessageEncoder* encoder, const ARAInt32 firstEventIndex, const ARAInt32 eventCount, const ContentEventDataGetter& getEventData);
+    bool (*decodeEvents) (_ContentEventsStorage& storage, const ARAIPCMessageDecoder& decoder, const bool isBatch);
+};
+
+template<ARAContentType contentType>
+struct _ContentEventCodec
+{
+    using DataType = typename ContentTypeMapper<contentType>::DataType;
+    static_assert (sizeof (DataType) <= sizeof (_ContentEventData), "_ContentEventData must be able to store all content event structs");
+
+    static void encodeEvent (ARAIPCMessageEncoder* encoder, const void* eventData)
+    {
+        encodeReply (encoder, *static_cast<const DataType*> (eventData));
+    }
+
+    // same layout as a reply of type std::vector<DataType>, but without copying the events
+    static void encodeEvents (ARAIPCMessageEncoder* encoder, const ARAInt32 firstEventIndex, const ARAInt32 eventCount, const ContentEventDataGetter& getEventData)
+    {
+        ARA_INTERNAL_ASSERT (encoder != nullptr);
+        _encodeAndAppend (*encoder, 0, static_cast<ARAIPCMessageKey> (eventCount));
+        for (auto i { 0 }; i < eventCount; ++i)
+            _encodeAndAppend (*encoder, i + 1, *static_cast<const DataType*> (getEventData (firstEventIndex + i)));
+    }
+
+    static bool decodeEvents (_ContentEventsStorage& storage, const ARAIPCMessageDecoder& decoder, const bool isBatch)
+    {
+        bool success { true };
+        ARAIPCMessageKey count { 1 };
+        if (isBatch)
+            success &= _readAndDecode (count, decoder, 0);
+        storage.events.resize (static_cast<size_t> (count));
+        for (auto i { 0 }; i < count; ++i)
+        {
+            auto& event { *reinterpret_cast<DataType*> (&storage.events[static_cast<size_t> (i)]) };
+            if (isBatch)
+                success &= _readAndDecode (event, decoder, i + 1);
+            else
+                success &= decodeReply (event, decoder);
+        }
+        _storeStrings (storage, static_cast<size_t> (count), std::integral_constant<bool, _ContentEventStringMember<DataType>::exists> {});
+        return success;
+    }
+
+    static const _ContentEventCodecFunctions* getFunctions ()
     {
-        case kARAContentTypeNotes:          encodeReply (encoder, *static_cast<const ARAContentNote*> (eventData)); break;
-        case kARAContentTypeTempoEntries:   encodeReply (encoder, *static_cast<const ARAContentTempoEntry*> (eventData)); break;
-        case kARAContentTypeBarSignatures:  encodeReply (encoder, *static_cast<const ARAContentBarSignature*> (eventData)); break;
-        case kARAContentTypeStaticTuning:   encodeReply (encoder, *static_cast<const ARAContentTuning*> (eventData)); break;
-        case kARAContentTypeKeySignatures:  encodeReply (encoder, *static_cast<const ARAContentKeySignature*> (eventData)); break;
-        case kARAContentTypeSheetChords:    encodeReply (encoder, *static_cast<const ARAContentChord*> (eventData)); break;
-        default:                            ARA_INTERNAL_ASSERT (false && "content type not implemented yet"); break;
+        static const _ContentEventCodecFunctions functions { &encodeEvent, &encodeEvents, &decodeEvents };
+        return &functions;
     }
+
+private:
+    static void _storeStrings (_ContentEventsStorage& /*storage*/, const size_t /*count*/, std::false_type /*hasString*/) {}
+    static void _storeStrings (_ContentEventsStorage& storage, const size_t count, std::true_type /*hasString*/)
+    {
+        // first copy all strings, then update the events, since resizing may move the string storage
+        if (storage.strings.size () < count)
+            storage.strings.resize (count);
+        for (auto i { 0U }; i < count; ++i)
+        {
+            const auto string { _ContentEventStringMember<DataType>::get (*reinterpret_cast<DataType*> (&storage.events[i])) };
+            if (*string != nullptr)
+                storage.strings[i].assign (*string);
+        }
+        for (auto i { 0U }; i < count; ++i)
+        {
+            const auto string { _ContentEventStringMember<DataType>::get (*reinterpret_cast<DataType*> (&storage.events[i])) };
+            if (*string != nullptr)
+                *string = storage.strings[i].c_str ();
+        }
+    }
+};
+
+// fallback codec for unknown content types: encodes empty events and fails decoding
+struct _ContentEventNullCodec
+{
+    static void encodeEvent (ARAIPCMessageEncoder* /*encoder*/, const void* /*eventData*/) {}
+
+    static void encodeEvents (ARAIPCMessageEncoder* encoder, const ARAInt32 /*firstEventIndex*/, const ARAInt32 /*eventCount*/, const ContentEventDataGetter& /*getEventData*/)
+    {
+        ARA_INTERNAL_ASSERT (encoder != nullptr);
+        _encodeAndAppend (*encoder, 0, ARAIPCMessageKey { 0 });
+    }
+
+    static bool decodeEvents (_ContentEventsStorage& storage, const ARAIPCMessageDecoder& /*decoder*/, const bool /*isBatch*/)
+    {
+        storage.events.clear ();
+        return false;
+    }
+
+    static const _ContentEventCodecFunctions* getFunctions ()
+    {
+        static const _ContentEventCodecFunctions functions { &encodeEvent, &encodeEvents, &decodeEvents };
+        return &functions;
+    }
+};
+
+// select the codec functions for the given content type from the list of all content types
+template<typename ContentTypeListT>
+struct _ContentEventCodecSelector;
+template<>
+struct _ContentEventCodecSelector<_ContentTypeList<>>
+{
+    static inline const _ContentEventCodecFunctions* select (const ARAContentType /*type*/)
+    {
+        ARA_INTERNAL_ASSERT (false && "content type not implemented yet");
+        return _ContentEventNullCodec::getFunctions ();
+    }
+};
+template<ARAContentType contentType, ARAContentType... moreContentTypes>
+struct _ContentEventCodecSelector<_ContentTypeList<contentType, moreContentTypes...>>
+{
+    static inline const _ContentEventCodecFunctions* select (const ARAContentType type)
+    {
+        return (type == contentType) ? _ContentEventCodec<contentType>::getFunctions ()
+                                     : _ContentEventCodecSelector<_ContentTypeList<moreContentTypes...>>::select (type);
+    }
+};
+inline const _ContentEventCodecFunctions* _getContentEventCodec (const ARAContentType type)
+{
+    return _ContentEventCodecSelector<_AllContentTypes>::select (type);
 }
 
-class ContentEventDecoder
+// upper limit for the event count requested via kGetContentReaderDataForEventsMessageID
+constexpr ARAInt32 kContentReaderEventsBatchSize { 64 };
+
+inline void encodeContentEvent (ARAIPCMessageEncoder* encoder, const ARAContentType type, const void* eventData)
+{
+    _getContentEventCodec (type)->encodeEvent (encoder, eventData);
+}
+
+class ContentEventEncoder
 {
 public:
-    ContentEventDecoder (ARAContentType type)
-    : _decoderFunction { _getDecoderFunctionForContentType (type) },
-      _contentString { _findStringMember (type) }
+    ContentEventEncoder (ARAContentType type)
+    : _codec { _getContentEventCodec (type) }
     {}
 
-    const void* decode (const ARAIPCMessageDecoder& decoder)
+    void encode (ARAIPCMessageEncoder* encoder, const void* eventData) const
+    {
+        _codec->encodeEvent (encoder, eventData);
+    }
+
+    void encodeEvents (ARAIPCMessageEncoder* encoder, const ARAInt32 firstEventIndex, const ARAInt32 eventCount, const ContentEventDataGetter& getEventData) const
     {
-        (this->*_decoderFunction) (decoder);
-        return &_eventStorage;
+        _codec->encodeEvents (encoder, firstEventIndex, eventCount, getEventData);
     }
 
 private:
-    using _DecoderFunction = void (ContentEventDecoder::*) (const ARAIPCMessageDecoder&);
+    const _ContentEventCodecFunctions* const _codec;
+};
+
+class ContentEventDecoder
+{
+public:
+    ContentEventDecoder (ARAContentType type)
+    : _codec { _getContentEventCodec (type) }
+    {}
 
-    template<typename ContentT>
-    void _decodeContentEvent (const ARAIPCMessageDecoder& decoder)
+    // decode the reply to getContentReaderDataForEvent (), returns nullptr if decoding fails
+    const void* decode (const ARAIPCMessageDecoder& decoder)
     {
-        decodeReply (*reinterpret_cast<ContentT*> (&this->_eventStorage), decoder);
-        if (this->_contentString != nullptr)
-        {
-            this->_stringStorage.assign (*this->_contentString);
-            *this->_contentString = this->_stringStorage.c_str ();
-        }
+        _firstDecodedEventIndex = -1;
+        if (!_codec->decodeEvents (_storage, decoder, false) || _storage.events.empty ())
+            return nullptr;
+        return &_storage.events.front ();
     }
 
-    static inline
-#if __cplusplus >= 201402L
-                  constexpr
-#endif
-                            _DecoderFunction _getDecoderFunctionForContentType (const ARAContentType type)
+    // decode the reply to kGetContentReaderDataForEventsMessageID for the given first event index
+    // The decoded events remain accessible via findDecodedEvent () until the next decode call.
+    void decodeEvents (const ARAIPCMessageDecoder& decoder, const ARAInt32 firstEventIndex)
     {
-        switch (type)
+        if (_codec->decodeEvents (_storage, decoder, true))
         {
-            case kARAContentTypeNotes: return &ContentEventDecoder::_decodeContentEvent<ContentTypeMapper<kARAContentTypeNotes>::DataType>;
-            case kARAContentTypeTempoEntries: return &ContentEventDecoder::_decodeContentEvent<ContentTypeMapper<kARAContentTypeTempoEntries>::DataType>;
-            case kARAContentTypeBarSignatures: return &ContentEventDecoder::_decodeContentEvent<ContentTypeMapper<kARAContentTypeBarSignatures>::DataType>;
-            case kARAContentTypeStaticTuning: return &ContentEventDecoder::_decodeContentEvent<ContentTypeMapper<kARAContentTypeStaticTuning>::DataType>;
-            case kARAContentTypeKeySignatures: return &ContentEventDecoder::_decodeContentEvent<ContentTypeMapper<kARAContentTypeKeySignatures>::DataType>;
-            case kARAContentTypeSheetChords: return &ContentEventDecoder::_decodeContentEvent<ContentTypeMapper<kARAContentTypeSheetChords>::DataType>;
-            default: ARA_INTERNAL_ASSERT (false); return nullptr;
+            _firstDecodedEventIndex = firstEventIndex;
         }
-    }
-
-    static inline
-#if __cplusplus >= 201402L
-                  constexpr
-#endif
-                            size_t _getStringMemberOffsetForContentType (const ARAContentType type)
-    {
-        switch (type)
+        else
         {
-            case kARAContentTypeStaticTuning: return offsetof (ARAContentTuning, name);
-            case kARAContentTypeKeySignatures: return offsetof (ARAContentKeySignature, name);
-            case kARAContentTypeSheetChords: return offsetof (ARAContentChord, name);
-            default: return 0;
+            _storage.events.clear ();
+            _firstDecodedEventIndex = -1;
         }
     }
-
-    inline ARAUtf8String* _findStringMember (const ARAContentType type)
+    const void* findDecodedEvent (const ARAInt32 eventIndex) const
     {
-        const auto offset { ContentEventDecoder::_getStringMemberOffsetForContentType (type) };
-        if (offset == 0)
+        if ((_firstDecodedEventIndex < 0) || (eventIndex < _firstDecodedEventIndex) ||
+            (static_cast<size_t> (eventIndex - _firstDecodedEventIndex) >= _storage.events.size ()))
             return nullptr;
-        return reinterpret_cast<ARAUtf8String*> (reinterpret_cast<uint8_t *> (&this->_eventStorage) + offset);
+        return &_storage.events[static_cast<size_t> (eventIndex - _firstDecodedEventIndex)];
     }
 
 private:
-    _DecoderFunction const _decoderFunction;    // instead of performing the switch (type) for each event,
-                                                // we select a templated member function in the c'tor
-    union
-    {
-        ARAContentTempoEntry _tempoEntry;
-        ARAContentBarSignature _barSignature;
-        ARAContentNote _note;
-        ARAContentTuning _tuning;
-        ARAContentKeySignature _keySignature;
-        ARAContentChord _chord;
-    } _eventStorage {};
-
-    ARAUtf8String* _contentString {};
-    std::string _stringStorage {};
+    const _ContentEventCodecFunctions* const _codec;
+    _ContentEventsStorage _storage {};
+    ARAInt32 _firstDecodedEventIndex { -1 };      // -1 if no batch has been decoded
 
     ARA_DISABLE_COPY_AND_MOVE (ContentEventDecoder)
 };
@@ -1245,44 +1835,204 @@ public:
 
     RemoteCaller (ARAIPCMessageSender sender) noexcept : _sender { sender } {}
 
+    //! Deadlines for remote calls
+    //! If the reply to a call does not arrive within its timeout, the call returns false:
+    //! calls with a result reset it to its default value (i.e. kARAFalse, 0 or nullptr),
+    //! calls with a custom decode function do not invoke it. Any late reply is safely discarded.
+    //! The timeout of a call is determined by the innermost TimeoutScope on the calling thread,
+    //! or else by the default timeout configured for its message ID - if neither is set, or if the
+    //! sender does not implement ARAIPCMessageSenderInterface::sendMessageWithTimeout(), the call
+    //! blocks until the reply has been received.
+    //! Likewise, all calls return false (and reset their result) if the connection has been lost,
+    //! see isRemoteConnected ().
+    //! Calls without reply are only subject to the timeout if they are not handled synchronously,
+    //! e.g. when the sender applies flow control.
+    //! A timeout does not cancel the call on the remote side: it may still take effect later, and
+    //! objects created by it are orphaned in the remote process. Therefore, after a timeout of any
+    //! call that creates or modifies remote state, the state of the remote document is undefined -
+    //! the caller should then treat the remote side as failed and tear down the connection (or
+    //! replace the remote process if supported, see ARAIPCProxyPlugInRecoverDocumentController()).
+    //! Timeouts are counted in the statistics of the sender, see getSenderStatistics ().
+    //@{
+    static constexpr int32_t kNoTimeout { 0 };
+
+    //! static configuration: default timeout per message ID, e.g. for calls that are made from
+    //! threads with soft real-time requirements such as the UI - must not be changed while calls are pending
+    static void setDefaultTimeout (const ARAIPCMessageID messageID, const int32_t timeoutMilliseconds)
+    {
+        ARA_INTERNAL_ASSERT (timeoutMilliseconds >= kNoTimeout);
+        ARA_INTERNAL_ASSERT (messageID < kMessageIDsCount);
+        if (messageID < kMessageIDsCount)
+            _getDefaultTimeouts ()[messageID] = timeoutMilliseconds;
+    }
+
+    //! RAII helper to override the timeout for all calls made on the current thread while in scope,
+    //! kNoTimeout disables any default timeout.
+    class TimeoutScope
+    {
+    public:
+        TimeoutScope (const int32_t timeoutMilliseconds) noexcept
+        : _previousTimeout { _getCurrentScopeTimeout () }
+        {
+            ARA_INTERNAL_ASSERT (timeoutMilliseconds >= kNoTimeout);
+            _getCurrentScopeTimeout () = timeoutMilliseconds;
+        }
+        ~TimeoutScope () noexcept
+        {
+            _getCurrentScopeTimeout () = _previousTimeout;
+        }
+
+    private:
+        const int32_t _previousTimeout;
+
+        ARA_DISABLE_COPY_AND_MOVE (TimeoutScope)
+    };
+    //@}
+
     template<typename... Args>
-    void remoteCallWithoutReply (const bool stackable, const ARAIPCMessageID messageID, const Args &... args)
+    bool remoteCallWithoutReply (const bool stackable, const ARAIPCMessageID messageID, const Args &... args)
     {
         auto encoder { _sender.methods->createEncoder (_sender.ref) };
-        encodeArguments (encoder, args...);
-        _sender.methods->sendMessage (stackable, _sender.ref, messageID, &encoder, nullptr, nullptr);
+        _encodeArguments (encoder, args...);
+        const auto didSend { _sendMessage (stackable, messageID, &encoder, nullptr, nullptr) };
         encoder.methods->destroyEncoder (encoder.ref);
+        return didSend;
     }
 
     template<typename RetT, typename... Args>
-    void remoteCallWithReply (RetT& result, const bool stackable, const ARAIPCMessageID messageID, const Args &... args)
+    bool remoteCallWithReply (RetT& result, const bool stackable, const ARAIPCMessageID messageID, const Args &... args)
     {
         auto encoder { _sender.methods->createEncoder (_sender.ref) };
-        encodeArguments (encoder, args...);
+        _encodeArguments (encoder, args...);
         ARAIPCReplyHandler replyHandler { [] (const ARAIPCMessageDecoder decoder, void* userData) -> void
             {
                 ARA_INTERNAL_ASSERT (!decoder.methods->isEmpty (decoder.ref));
                 decodeReply (*reinterpret_cast<RetT*> (userData), decoder);
             } };
-        _sender.methods->sendMessage (stackable, _sender.ref, messageID, &encoder, &replyHandler, &result);
+        const auto didReceiveReply { _sendMessage (stackable, messageID, &encoder, &replyHandler, &result) };
         encoder.methods->destroyEncoder (encoder.ref);
+        if (!didReceiveReply)
+            _resetResult (result, std::is_default_constructible<RetT> {});
+        return didReceiveReply;
     }
     template<typename... Args>
-    void remoteCallWithReply (CustomDecodeFunction& decodeFunction, const bool stackable, const ARAIPCMessageID messageID, const Args &... args)
+    bool remoteCallWithReply (CustomDecodeFunction& decodeFunction, const bool stackable, const ARAIPCMessageID messageID, const Args &... args)
     {
         auto encoder { _sender.methods->createEncoder (_sender.ref) };
-        encodeArguments (encoder, args...);
+        _encodeArguments (encoder, args...);
         ARAIPCReplyHandler replyHandler { [] (const ARAIPCMessageDecoder decoder, void* userData) -> void
             {
                 ARA_INTERNAL_ASSERT (!decoder.methods->isEmpty (decoder.ref));
+                const DecodeScratchScope decodeScratchScope {};
                 (*reinterpret_cast<CustomDecodeFunction*> (userData)) (decoder);
             } };
-        _sender.methods->sendMessage (stackable, _sender.ref, messageID, &encoder, &replyHandler, &decodeFunction);
+        const auto didReceiveReply { _sendMessage (stackable, messageID, &encoder, &replyHandler, &decodeFunction) };
         encoder.methods->destroyEncoder (encoder.ref);
+        return didReceiveReply;
     }
 
     bool receiverEndianessMatches () { return _sender.methods->receiverEndianessMatches (_sender.ref); }
 
+    //! get the statistics of the sender - returns false if the sender does not provide any
+    bool getSenderStatistics (ARAIPCMessageSenderStatistics& statistics)
+    {
+        if (_sender.methods->getStatistics == nullptr)
+            return false;
+        _sender.methods->getStatistics (_sender.ref, &statistics);
+        return true;
+    }
+
+    //! test whether the remote side still is reachable - assumes it is if the sender cannot tell
+    bool isRemoteConnected () { return (_sender.methods->isReceiverConnected == nullptr) || _sender.methods->isReceiverConnected (_sender.ref); }
+
+protected:
+    //! redirect all subsequent calls to a different sender, e.g. after replacing a lost remote process
+    void setSender (ARAIPCMessageSender sender) noexcept { _sender = sender; }
+
+private:
+    template<typename... Args>
+    void _encodeArguments (ARAIPCMessageEncoder& encoder, const Args &... args)
+    {
+        const PODEncodingScope podEncodingScope { receiverEndianessMatches () };
+        encodeArguments (encoder, args...);
+    }
+
+    // results that are decoded in-place (such as BytesDecoder) are left untouched upon failure
+    template<typename RetT>
+    static void _resetResult (RetT& result, std::true_type /*isDefaultConstructible*/) { result = RetT {}; }
+    template<typename RetT>
+    static void _resetResult (RetT& /*result*/, std::false_type /*isDefaultConstructible*/) {}
+
+    bool _sendMessage (const bool stackable, const ARAIPCMessageID messageID, const ARAIPCMessageEncoder* encoder,
+                       ARAIPCReplyHandler* const replyHandler, void* replyHandlerUserData)
+    {
+        const auto timeout { _getTimeout (messageID) };
+        if (_sender.methods->sendMessageWithTimeout == nullptr)
+            return _sendMessageWithoutTimeout (stackable, messageID, encoder, replyHandler, replyHandlerUserData);
+
+        // kNoTimeout waits indefinitely, but still reports a lost connection
+        const auto didReceiveReply { _sender.methods->sendMessageWithTimeout (stackable, _sender.ref, messageID, encoder, replyHandler, replyHandlerUserData, timeout) };
+        if (!didReceiveReply)
+        {
+            if (timeout == kNoTimeout)
+                ARA_WARN ("remote call with message ID %i failed because the connection has been lost", static_cast<int> (messageID));
+            else
+                ARA_WARN ("remote call with message ID %i failed to complete within %i ms", static_cast<int> (messageID), static_cast<int> (timeout));
+        }
+        return didReceiveReply;
+    }
+
+    // senders without sendMessageWithTimeout () do not report failure, so track whether the reply
+    // handler has been invoked - calls without reply can only check whether the remote is connected
+    bool _sendMessageWithoutTimeout (const bool stackable, const ARAIPCMessageID messageID, const ARAIPCMessageEncoder* encoder,
+                                     ARAIPCReplyHandler* const replyHandler, void* replyHandlerUserData)
+    {
+        if (!replyHandler)
+        {
+            _sender.methods->sendMessage (stackable, _sender.ref, messageID, encoder, nullptr, nullptr);
+            return isRemoteConnected ();
+        }
+
+        struct TrackedReply
+        {
+            ARAIPCReplyHandler* const replyHandler;
+            void* const replyHandlerUserData;
+            bool didReceiveReply;
+        } trackedReply { replyHandler, replyHandlerUserData, false };
+        ARAIPCReplyHandler trackingReplyHandler { [] (const ARAIPCMessageDecoder decoder, void* userData) -> void
+            {
+                auto& tracked { *static_cast<TrackedReply*> (userData) };
+                tracked.didReceiveReply = true;
+                (*tracked.replyHandler) (decoder, tracked.replyHandlerUserData);
+            } };
+        _sender.methods->sendMessage (stackable, _sender.ref, messageID, encoder, &trackingReplyHandler, &trackedReply);
+        if (!trackedReply.didReceiveReply)
+            ARA_WARN ("remote call with message ID %i did not receive a reply", static_cast<int> (messageID));
+        return trackedReply.didReceiveReply;
+    }
+
+    static int32_t _getTimeout (const ARAIPCMessageID messageID)
+    {
+        const auto scopeTimeout { _getCurrentScopeTimeout () };
+        if (scopeTimeout >= kNoTimeout)
+            return scopeTimeout;
+
+        return (messageID < kMessageIDsCount) ? _getDefaultTimeouts ()[messageID] : kNoTimeout;
+    }
+
+    // dense table indexed by message ID, zero-initialized to kNoTimeout
+    static int32_t (&_getDefaultTimeouts ()) [kMessageIDsCount]
+    {
+        static int32_t defaultTimeouts[kMessageIDsCount] {};
+        return defaultTimeouts;
+    }
+
+    static int32_t& _getCurrentScopeTimeout ()
+    {
+        static thread_local int32_t currentScopeTimeout { -1 };     // -1: no scope active
+        return currentScopeTimeout;
+    }
+
 private:
     ARAIPCMessageSender _sender;
 };
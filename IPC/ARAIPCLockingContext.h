@@ -47,6 +47,9 @@ extern "C" {
 //! To handle this properly, the locking strategy is separated into this LockingContext class.
 //! All communication that interacts in the non-IPC ARA world must use the same locking context,
 //! i.e. all calls to/from a given document controller and all plug-in extensions bound to it.
+//! Conversely, communication for different document controllers does not need to share a locking
+//! context - when multiplexing several documents over a single connection, each document should
+//! use its own stream and locking context so that calls for one document cannot block the others.
 //! \todo Are all Companion API calls independent of ARA, or might there be the need in certain
 //!       situations to also lock around some Companion API calls?
 //! \todo It is possible for a LockingContext instance to be used across several communication
@@ -0,0 +1,423 @@
+//------------------------------------------------------------------------------
+//! \file       ARAIPCModelMirror.cpp
+//!             shared memory mirror of the plug-in document model state,
+//!             maintained by the proxy host and read by the proxy plug-in
+//! \project    ARA SDK Examples
+//! \copyright  Copyright (c) 2021-2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#include "ARAIPCModelMirror.h"
+
+
+#if ARA_ENABLE_IPC
+
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(__APPLE__) || defined(__linux__)
+    #define ARA_IPC_MODEL_MIRROR_SUPPORTED 1
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#else
+    #define ARA_IPC_MODEL_MIRROR_SUPPORTED 0
+#endif
+
+
+namespace ARA {
+namespace IPC {
+
+/*******************************************************************************/
+// shared memory layout
+
+// all data is accessed through lock-free atomics, which may be shared across processes
+struct ModelMirror::_Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;      // always a power of two
+    uint32_t recordSize;
+};
+
+struct ModelMirror::_Record
+{
+    std::atomic<uint32_t> sequence;         // odd while being written
+    std::atomic<uint32_t> status;           // slot state, plus the object kind in the upper bits
+    std::atomic<uint64_t> key;
+    std::atomic<uint64_t> generation;
+    std::atomic<uint64_t> flags;            // available content types, incomplete content types << 16, preserving signal << 32
+    std::atomic<uint64_t> contentGrades;    // 8 bits per content type index
+    std::atomic<uint64_t> headTime;         // bit patterns of the ARATimeDuration values
+    std::atomic<uint64_t> tailTime;
+};
+
+constexpr uint32_t kModelMirrorMagic { 0x4D495252 };    // 'MIRR'
+constexpr uint32_t kModelMirrorVersion { 1 };
+
+// slot states - empty slots terminate the probing, removed slots do not
+enum : uint32_t
+{
+    kSlotEmpty = 0,
+    kSlotRemoved = 1,
+    kSlotValid = 2,
+    kSlotInvalidated = 3
+};
+constexpr uint32_t kSlotStateMask { 0xFF };
+constexpr uint32_t kSlotKindShift { 8 };
+
+constexpr uint64_t kIncompleteContentTypesShift { 16 };
+constexpr uint64_t kPreservingSignalFlag { uint64_t { 1 } << 32 };
+
+// if the writer is stuck while updating a record (e.g. because its process has crashed),
+// readers give up after a few attempts and fall back to messaging
+constexpr int kMaxReadAttempts { 64 };
+
+
+/*******************************************************************************/
+
+static const ARAContentType _mirroredContentTypes[] { kARAContentTypeNotes, kARAContentTypeTempoEntries, kARAContentTypeBarSignatures,
+                                                      kARAContentTypeStaticTuning, kARAContentTypeKeySignatures, kARAContentTypeSheetChords };
+static_assert (sizeof (_mirroredContentTypes) / sizeof (_mirroredContentTypes[0]) == ModelMirror::kContentTypesCount, "content type table out of sync");
+
+int ModelMirror::getContentTypeIndex (ARAContentType type) noexcept
+{
+    for (auto i { 0U }; i < kContentTypesCount; ++i)
+    {
+        if (_mirroredContentTypes[i] == type)
+            return static_cast<int> (i);
+    }
+    return -1;
+}
+
+ARAContentType ModelMirror::getContentType (size_t index) noexcept
+{
+    ARA_INTERNAL_ASSERT (index < kContentTypesCount);
+    return _mirroredContentTypes[index];
+}
+
+bool ModelMirror::ObjectState::isContentAvailable (ARAContentType type) const noexcept
+{
+    const auto index { getContentTypeIndex (type) };
+    return (index >= 0) && ((availableContentTypes & (1U << index)) != 0);
+}
+
+ARAContentGrade ModelMirror::ObjectState::getContentGrade (ARAContentType type) const noexcept
+{
+    const auto index { getContentTypeIndex (type) };
+    return (index >= 0) ? contentGrades[index] : kARAContentGradeInitial;
+}
+
+bool ModelMirror::ObjectState::isContentAnalysisIncomplete (ARAContentType type) const noexcept
+{
+    const auto index { getContentTypeIndex (type) };
+    return (index >= 0) && ((incompleteContentTypes & (1U << index)) != 0);
+}
+
+/*******************************************************************************/
+
+ModelMirror::ModelMirror (void* address, size_t size) noexcept
+: _address { address },
+  _size { size }
+{}
+
+ModelMirror::~ModelMirror ()
+{
+#if ARA_IPC_MODEL_MIRROR_SUPPORTED
+    ::munmap (_address, _size);
+#endif
+}
+
+size_t ModelMirror::_getRegionSize (uint32_t capacity) noexcept
+{
+    return sizeof (_Header) + capacity * sizeof (_Record);
+}
+
+ModelMirror::_Record* ModelMirror::_getRecords () const noexcept
+{
+    return reinterpret_cast<_Record*> (static_cast<uint8_t*> (_address) + sizeof (_Header));
+}
+
+uint32_t ModelMirror::_getCapacity () const noexcept
+{
+    return static_cast<const _Header*> (_address)->capacity;
+}
+
+uint32_t ModelMirror::_getHashIndex (ObjectKind kind, uint64_t key, uint32_t capacity) noexcept
+{
+    // refs typically are aligned pointers, so mix all bits before masking
+    auto hash { (key ^ static_cast<uint64_t> (kind)) * 0x9E3779B97F4A7C15ULL };
+    hash ^= hash >> 32;
+    return static_cast<uint32_t> (hash) & (capacity - 1);
+}
+
+/*******************************************************************************/
+
+ModelMirrorWriter::ModelMirrorWriter (void* address, size_t size, std::string&& name) noexcept
+: ModelMirror { address, size },
+  _name { std::move (name) }
+{}
+
+ModelMirrorWriter* ModelMirrorWriter::create (uint32_t capacity)
+{
+#if ARA_IPC_MODEL_MIRROR_SUPPORTED
+    if (!std::atomic<uint64_t> {}.is_lock_free ())
+        return nullptr;
+
+    uint32_t actualCapacity { 16 };
+    while (actualCapacity < capacity)
+        actualCapacity *= 2;
+
+    // names must be short on macOS, so only use process ID and a counter
+    static std::atomic<uint32_t> counter { 0 };
+    std::string name { "/ARAIPCMirror." + std::to_string (::getpid ()) + "." + std::to_string (counter++) };
+
+    const auto fd { ::shm_open (name.c_str (), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR) };
+    if (fd < 0)
+        return nullptr;
+
+    const auto size { _getRegionSize (actualCapacity) };
+    void* address { MAP_FAILED };
+    if (::ftruncate (fd, static_cast<off_t> (size)) == 0)
+        address = ::mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close (fd);
+    if (address == MAP_FAILED)
+    {
+        ::shm_unlink (name.c_str ());
+        return nullptr;
+    }
+
+    // the region is zero-filled, which matches the initial state of all records
+    const auto header { new (address) _Header };
+    header->magic = kModelMirrorMagic;
+    header->version = kModelMirrorVersion;
+    header->capacity = actualCapacity;
+    header->recordSize = sizeof (_Record);
+    auto writer { new ModelMirrorWriter { address, size, std::move (name) } };
+    for (auto i { 0U }; i < actualCapacity; ++i)
+        new (writer->_getRecords () + i) _Record {};
+    std::atomic_thread_fence (std::memory_order_release);
+    return writer;
+#else
+    (void) capacity;
+    return nullptr;
+#endif
+}
+
+ModelMirrorWriter::~ModelMirrorWriter ()
+{
+#if ARA_IPC_MODEL_MIRROR_SUPPORTED
+    // typically already released by the reader after opening
+    ::shm_unlink (_name.c_str ());
+#endif
+}
+
+bool ModelMirrorWriter::update (ObjectKind kind, uint64_t key, const ObjectState& state) noexcept
+{
+    const auto records { _getRecords () };
+    const auto capacity { _getCapacity () };
+
+    uint32_t index;
+    const auto it { _indices.find ({ kind, key }) };
+    if (it != _indices.end ())
+    {
+        index = it->second;
+    }
+    else
+    {
+        // claim the first slot not in use along the probing sequence
+        index = _getHashIndex (kind, key, capacity);
+        auto probeCount { 0U };
+        for (; probeCount < capacity; ++probeCount, index = (index + 1) & (capacity - 1))
+        {
+            const auto slotState { records[index].status.load (std::memory_order_relaxed) & kSlotStateMask };
+            if ((slotState == kSlotEmpty) || (slotState == kSlotRemoved))
+                break;
+        }
+        if (probeCount == capacity)
+            return false;
+        _indices.emplace (std::make_pair (kind, key), index);
+    }
+
+    uint64_t flags { state.availableContentTypes | (uint64_t { state.incompleteContentTypes } << kIncompleteContentTypesShift) };
+    if (state.preservesAudioSourceSignal)
+        flags |= kPreservingSignalFlag;
+    uint64_t contentGrades { 0 };
+    for (auto i { 0U }; i < kContentTypesCount; ++i)
+        contentGrades |= (static_cast<uint64_t> (state.contentGrades[i]) & 0xFF) << (8 * i);
+    uint64_t headTime, tailTime;
+    static_assert (sizeof (headTime) == sizeof (state.headTime), "ARATimeDuration must be a 64 bit type");
+    std::memcpy (&headTime, &state.headTime, sizeof (headTime));
+    std::memcpy (&tailTime, &state.tailTime, sizeof (tailTime));
+
+    auto& record { records[index] };
+    const auto sequence { record.sequence.load (std::memory_order_relaxed) };
+    record.sequence.store (sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    record.status.store ((static_cast<uint32_t> (kind) << kSlotKindShift) | kSlotValid, std::memory_order_relaxed);
+    record.key.store (key, std::memory_order_relaxed);
+    record.generation.store (record.generation.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    record.flags.store (flags, std::memory_order_relaxed);
+    record.contentGrades.store (contentGrades, std::memory_order_relaxed);
+    record.headTime.store (headTime, std::memory_order_relaxed);
+    record.tailTime.store (tailTime, std::memory_order_relaxed);
+    record.sequence.store (sequence + 2, std::memory_order_release);
+    return true;
+}
+
+void ModelMirrorWriter::invalidate (ObjectKind kind, uint64_t key) noexcept
+{
+    const auto it { _indices.find ({ kind, key }) };
+    if (it == _indices.end ())
+        return;
+
+    auto& record { _getRecords ()[it->second] };
+    const auto sequence { record.sequence.load (std::memory_order_relaxed) };
+    record.sequence.store (sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    record.status.store ((static_cast<uint32_t> (kind) << kSlotKindShift) | kSlotInvalidated, std::memory_order_relaxed);
+    record.generation.store (record.generation.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    record.sequence.store (sequence + 2, std::memory_order_release);
+}
+
+void ModelMirrorWriter::remove (ObjectKind kind, uint64_t key) noexcept
+{
+    const auto it { _indices.find ({ kind, key }) };
+    if (it == _indices.end ())
+        return;
+
+    const auto records { _getRecords () };
+    const auto capacity { _getCapacity () };
+    const auto index { it->second };
+    _indices.erase (it);
+
+    // if the probing terminates after this slot anyways, it can be emptied instead of being marked as removed
+    const auto nextSlotState { records[(index + 1) & (capacity - 1)].status.load (std::memory_order_relaxed) & kSlotStateMask };
+    const auto slotState { (nextSlotState == kSlotEmpty) ? kSlotEmpty : kSlotRemoved };
+
+    auto& record { records[index] };
+    const auto sequence { record.sequence.load (std::memory_order_relaxed) };
+    record.sequence.store (sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    record.status.store (slotState, std::memory_order_relaxed);
+    record.key.store (0, std::memory_order_relaxed);
+    record.sequence.store (sequence + 2, std::memory_order_release);
+}
+
+/*******************************************************************************/
+
+ModelMirrorReader* ModelMirrorReader::open (const char* name)
+{
+#if ARA_IPC_MODEL_MIRROR_SUPPORTED
+    if (!std::atomic<uint64_t> {}.is_lock_free ())
+        return nullptr;
+
+    const auto fd { ::shm_open (name, O_RDONLY, 0) };
+    if (fd < 0)
+        return nullptr;
+
+    // the name is no longer needed once the region has been opened
+    ::shm_unlink (name);
+
+    struct stat fileStat;
+    void* address { MAP_FAILED };
+    if ((::fstat (fd, &fileStat) == 0) && (static_cast<size_t> (fileStat.st_size) >= sizeof (_Header)))
+        address = ::mmap (nullptr, static_cast<size_t> (fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close (fd);
+    if (address == MAP_FAILED)
+        return nullptr;
+
+    const auto size { static_cast<size_t> (fileStat.st_size) };
+    const auto header { static_cast<const _Header*> (address) };
+    if ((header->magic != kModelMirrorMagic) || (header->version != kModelMirrorVersion) ||
+        (header->recordSize != sizeof (_Record)) || (header->capacity == 0) ||
+        ((header->capacity & (header->capacity - 1)) != 0) || (_getRegionSize (header->capacity) > size))
+    {
+        ::munmap (address, size);
+        return nullptr;
+    }
+    std::atomic_thread_fence (std::memory_order_acquire);
+
+    return new ModelMirrorReader { address, size };
+#else
+    (void) name;
+    return nullptr;
+#endif
+}
+
+bool ModelMirrorReader::read (ObjectKind kind, uint64_t key, ObjectState& state) const noexcept
+{
+    const auto records { _getRecords () };
+    const auto capacity { _getCapacity () };
+
+    auto index { _getHashIndex (kind, key, capacity) };
+    for (auto probeCount { 0U }; probeCount < capacity; ++probeCount, index = (index + 1) & (capacity - 1))
+    {
+        const auto& record { records[index] };
+
+        uint32_t status;
+        uint64_t recordKey, generation, flags, contentGrades, headTime, tailTime;
+        for (auto attempt { 0 }; ; ++attempt)
+        {
+            if (attempt == kMaxReadAttempts)
+                return false;
+
+            const auto sequence { record.sequence.load (std::memory_order_acquire) };
+            if ((sequence & 1) != 0)
+            {
+                std::this_thread::yield ();
+                continue;
+            }
+            status = record.status.load (std::memory_order_relaxed);
+            recordKey = record.key.load (std::memory_order_relaxed);
+            generation = record.generation.load (std::memory_order_relaxed);
+            flags = record.flags.load (std::memory_order_relaxed);
+            contentGrades = record.contentGrades.load (std::memory_order_relaxed);
+            headTime = record.headTime.load (std::memory_order_relaxed);
+            tailTime = record.tailTime.load (std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (record.sequence.load (std::memory_order_relaxed) == sequence)
+                break;
+        }
+
+        const auto slotState { status & kSlotStateMask };
+        if (slotState == kSlotEmpty)
+            return false;
+        if ((slotState == kSlotRemoved) || (recordKey != key) || ((status >> kSlotKindShift) != static_cast<uint32_t> (kind)))
+            continue;
+        if (slotState == kSlotInvalidated)
+            return false;
+
+        state.generation = generation;
+        state.availableContentTypes = static_cast<uint32_t> (flags & ((1U << kIncompleteContentTypesShift) - 1));
+        state.incompleteContentTypes = static_cast<uint32_t> ((flags >> kIncompleteContentTypesShift) & ((1U << kIncompleteContentTypesShift) - 1));
+        state.preservesAudioSourceSignal = ((flags & kPreservingSignalFlag) != 0);
+        for (auto i { 0U }; i < kContentTypesCount; ++i)
+            state.contentGrades[i] = static_cast<ARAContentGrade> ((contentGrades >> (8 * i)) & 0xFF);
+        std::memcpy (&state.headTime, &headTime, sizeof (headTime));
+        std::memcpy (&state.tailTime, &tailTime, sizeof (tailTime));
+        return true;
+    }
+    return false;
+}
+
+}   // namespace IPC
+}   // namespace ARA
+
+#endif // ARA_ENABLE_IPC
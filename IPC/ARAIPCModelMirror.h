@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//! \file       ARAIPCModelMirror.h
+//!             shared memory mirror of the plug-in document model state,
+//!             maintained by the proxy host and read by the proxy plug-in
+//! \project    ARA SDK Examples
+//! \copyright  Copyright (c) 2021-2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARAIPCModelMirror_h
+#define ARAIPCModelMirror_h
+
+#include "ARA_Library/IPC/ARAIPC.h"
+
+
+#if ARA_ENABLE_IPC
+
+#include "ARA_Library/Dispatch/ARADispatchBase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+
+namespace ARA {
+namespace IPC {
+
+//! Model Mirror
+//! The proxy host can publish the plug-in state that the host frequently polls (content availability
+//! and grades, analysis state, signal preservation, head and tail times) in a shared memory region,
+//! so that the proxy plug-in can answer these queries without sending a message.
+//! The region contains a fixed-capacity hash table of records, keyed by the object kind and the
+//! object ref as seen by the proxy plug-in. Each record is protected by a sequence lock: the single
+//! writer makes the sequence number odd while updating, readers retry (or give up and fall back to
+//! messaging) if the number was odd or changed while they were reading.
+//! Each update increments the generation of the record, which allows for detecting changes by
+//! comparing generations. Records can also be invalidated, which makes readers fall back to
+//! messaging until the record is updated again.
+//! Shared memory is only available on macOS and Linux - elsewhere, creating or opening a mirror
+//! fails and the proxies always use messaging.
+//! @{
+
+class ModelMirror
+{
+public:
+    //! kinds of mirrored objects
+    enum class ObjectKind : uint32_t
+    {
+        audioSource = 1,
+        audioModification = 2,
+        playbackRegion = 3
+    };
+
+    //! key for the given object ref (as seen by the proxy plug-in)
+    template<typename RefT>
+    static uint64_t getKey (RefT ref) noexcept { return static_cast<uint64_t> (reinterpret_cast<uintptr_t> (ref)); }
+
+    //! content types for which the state is mirrored, indexed by getContentTypeIndex ()
+    static constexpr size_t kContentTypesCount { 6 };
+    //! index for the given content type, or -1 if the type is not mirrored
+    static int getContentTypeIndex (ARAContentType type) noexcept;
+    //! content type for the given index
+    static ARAContentType getContentType (size_t index) noexcept;
+
+    //! snapshot of the state of an object
+    //! Members that do not apply to the kind of the object are ignored.
+    struct ObjectState
+    {
+        uint64_t generation;                                //!< set by the writer upon each update
+        uint32_t availableContentTypes;                     //!< bit set indexed by getContentTypeIndex ()
+        uint32_t incompleteContentTypes;                    //!< audio sources only: analysis incomplete
+        ARAContentGrade contentGrades[kContentTypesCount];  //!< indexed by getContentTypeIndex ()
+        bool preservesAudioSourceSignal;                    //!< audio modifications only
+        ARATimeDuration headTime;                           //!< playback regions only
+        ARATimeDuration tailTime;                           //!< playback regions only
+
+        bool isContentAvailable (ARAContentType type) const noexcept;
+        ARAContentGrade getContentGrade (ARAContentType type) const noexcept;
+        bool isContentAnalysisIncomplete (ARAContentType type) const noexcept;
+    };
+
+    ~ModelMirror ();
+
+protected:
+    struct _Header;
+    struct _Record;
+
+    ModelMirror (void* address, size_t size) noexcept;
+    static size_t _getRegionSize (uint32_t capacity) noexcept;
+    _Record* _getRecords () const noexcept;
+    uint32_t _getCapacity () const noexcept;
+    static uint32_t _getHashIndex (ObjectKind kind, uint64_t key, uint32_t capacity) noexcept;
+
+private:
+    void* const _address;
+    const size_t _size;
+
+    ARA_DISABLE_COPY_AND_MOVE (ModelMirror)
+};
+
+//! writing side, owning the shared memory region
+//! Updates must not be performed concurrently.
+class ModelMirrorWriter : public ModelMirror
+{
+public:
+    //! create a new region that can hold up to capacity objects
+    //! Returns nullptr if shared memory is not available.
+    static ModelMirrorWriter* create (uint32_t capacity);
+    ~ModelMirrorWriter ();
+
+    //! name to pass to ModelMirrorReader::open ()
+    const char* getName () const noexcept { return _name.c_str (); }
+
+    //! publish the state of the object, adding it to the table if needed
+    //! The generation of state is ignored, the record's generation is incremented instead.
+    //! Returns false if the table is full, in which case the object is simply not mirrored.
+    bool update (ObjectKind kind, uint64_t key, const ObjectState& state) noexcept;
+    //! make readers fall back to messaging until the next update
+    void invalidate (ObjectKind kind, uint64_t key) noexcept;
+    //! remove the object from the table
+    void remove (ObjectKind kind, uint64_t key) noexcept;
+
+private:
+    ModelMirrorWriter (void* address, size_t size, std::string&& name) noexcept;
+
+private:
+    const std::string _name;
+    std::map<std::pair<ObjectKind, uint64_t>, uint32_t> _indices;
+};
+
+//! reading side, mapping the region read-only
+class ModelMirrorReader : public ModelMirror
+{
+public:
+    //! map the region previously created by ModelMirrorWriter::create ()
+    //! Returns nullptr if the region cannot be accessed, e.g. because it resides on another machine.
+    static ModelMirrorReader* open (const char* name);
+
+    //! read a consistent snapshot of the state of the object
+    //! Returns false if the object is not mirrored, has been invalidated, or is being updated
+    //! for too long - the caller then must obtain the state via messaging.
+    bool read (ObjectKind kind, uint64_t key, ObjectState& state) const noexcept;
+
+private:
+    using ModelMirror::ModelMirror;
+};
+
+//! @}
+
+}   // namespace IPC
+}   // namespace ARA
+
+#endif // ARA_ENABLE_IPC
+
+#endif // ARAIPCModelMirror_h
@@ -22,6 +22,7 @@
 #if ARA_ENABLE_IPC
 
 #include "ARA_Library/IPC/ARAIPCEncoding.h"
+#include "ARA_Library/IPC/ARAIPCModelMirror.h"
 #include "ARA_Library/Dispatch/ARAHostDispatch.h"
 #include "ARA_Library/Dispatch/ARAPlugInDispatch.h"
 
@@ -31,6 +32,8 @@
 #endif
 
 #include <cstring>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -74,8 +77,11 @@ ARA_MAP_HOST_REF (RemoteAudioReader, ARAAudioReaderHostRef)
 
 struct RemoteContentReader
 {
+    RemoteContentReader (ARAContentReaderRef ref, ARAContentType type)
+    : plugInRef { ref }, encoder { type } {}
+
     ARAContentReaderRef plugInRef;
-    ARAContentType contentType;
+    ContentEventEncoder encoder;
 };
 ARA_MAP_REF (RemoteContentReader, ARAContentReaderRef)
 
@@ -86,10 +92,346 @@ struct RemoteHostContentReader
 
     ARAContentReaderHostRef remoteHostRef;
     ContentEventDecoder decoder;
+    ARAInt32 eventCount { -1 };     // -1 until queried
 };
 ARA_MAP_HOST_REF (RemoteHostContentReader, ARAContentReaderHostRef)
 
 
+/*******************************************************************************/
+//! Maintains the shared memory mirror of the plug-in state of a document, if enabled
+//! (see ARAIPCProxyHostSetModelMirrorCapacity()) - otherwise all calls are no-ops.
+//! Whenever an object may have changed, its record is invalidated so that the proxy plug-in
+//! falls back to messaging, and the object is marked as dirty. Dirty objects are refreshed by
+//! querying the plug-in as soon as this is allowed, i.e. right away, or after endEditing () or
+//! after notifyModelUpdates () has returned if the change happened while editing or notifying.
+//! Changes of audio sources and audio modifications propagate to their dependent objects.
+class DocumentMirror
+{
+public:
+    explicit DocumentMirror (ModelMirrorWriter* writer) noexcept
+    : _writer { writer } {}
+
+    void setDocumentController (Host::DocumentController* documentController) noexcept;
+
+    // name to pass to the proxy plug-in, empty if the mirror is disabled
+    const char* getName () const noexcept { return (_writer) ? _writer->getName () : ""; }
+
+    // bracketing of the calls that defer refreshing dirty objects
+    void willBeginEditing () noexcept;
+    void didEndEditing () noexcept;
+    void willNotifyModelUpdates () noexcept;
+    void didNotifyModelUpdates () noexcept;
+
+    void didCreate (ARAAudioSourceRef audioSourceRef) noexcept;
+    void didCreate (ARAAudioModificationRef audioModificationRef, ARAAudioModificationHostRef hostRef, ARAAudioSourceRef audioSourceRef) noexcept;
+    void didClone (ARAAudioModificationRef audioModificationRef, ARAAudioModificationHostRef hostRef, ARAAudioModificationRef srcAudioModificationRef) noexcept;
+    void didCreate (ARAPlaybackRegionRef playbackRegionRef, ARAPlaybackRegionHostRef hostRef, ARAAudioModificationRef audioModificationRef) noexcept;
+
+    void willDestroy (ARAAudioSourceRef audioSourceRef) noexcept;
+    void willDestroy (ARAAudioModificationRef audioModificationRef) noexcept;
+    void willDestroy (ARAPlaybackRegionRef playbackRegionRef) noexcept;
+
+    // the host refs variants are used for the notifications from the plug-in
+    void didChange (ARAAudioSourceRef audioSourceRef) noexcept;
+    void didChange (ARAAudioModificationRef audioModificationRef) noexcept;
+    void didChange (ARAAudioModificationHostRef audioModificationHostRef) noexcept;
+    void didChange (ARAPlaybackRegionRef playbackRegionRef) noexcept;
+    void didChange (ARAPlaybackRegionHostRef playbackRegionHostRef) noexcept;
+    // e.g. upon changes to musical contexts or region sequences
+    void didChangeAllPlaybackRegions () noexcept;
+    void didChangeAllObjects () noexcept;
+
+private:
+    using ObjectKind = ModelMirror::ObjectKind;
+    using Key = std::pair<ObjectKind, uint64_t>;
+    struct Object
+    {
+        uint64_t parentKey;     // audio source of an audio modification, or audio modification of a playback region
+        uint64_t hostRef;
+        bool isDirty;
+    };
+
+    void _add (ObjectKind kind, uint64_t key, uint64_t parentKey, uint64_t hostRef) noexcept;
+    void _remove (ObjectKind kind, uint64_t key) noexcept;
+    void _markDirty (ObjectKind kind, uint64_t key) noexcept;
+    void _refreshIfAllowed () noexcept;
+    void _refresh (const Key& key) noexcept;
+
+private:
+    const std::unique_ptr<ModelMirrorWriter> _writer;
+    Host::DocumentController* _documentController {};
+    uint32_t _analyzeableContentTypes {};
+    std::map<Key, Object> _objects;
+    std::map<uint64_t, uint64_t> _audioModificationsByHostRef;
+    std::map<uint64_t, uint64_t> _playbackRegionsByHostRef;
+    bool _isEditing { false };
+    bool _isNotifying { false };
+    bool _hasDirtyObjects { false };
+};
+
+/*******************************************************************************/
+
+template<typename RefT>
+inline RefT _toRefFromMirrorKey (uint64_t key)
+{
+    return reinterpret_cast<RefT> (static_cast<uintptr_t> (key));
+}
+
+void DocumentMirror::setDocumentController (Host::DocumentController* documentController) noexcept
+{
+    _documentController = documentController;
+
+    const auto factory { documentController->getFactory () };
+    for (auto i { 0U }; i < factory->analyzeableContentTypesCount; ++i)
+    {
+        const auto index { ModelMirror::getContentTypeIndex (factory->analyzeableContentTypes[i]) };
+        if (index >= 0)
+            _analyzeableContentTypes |= 1U << index;
+    }
+}
+
+void DocumentMirror::willBeginEditing () noexcept
+{
+    _isEditing = true;
+}
+
+void DocumentMirror::didEndEditing () noexcept
+{
+    _isEditing = false;
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::willNotifyModelUpdates () noexcept
+{
+    _isNotifying = true;
+}
+
+void DocumentMirror::didNotifyModelUpdates () noexcept
+{
+    _isNotifying = false;
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didCreate (ARAAudioSourceRef audioSourceRef) noexcept
+{
+    _add (ObjectKind::audioSource, ModelMirror::getKey (audioSourceRef), 0, 0);
+}
+
+void DocumentMirror::didCreate (ARAAudioModificationRef audioModificationRef, ARAAudioModificationHostRef hostRef, ARAAudioSourceRef audioSourceRef) noexcept
+{
+    _add (ObjectKind::audioModification, ModelMirror::getKey (audioModificationRef), ModelMirror::getKey (audioSourceRef), ModelMirror::getKey (hostRef));
+}
+
+void DocumentMirror::didClone (ARAAudioModificationRef audioModificationRef, ARAAudioModificationHostRef hostRef, ARAAudioModificationRef srcAudioModificationRef) noexcept
+{
+    const auto it { _objects.find ({ ObjectKind::audioModification, ModelMirror::getKey (srcAudioModificationRef) }) };
+    if (it != _objects.end ())
+        _add (ObjectKind::audioModification, ModelMirror::getKey (audioModificationRef), it->second.parentKey, ModelMirror::getKey (hostRef));
+}
+
+void DocumentMirror::didCreate (ARAPlaybackRegionRef playbackRegionRef, ARAPlaybackRegionHostRef hostRef, ARAAudioModificationRef audioModificationRef) noexcept
+{
+    _add (ObjectKind::playbackRegion, ModelMirror::getKey (playbackRegionRef), ModelMirror::getKey (audioModificationRef), ModelMirror::getKey (hostRef));
+}
+
+void DocumentMirror::willDestroy (ARAAudioSourceRef audioSourceRef) noexcept
+{
+    _remove (ObjectKind::audioSource, ModelMirror::getKey (audioSourceRef));
+}
+
+void DocumentMirror::willDestroy (ARAAudioModificationRef audioModificationRef) noexcept
+{
+    _remove (ObjectKind::audioModification, ModelMirror::getKey (audioModificationRef));
+}
+
+void DocumentMirror::willDestroy (ARAPlaybackRegionRef playbackRegionRef) noexcept
+{
+    _remove (ObjectKind::playbackRegion, ModelMirror::getKey (playbackRegionRef));
+}
+
+void DocumentMirror::didChange (ARAAudioSourceRef audioSourceRef) noexcept
+{
+    _markDirty (ObjectKind::audioSource, ModelMirror::getKey (audioSourceRef));
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didChange (ARAAudioModificationRef audioModificationRef) noexcept
+{
+    _markDirty (ObjectKind::audioModification, ModelMirror::getKey (audioModificationRef));
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didChange (ARAAudioModificationHostRef audioModificationHostRef) noexcept
+{
+    const auto it { _audioModificationsByHostRef.find (ModelMirror::getKey (audioModificationHostRef)) };
+    if (it != _audioModificationsByHostRef.end ())
+        _markDirty (ObjectKind::audioModification, it->second);
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didChange (ARAPlaybackRegionRef playbackRegionRef) noexcept
+{
+    _markDirty (ObjectKind::playbackRegion, ModelMirror::getKey (playbackRegionRef));
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didChange (ARAPlaybackRegionHostRef playbackRegionHostRef) noexcept
+{
+    const auto it { _playbackRegionsByHostRef.find (ModelMirror::getKey (playbackRegionHostRef)) };
+    if (it != _playbackRegionsByHostRef.end ())
+        _markDirty (ObjectKind::playbackRegion, it->second);
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didChangeAllPlaybackRegions () noexcept
+{
+    for (const auto& object : _objects)
+    {
+        if (object.first.first == ObjectKind::playbackRegion)
+            _markDirty (object.first.first, object.first.second);
+    }
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::didChangeAllObjects () noexcept
+{
+    for (const auto& object : _objects)
+        _markDirty (object.first.first, object.first.second);
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::_add (ObjectKind kind, uint64_t key, uint64_t parentKey, uint64_t hostRef) noexcept
+{
+    if (!_writer)
+        return;
+
+    _objects[{ kind, key }] = { parentKey, hostRef, false };
+    if (kind == ObjectKind::audioModification)
+        _audioModificationsByHostRef[hostRef] = key;
+    else if (kind == ObjectKind::playbackRegion)
+        _playbackRegionsByHostRef[hostRef] = key;
+
+    _markDirty (kind, key);
+    _refreshIfAllowed ();
+}
+
+void DocumentMirror::_remove (ObjectKind kind, uint64_t key) noexcept
+{
+    if (!_writer)
+        return;
+
+    const auto it { _objects.find ({ kind, key }) };
+    if (it == _objects.end ())
+        return;
+
+    if (kind == ObjectKind::audioModification)
+        _audioModificationsByHostRef.erase (it->second.hostRef);
+    else if (kind == ObjectKind::playbackRegion)
+        _playbackRegionsByHostRef.erase (it->second.hostRef);
+    _objects.erase (it);
+
+    _writer->remove (kind, key);
+}
+
+void DocumentMirror::_markDirty (ObjectKind kind, uint64_t key) noexcept
+{
+    if (!_writer)
+        return;
+
+    const auto it { _objects.find ({ kind, key }) };
+    if ((it == _objects.end ()) || it->second.isDirty)
+        return;
+
+    it->second.isDirty = true;
+    _hasDirtyObjects = true;
+    _writer->invalidate (kind, key);
+
+    // the content of audio modifications and playback regions is derived from their parent
+    const auto dependentKind { (kind == ObjectKind::audioSource) ? ObjectKind::audioModification :
+                               (kind == ObjectKind::audioModification) ? ObjectKind::playbackRegion : ObjectKind {} };
+    if (dependentKind == ObjectKind {})
+        return;
+    for (const auto& object : _objects)
+    {
+        if ((object.first.first == dependentKind) && (object.second.parentKey == key))
+            _markDirty (dependentKind, object.first.second);
+    }
+}
+
+void DocumentMirror::_refreshIfAllowed () noexcept
+{
+    if (!_hasDirtyObjects || _isEditing || _isNotifying || (_documentController == nullptr))
+        return;
+
+    for (auto& object : _objects)
+    {
+        if (object.second.isDirty)
+        {
+            _refresh (object.first);
+            object.second.isDirty = false;
+        }
+    }
+    _hasDirtyObjects = false;
+}
+
+void DocumentMirror::_refresh (const Key& key) noexcept
+{
+    ModelMirror::ObjectState state {};
+    switch (key.first)
+    {
+        case ObjectKind::audioSource:
+        {
+            const auto audioSourceRef { fromRef (_toRefFromMirrorKey<ARAAudioSourceRef> (key.second))->plugInRef };
+            for (auto i { 0U }; i < ModelMirror::kContentTypesCount; ++i)
+            {
+                const auto type { ModelMirror::getContentType (i) };
+                if (_documentController->isAudioSourceContentAvailable (audioSourceRef, type))
+                {
+                    state.availableContentTypes |= 1U << i;
+                    state.contentGrades[i] = _documentController->getAudioSourceContentGrade (audioSourceRef, type);
+                }
+                if (((_analyzeableContentTypes & (1U << i)) != 0) && _documentController->isAudioSourceContentAnalysisIncomplete (audioSourceRef, type))
+                    state.incompleteContentTypes |= 1U << i;
+            }
+            break;
+        }
+        case ObjectKind::audioModification:
+        {
+            const auto audioModificationRef { _toRefFromMirrorKey<ARAAudioModificationRef> (key.second) };
+            for (auto i { 0U }; i < ModelMirror::kContentTypesCount; ++i)
+            {
+                const auto type { ModelMirror::getContentType (i) };
+                if (_documentController->isAudioModificationContentAvailable (audioModificationRef, type))
+                {
+                    state.availableContentTypes |= 1U << i;
+                    state.contentGrades[i] = _documentController->getAudioModificationContentGrade (audioModificationRef, type);
+                }
+            }
+            state.preservesAudioSourceSignal = _documentController->isAudioModificationPreservingAudioSourceSignal (audioModificationRef);
+            break;
+        }
+        case ObjectKind::playbackRegion:
+        {
+            const auto playbackRegionRef { _toRefFromMirrorKey<ARAPlaybackRegionRef> (key.second) };
+            for (auto i { 0U }; i < ModelMirror::kContentTypesCount; ++i)
+            {
+                const auto type { ModelMirror::getContentType (i) };
+                if (_documentController->isPlaybackRegionContentAvailable (playbackRegionRef, type))
+                {
+                    state.availableContentTypes |= 1U << i;
+                    state.contentGrades[i] = _documentController->getPlaybackRegionContentGrade (playbackRegionRef, type);
+                }
+            }
+            _documentController->getPlaybackRegionHeadAndTailTime (playbackRegionRef, &state.headTime, &state.tailTime);
+            break;
+        }
+    }
+
+    // if the table is full, the record stays invalidated and the proxy plug-in keeps using messaging
+    _writer->update (key.first, key.second, state);
+}
+
+
 /*******************************************************************************/
 //! Implementation of AudioAccessControllerInterface that channels all calls through IPC
 class AudioAccessController : public Host::AudioAccessControllerInterface, public RemoteCaller
@@ -216,8 +558,13 @@ bool AudioAccessController::readAudioSamples (ARAAudioReaderHostRef audioReaderH
             }
 
         } };
-    remoteCallWithReply (customDecode, false, ARA_IPC_HOST_METHOD_ID (ARAAudioAccessControllerInterface, readAudioSamples),
-                        _remoteHostRef, remoteAudioReader->mainHostRef, samplePosition, samplesPerChannel);
+    if (!remoteCallWithReply (customDecode, false, ARA_IPC_HOST_METHOD_ID (ARAAudioAccessControllerInterface, readAudioSamples),
+                            _remoteHostRef, remoteAudioReader->mainHostRef, samplePosition, samplesPerChannel))
+    {
+        // the reply did not arrive in time, provide silence like any other failed read
+        for (auto i { 0U }; i < channelCount; ++i)
+            std::memset (buffers[i], 0, remoteAudioReader->sampleSize * static_cast<size_t> (samplesPerChannel));
+    }
     return success;
 }
 
@@ -281,9 +628,9 @@ bool ArchivingController::readBytesFromArchive (ARAArchiveReaderHostRef archiveR
 
     auto resultLength { length };
     BytesDecoder writer { buffer, resultLength };
-    remoteCallWithReply (writer, false, ARA_IPC_HOST_METHOD_ID (ARAArchivingControllerInterface, readBytesFromArchive),
-                        _remoteHostRef, archiveReaderHostRef, position, length);
-    if (resultLength == length)
+    const auto didReceiveReply { remoteCallWithReply (writer, false, ARA_IPC_HOST_METHOD_ID (ARAArchivingControllerInterface, readBytesFromArchive),
+                                                      _remoteHostRef, archiveReaderHostRef, position, length) };
+    if (didReceiveReply && (resultLength == length))
     {
         return true;
     }
@@ -423,12 +770,29 @@ ARAInt32 ContentAccessController::getContentReaderEventCount (ARAContentReaderHo
     ARAInt32 count;
     remoteCallWithReply (count, false, ARA_IPC_HOST_METHOD_ID (ARAContentAccessControllerInterface, getContentReaderEventCount),
                         _remoteHostRef, contentReader->remoteHostRef);
+    contentReader->eventCount = count;
     return count;
 }
 
 const void* ContentAccessController::getContentReaderDataForEvent (ARAContentReaderHostRef contentReaderHostRef, ARAInt32 eventIndex) noexcept
 {
     const auto contentReader { fromHostRef (contentReaderHostRef) };
+    if (const auto decodedEvent { contentReader->decoder.findDecodedEvent (eventIndex) })
+        return decodedEvent;
+
+    // events are typically read in order, so if the event count is known, fetch a batch of subsequent events
+    if ((0 <= eventIndex) && (eventIndex < contentReader->eventCount))
+    {
+        const auto eventCount { std::min (kContentReaderEventsBatchSize, contentReader->eventCount - eventIndex) };
+        RemoteCaller::CustomDecodeFunction customDecode { [&contentReader, eventIndex] (const ARAIPCMessageDecoder& decoder) -> void
+            {
+                contentReader->decoder.decodeEvents (decoder, eventIndex);
+            } };
+        remoteCallWithReply (customDecode, false, kGetContentReaderDataForEventsMessageID,
+                            _remoteHostRef, contentReader->remoteHostRef, eventIndex, eventCount);
+        return contentReader->decoder.findDecodedEvent (eventIndex);
+    }
+
     const void* result {};
     RemoteCaller::CustomDecodeFunction customDecode { [&result, &contentReader] (const ARAIPCMessageDecoder& decoder) -> void
         {
@@ -452,8 +816,8 @@ void ContentAccessController::destroyContentReader (ARAContentReaderHostRef cont
 class ModelUpdateController : public Host::ModelUpdateControllerInterface, public RemoteCaller
 {
 public:
-    ModelUpdateController (ARAIPCMessageSender sender, ARAModelUpdateControllerHostRef remoteHostRef) noexcept
-    : RemoteCaller { sender }, _remoteHostRef { remoteHostRef } {}
+    ModelUpdateController (ARAIPCMessageSender sender, ARAModelUpdateControllerHostRef remoteHostRef, DocumentMirror* documentMirror) noexcept
+    : RemoteCaller { sender }, _remoteHostRef { remoteHostRef }, _documentMirror { documentMirror } {}
 
     void notifyAudioSourceAnalysisProgress (ARAAudioSourceHostRef audioSourceHostRef, ARAAnalysisProgressState state, float value) noexcept override;
     void notifyAudioSourceContentChanged (ARAAudioSourceHostRef audioSourceHostRef, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept override;
@@ -462,27 +826,32 @@ public:
 
 private:
     ARAModelUpdateControllerHostRef _remoteHostRef;
+    DocumentMirror* const _documentMirror;
 };
 
 /*******************************************************************************/
 
 void ModelUpdateController::notifyAudioSourceAnalysisProgress (ARAAudioSourceHostRef audioSourceHostRef, ARAAnalysisProgressState state, float value) noexcept
 {
+    _documentMirror->didChange (toRef (fromHostRef (audioSourceHostRef)));
     remoteCallWithoutReply (false, ARA_IPC_HOST_METHOD_ID (ARAModelUpdateControllerInterface, notifyAudioSourceAnalysisProgress), _remoteHostRef, fromHostRef (audioSourceHostRef)->mainHostRef, state, value);
 }
 
 void ModelUpdateController::notifyAudioSourceContentChanged (ARAAudioSourceHostRef audioSourceHostRef, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept
 {
+    _documentMirror->didChange (toRef (fromHostRef (audioSourceHostRef)));
     remoteCallWithoutReply (true, ARA_IPC_HOST_METHOD_ID (ARAModelUpdateControllerInterface, notifyAudioSourceContentChanged), _remoteHostRef, fromHostRef (audioSourceHostRef)->mainHostRef, range, scopeFlags);
 }
 
 void ModelUpdateController::notifyAudioModificationContentChanged (ARAAudioModificationHostRef audioModificationHostRef, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept
 {
+    _documentMirror->didChange (audioModificationHostRef);
     remoteCallWithoutReply (true, ARA_IPC_HOST_METHOD_ID (ARAModelUpdateControllerInterface, notifyAudioModificationContentChanged), _remoteHostRef, audioModificationHostRef, range, scopeFlags);
 }
 
 void ModelUpdateController::notifyPlaybackRegionContentChanged (ARAPlaybackRegionHostRef playbackRegionHostRef, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept
 {
+    _documentMirror->didChange (playbackRegionHostRef);
     remoteCallWithoutReply (true, ARA_IPC_HOST_METHOD_ID (ARAModelUpdateControllerInterface, notifyPlaybackRegionContentChanged), _remoteHostRef, playbackRegionHostRef, range, scopeFlags);
 }
 
@@ -535,18 +904,31 @@ void PlaybackController::requestEnableCycle (bool enable) noexcept
 
 /*******************************************************************************/
 //! Extension of Host::DocumentController that also stores the host instance visible to the plug-in
+//! and owns the model mirror of the document
 class DocumentController : public Host::DocumentController
 {
 public:
-    explicit DocumentController (const Host::DocumentControllerHostInstance* hostInstance, const ARADocumentControllerInstance* instance) noexcept
+    explicit DocumentController (const Host::DocumentControllerHostInstance* hostInstance, const ARADocumentControllerInstance* instance,
+                                 ARAIPCMessageSender callbacksSender, DocumentMirror* documentMirror) noexcept
       : Host::DocumentController { instance },
-        _hostInstance { hostInstance }
-    {}
+        _hostInstance { hostInstance },
+        _callbacksSender { callbacksSender },
+        _documentMirror { documentMirror }
+    {
+        _documentMirror->setDocumentController (this);
+    }
 
     const Host::DocumentControllerHostInstance* getHostInstance () { return _hostInstance; }
+    DocumentMirror* getDocumentMirror () { return _documentMirror.get (); }
+
+    // the sender used for the callbacks of this document, which leads to the same process as the replies -
+    // handlers that reply with structs eligible for the POD fast path test its endianess, see PODEncodingScope
+    bool callbacksReceiverEndianessMatches () { return _callbacksSender.methods->receiverEndianessMatches (_callbacksSender.ref); }
 
 private:
     const Host::DocumentControllerHostInstance* _hostInstance;
+    const ARAIPCMessageSender _callbacksSender;
+    const std::unique_ptr<DocumentMirror> _documentMirror;
 };
 ARA_MAP_REF (DocumentController, ARADocumentControllerRef)
 
@@ -585,7 +967,9 @@ using namespace ProxyHost;
 
 std::vector<const ARAFactory*> _factories {};
 ARAIPCMessageSender _plugInCallbacksSender {};
+ARAIPCPlugInCallbacksSenderProvider _plugInCallbacksSenderProvider {};
 ARAIPCBindingHandler _bindingHandler {};
+uint32_t _modelMirrorCapacity {};
 
 void ARAIPCProxyHostAddFactory (const ARAFactory* factory)
 {
@@ -600,6 +984,16 @@ void ARAIPCProxyHostSetPlugInCallbacksSender (ARAIPCMessageSender plugInCallback
     _plugInCallbacksSender = plugInCallbacksSender;
 }
 
+void ARAIPCProxyHostSetPlugInCallbacksSenderProvider (ARAIPCPlugInCallbacksSenderProvider provider)
+{
+    _plugInCallbacksSenderProvider = provider;
+}
+
+void ARAIPCProxyHostSetModelMirrorCapacity (uint32_t capacity)
+{
+    _modelMirrorCapacity = capacity;
+}
+
 void ARAIPCProxyHostSetBindingHandler(ARAIPCBindingHandler handler)
 {
     _bindingHandler = handler;
@@ -626,6 +1020,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
 {
 //  ARA_LOG ("ARAIPCProxyHostCommandHandler received message %s", decodePlugInMessageID (messageID));
 
+    // temporary storage for decoding the arguments is only needed while handling the call
+    const DecodeScratchScope decodeScratchScope {};
+
     // ARAFactory
     if (messageID == kGetFactoriesCountMessageID)
     {
@@ -669,11 +1066,23 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
 
         if (const ARAFactory* const factory { getFactoryWithID (factoryID) })
         {
-            const auto audioAccessController { new AudioAccessController { _plugInCallbacksSender, audioAccessControllerHostRef } };
-            const auto archivingController { new ArchivingController { _plugInCallbacksSender, archivingControllerHostRef } };
-            const auto contentAccessController { (provideContentAccessController != kARAFalse) ? new ContentAccessController { _plugInCallbacksSender, contentAccessControllerHostRef } : nullptr };
-            const auto modelUpdateController { (provideModelUpdateController != kARAFalse) ? new ModelUpdateController { _plugInCallbacksSender, modelUpdateControllerHostRef } : nullptr };
-            const auto playbackController { (providePlaybackController != kARAFalse) ? new PlaybackController { _plugInCallbacksSender, playbackControllerHostRef } : nullptr };
+            // if configured, each document may use a dedicated sender so that its callbacks are independent of other documents
+            ARAIPCMessageSender sender { _plugInCallbacksSender };
+            if (_plugInCallbacksSenderProvider)
+            {
+                const auto documentSender { _plugInCallbacksSenderProvider () };
+                if (documentSender.methods != nullptr)
+                    sender = documentSender;
+            }
+
+            const auto audioAccessController { new AudioAccessController { sender, audioAccessControllerHostRef } };
+            const auto archivingController { new ArchivingController { sender, archivingControllerHostRef } };
+            const auto contentAccessController { (provideContentAccessController != kARAFalse) ? new ContentAccessController { sender, contentAccessControllerHostRef } : nullptr };
+            // without model update notifications, changes of the plug-in state cannot be tracked
+            const auto documentMirror { new DocumentMirror { ((provideModelUpdateController != kARAFalse) && (_modelMirrorCapacity > 0)) ?
+                                                                ModelMirrorWriter::create (_modelMirrorCapacity) : nullptr } };
+            const auto modelUpdateController { (provideModelUpdateController != kARAFalse) ? new ModelUpdateController { sender, modelUpdateControllerHostRef, documentMirror } : nullptr };
+            const auto playbackController { (providePlaybackController != kARAFalse) ? new PlaybackController { sender, playbackControllerHostRef } : nullptr };
 
             const auto hostInstance { new Host::DocumentControllerHostInstance { audioAccessController, archivingController,
                                                                                     contentAccessController, modelUpdateController, playbackController } };
@@ -681,7 +1090,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
             auto documentControllerInstance { factory->createDocumentControllerWithDocument (hostInstance, &properties) };
             ARA_VALIDATE_API_CONDITION (documentControllerInstance != nullptr);
             ARA_VALIDATE_API_INTERFACE (documentControllerInstance->documentControllerInterface, ARADocumentControllerInterface);
-            auto documentController { new DocumentController (hostInstance, documentControllerInstance) };
+            auto documentController { new DocumentController (hostInstance, documentControllerInstance, sender, documentMirror) };
             return encodeReply (replyEncoder, ARADocumentControllerRef { toRef (documentController) });
         }
     }
@@ -703,6 +1112,13 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         if (const ARAFactory* const factory { getFactoryWithID (factoryID) })
             factory->uninitializeARA();
     }
+    else if (messageID == kGetModelMirrorMessageID)
+    {
+        ARADocumentControllerRef controllerRef;
+        decodeArguments (decoder, controllerRef);
+
+        return encodeReply (replyEncoder, fromRef (controllerRef)->getDocumentMirror ()->getName ());
+    }
 
     //ARADocumentControllerInterface
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyDocumentController))
@@ -735,6 +1151,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARADocumentControllerRef controllerRef;
         decodeArguments (decoder, controllerRef);
 
+        fromRef (controllerRef)->getDocumentMirror ()->willBeginEditing ();
         fromRef (controllerRef)->beginEditing ();
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, endEditing))
@@ -743,13 +1160,16 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef);
 
         fromRef (controllerRef)->endEditing ();
+        fromRef (controllerRef)->getDocumentMirror ()->didEndEditing ();
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, notifyModelUpdates))
     {
         ARADocumentControllerRef controllerRef;
         decodeArguments (decoder, controllerRef);
 
+        fromRef (controllerRef)->getDocumentMirror ()->willNotifyModelUpdates ();
         fromRef (controllerRef)->notifyModelUpdates ();
+        fromRef (controllerRef)->getDocumentMirror ()->didNotifyModelUpdates ();
     }
 
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, restoreObjectsFromArchive))
@@ -759,7 +1179,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         OptionalArgument<ARARestoreObjectsFilter> filter;
         decodeArguments (decoder, controllerRef, archiveReaderHostRef, filter);
 
-        return encodeReply (replyEncoder, fromRef (controllerRef)->restoreObjectsFromArchive (archiveReaderHostRef, (filter.second) ? &filter.first : nullptr) ? kARATrue : kARAFalse);
+        const auto result { fromRef (controllerRef)->restoreObjectsFromArchive (archiveReaderHostRef, (filter.second) ? &filter.first : nullptr) };
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllObjects ();
+        return encodeReply (replyEncoder, (result) ? kARATrue : kARAFalse);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, storeObjectsToArchive))
     {
@@ -768,12 +1190,12 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         OptionalArgument<ARAStoreObjectsFilter> filter;
         decodeArguments (decoder, controllerRef, archiveWriterHostRef, filter);
 
-        std::vector<ARAAudioSourceRef> audioSourceRefs;
+        ScratchArray<ARAAudioSourceRef> audioSourceRefs;
         if (filter.second && (filter.first.audioSourceRefsCount > 0))
         {
-            audioSourceRefs.reserve (filter.first.audioSourceRefsCount);
+            audioSourceRefs = allocateScratchArray<ARAAudioSourceRef> (filter.first.audioSourceRefsCount);
             for (auto i { 0U }; i < filter.first.audioSourceRefsCount; ++i)
-                audioSourceRefs.emplace_back (fromRef (filter.first.audioSourceRefs[i])->plugInRef);
+                audioSourceRefs[i] = fromRef (filter.first.audioSourceRefs[i])->plugInRef;
 
             filter.first.audioSourceRefs = audioSourceRefs.data ();
         }
@@ -797,7 +1219,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAMusicalContextProperties properties;
         decodeArguments (decoder, controllerRef, hostRef, properties);
 
-        return encodeReply (replyEncoder, fromRef (controllerRef)->createMusicalContext (hostRef, &properties));
+        const auto musicalContextRef { fromRef (controllerRef)->createMusicalContext (hostRef, &properties) };
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
+        return encodeReply (replyEncoder, musicalContextRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateMusicalContextProperties))
     {
@@ -807,6 +1231,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, musicalContextRef, properties);
 
         fromRef (controllerRef)->updateMusicalContextProperties (musicalContextRef, &properties);
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateMusicalContextContent))
     {
@@ -817,6 +1242,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, musicalContextRef, range, flags);
 
         fromRef (controllerRef)->updateMusicalContextContent (musicalContextRef, (range.second) ? &range.first : nullptr, flags);
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyMusicalContext))
     {
@@ -825,6 +1251,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, musicalContextRef);
 
         fromRef (controllerRef)->destroyMusicalContext (musicalContextRef);
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
     }
 
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createRegionSequence))
@@ -834,7 +1261,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARARegionSequenceProperties properties;
         decodeArguments (decoder, controllerRef, hostRef, properties);
 
-        return encodeReply (replyEncoder, fromRef (controllerRef)->createRegionSequence (hostRef, &properties));
+        const auto regionSequenceRef { fromRef (controllerRef)->createRegionSequence (hostRef, &properties) };
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
+        return encodeReply (replyEncoder, regionSequenceRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateRegionSequenceProperties))
     {
@@ -844,6 +1273,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, regionSequenceRef, properties);
 
         fromRef (controllerRef)->updateRegionSequenceProperties (regionSequenceRef, &properties);
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyRegionSequence))
     {
@@ -852,6 +1282,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, regionSequenceRef);
 
         fromRef (controllerRef)->destroyRegionSequence (regionSequenceRef);
+        fromRef (controllerRef)->getDocumentMirror ()->didChangeAllPlaybackRegions ();
     }
 
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioSource))
@@ -864,6 +1295,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
 
         remoteAudioSource->channelCount = properties.channelCount;
         remoteAudioSource->plugInRef = fromRef (controllerRef)->createAudioSource (toHostRef (remoteAudioSource), &properties);
+        fromRef (controllerRef)->getDocumentMirror ()->didCreate (toRef (remoteAudioSource));
 
         return encodeReply (replyEncoder, ARAAudioSourceRef { toRef (remoteAudioSource) });
     }
@@ -875,6 +1307,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioSourceRef, properties);
 
         fromRef (controllerRef)->updateAudioSourceProperties (fromRef (audioSourceRef)->plugInRef, &properties);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioSourceRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateAudioSourceContent))
     {
@@ -885,6 +1318,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioSourceRef, range, flags);
 
         fromRef (controllerRef)->updateAudioSourceContent (fromRef (audioSourceRef)->plugInRef, (range.second) ? &range.first : nullptr, flags);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioSourceRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, enableAudioSourceSamplesAccess))
     {
@@ -894,6 +1328,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioSourceRef, enable);
 
         fromRef (controllerRef)->enableAudioSourceSamplesAccess (fromRef (audioSourceRef)->plugInRef, (enable) ? kARATrue : kARAFalse);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioSourceRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, deactivateAudioSourceForUndoHistory))
     {
@@ -903,6 +1338,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioSourceRef, deactivate);
 
         fromRef (controllerRef)->deactivateAudioSourceForUndoHistory (fromRef (audioSourceRef)->plugInRef, (deactivate) ? kARATrue : kARAFalse);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioSourceRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, storeAudioSourceToAudioFileChunk))
     {
@@ -931,10 +1367,11 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
     {
         ARADocumentControllerRef controllerRef;
         ARAAudioSourceRef audioSourceRef;
-        std::vector<ARAContentType> contentTypes;
+        ScratchArray<ARAContentType> contentTypes;
         decodeArguments (decoder, controllerRef, audioSourceRef, contentTypes);
 
         fromRef (controllerRef)->requestAudioSourceContentAnalysis (fromRef (audioSourceRef)->plugInRef, contentTypes.size (), contentTypes.data ());
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioSourceRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioSourceContentAvailable))
     {
@@ -962,9 +1399,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         OptionalArgument<ARAContentTimeRange> range;
         decodeArguments (decoder, controllerRef, audioSourceRef, contentType, range);
 
-        auto remoteContentReader { new RemoteContentReader };
-        remoteContentReader->plugInRef = fromRef (controllerRef)->createAudioSourceContentReader (fromRef (audioSourceRef)->plugInRef, contentType, (range.second) ? &range.first : nullptr);
-        remoteContentReader->contentType = contentType;
+        auto remoteContentReader { new RemoteContentReader { fromRef (controllerRef)->createAudioSourceContentReader (fromRef (audioSourceRef)->plugInRef, contentType, (range.second) ? &range.first : nullptr), contentType } };
         return encodeReply (replyEncoder, ARAContentReaderRef { toRef (remoteContentReader) });
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyAudioSource))
@@ -974,6 +1409,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioSourceRef);
 
         auto remoteAudioSource { fromRef (audioSourceRef) };
+        fromRef (controllerRef)->getDocumentMirror ()->willDestroy (audioSourceRef);
         fromRef (controllerRef)->destroyAudioSource (remoteAudioSource->plugInRef);
 
         delete remoteAudioSource;
@@ -987,7 +1423,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAAudioModificationProperties properties;
         decodeArguments (decoder, controllerRef, audioSourceRef, hostRef, properties);
 
-        return encodeReply (replyEncoder, fromRef (controllerRef)->createAudioModification (fromRef (audioSourceRef)->plugInRef, hostRef, &properties));
+        const auto audioModificationRef { fromRef (controllerRef)->createAudioModification (fromRef (audioSourceRef)->plugInRef, hostRef, &properties) };
+        fromRef (controllerRef)->getDocumentMirror ()->didCreate (audioModificationRef, hostRef, audioSourceRef);
+        return encodeReply (replyEncoder, audioModificationRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, cloneAudioModification))
     {
@@ -997,7 +1435,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAAudioModificationProperties properties;
         decodeArguments (decoder, controllerRef, audioModificationRef, hostRef, properties);
 
-        return encodeReply (replyEncoder, fromRef (controllerRef)->cloneAudioModification (audioModificationRef, hostRef, &properties));
+        const auto clonedAudioModificationRef { fromRef (controllerRef)->cloneAudioModification (audioModificationRef, hostRef, &properties) };
+        fromRef (controllerRef)->getDocumentMirror ()->didClone (clonedAudioModificationRef, hostRef, audioModificationRef);
+        return encodeReply (replyEncoder, clonedAudioModificationRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateAudioModificationProperties))
     {
@@ -1007,6 +1447,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioModificationRef, properties);
 
         fromRef (controllerRef)->updateAudioModificationProperties (audioModificationRef, &properties);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioModificationRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioModificationPreservingAudioSourceSignal))
     {
@@ -1024,6 +1465,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioModificationRef, deactivate);
 
         fromRef (controllerRef)->deactivateAudioModificationForUndoHistory (audioModificationRef, (deactivate) ? kARATrue : kARAFalse);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioModificationRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioModificationContentAvailable))
     {
@@ -1051,9 +1493,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         OptionalArgument<ARAContentTimeRange> range;
         decodeArguments (decoder, controllerRef, audioModificationRef, contentType, range);
 
-        auto remoteContentReader { new RemoteContentReader };
-        remoteContentReader->plugInRef = fromRef (controllerRef)->createAudioModificationContentReader (audioModificationRef, contentType, (range.second) ? &range.first : nullptr);
-        remoteContentReader->contentType = contentType;
+        auto remoteContentReader { new RemoteContentReader { fromRef (controllerRef)->createAudioModificationContentReader (audioModificationRef, contentType, (range.second) ? &range.first : nullptr), contentType } };
         return encodeReply (replyEncoder, ARAContentReaderRef { toRef (remoteContentReader) });
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyAudioModification))
@@ -1062,6 +1502,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAAudioModificationRef audioModificationRef;
         decodeArguments (decoder, controllerRef, audioModificationRef);
 
+        fromRef (controllerRef)->getDocumentMirror ()->willDestroy (audioModificationRef);
         fromRef (controllerRef)->destroyAudioModification (audioModificationRef);
     }
 
@@ -1073,7 +1514,9 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAPlaybackRegionProperties properties;
         decodeArguments (decoder, controllerRef, audioModificationRef, hostRef, properties);
 
-        return encodeReply (replyEncoder, fromRef (controllerRef)->createPlaybackRegion (audioModificationRef, hostRef, &properties));
+        const auto playbackRegionRef { fromRef (controllerRef)->createPlaybackRegion (audioModificationRef, hostRef, &properties) };
+        fromRef (controllerRef)->getDocumentMirror ()->didCreate (playbackRegionRef, hostRef, audioModificationRef);
+        return encodeReply (replyEncoder, playbackRegionRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updatePlaybackRegionProperties))
     {
@@ -1083,6 +1526,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, playbackRegionRef, properties);
 
         fromRef (controllerRef)->updatePlaybackRegionProperties (playbackRegionRef, &properties);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (playbackRegionRef);
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getPlaybackRegionHeadAndTailTime))
     {
@@ -1123,9 +1567,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         OptionalArgument<ARAContentTimeRange> range;
         decodeArguments (decoder, controllerRef, playbackRegionRef, contentType, range);
 
-        auto remoteContentReader { new RemoteContentReader };
-        remoteContentReader->plugInRef = fromRef (controllerRef)->createPlaybackRegionContentReader (playbackRegionRef, contentType, (range.second) ? &range.first : nullptr);
-        remoteContentReader->contentType = contentType;
+        auto remoteContentReader { new RemoteContentReader { fromRef (controllerRef)->createPlaybackRegionContentReader (playbackRegionRef, contentType, (range.second) ? &range.first : nullptr), contentType } };
         return encodeReply (replyEncoder, ARAContentReaderRef { toRef (remoteContentReader) });
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyPlaybackRegion))
@@ -1134,6 +1576,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAPlaybackRegionRef playbackRegionRef;
         decodeArguments (decoder, controllerRef, playbackRegionRef);
 
+        fromRef (controllerRef)->getDocumentMirror ()->willDestroy (playbackRegionRef);
         fromRef (controllerRef)->destroyPlaybackRegion (playbackRegionRef);
     }
 
@@ -1152,9 +1595,29 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         ARAInt32 eventIndex;
         decodeArguments (decoder, controllerRef, contentReaderRef, eventIndex);
 
+        auto documentController { fromRef (controllerRef) };
+        auto remoteContentReader { fromRef (contentReaderRef) };
+        const void* eventData { documentController->getContentReaderDataForEvent (remoteContentReader->plugInRef, eventIndex) };
+        const PODEncodingScope podEncodingScope { documentController->callbacksReceiverEndianessMatches () };
+        return remoteContentReader->encoder.encode (replyEncoder, eventData);
+    }
+    else if (messageID == kGetContentReaderDataForEventsMessageID)
+    {
+        ARADocumentControllerRef controllerRef;
+        ARAContentReaderRef contentReaderRef;
+        ARAInt32 firstEventIndex;
+        ARAInt32 eventCount;
+        decodeArguments (decoder, controllerRef, contentReaderRef, firstEventIndex, eventCount);
+        ARA_INTERNAL_ASSERT ((0 < eventCount) && (eventCount <= kContentReaderEventsBatchSize));
+
+        auto documentController { fromRef (controllerRef) };
         auto remoteContentReader { fromRef (contentReaderRef) };
-        const void* eventData { fromRef (controllerRef)->getContentReaderDataForEvent (remoteContentReader->plugInRef, eventIndex) };
-        return encodeContentEvent (replyEncoder, remoteContentReader->contentType, eventData);
+        const PODEncodingScope podEncodingScope { documentController->callbacksReceiverEndianessMatches () };
+        return remoteContentReader->encoder.encodeEvents (replyEncoder, firstEventIndex, eventCount,
+                    [documentController, remoteContentReader] (const ARAInt32 eventIndex) -> const void*
+                    {
+                        return documentController->getContentReaderDataForEvent (remoteContentReader->plugInRef, eventIndex);
+                    });
     }
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyContentReader))
     {
@@ -1199,13 +1662,14 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
         decodeArguments (decoder, controllerRef, audioSourceRef, algorithmIndex);
 
         fromRef (controllerRef)->requestProcessingAlgorithmForAudioSource (fromRef (audioSourceRef)->plugInRef, algorithmIndex);
+        fromRef (controllerRef)->getDocumentMirror ()->didChange (audioSourceRef);
     }
 
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isLicensedForCapabilities))
     {
         ARADocumentControllerRef controllerRef;
         ARABool runModalActivationDialogIfNeeded;
-        std::vector<ARAContentType> types;
+        ScratchArray<ARAContentType> types;
         ARAPlaybackTransformationFlags transformationFlags;
         decodeArguments (decoder, controllerRef, runModalActivationDialogIfNeeded, types, transformationFlags);
 
@@ -1277,7 +1741,7 @@ void ARAIPCProxyHostCommandHandler (const ARAIPCMessageID messageID, const ARAIP
     else if (messageID == ARA_IPC_PLUGIN_METHOD_ID (ARAEditorViewInterface, notifyHideRegionSequences))
     {
         ARAEditorViewRef editorViewRef;
-        std::vector<ARARegionSequenceRef> regionSequenceRefs;
+        ScratchArray<ARARegionSequenceRef> regionSequenceRefs;
         decodeArguments (decoder, editorViewRef, regionSequenceRefs);
 
         fromRef (editorViewRef)->getEditorView ()->notifyHideRegionSequences (regionSequenceRefs.size (), regionSequenceRefs.data ());
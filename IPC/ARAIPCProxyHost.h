@@ -37,6 +37,23 @@ void ARAIPCProxyHostAddFactory(const ARAFactory * factory);
 //! static configuration: set sender that the proxy host will use to perform callbacks received from the plug-in
 void ARAIPCProxyHostSetPlugInCallbacksSender(ARAIPCMessageSender plugInCallbacksSender);
 
+//! callback that the proxy host uses to obtain the sender for the plug-in callbacks of a newly created document controller
+//! It is called while handling the creation message, which allows for routing the callbacks of each document
+//! through a dedicated IPC connection or stream, typically the one on which the creation message was received.
+//! If the returned sender has no methods, the sender set via ARAIPCProxyHostSetPlugInCallbacksSender() will be used.
+typedef ARAIPCMessageSender (*ARAIPCPlugInCallbacksSenderProvider) (void);
+
+//! optional static configuration: set the callback to provide a sender per document controller
+void ARAIPCProxyHostSetPlugInCallbacksSenderProvider(ARAIPCPlugInCallbacksSenderProvider provider);
+
+//! optional static configuration: publish the plug-in state that the host frequently polls in shared memory
+//! This allows the proxy plug-in to answer queries such as isAudioSourceContentAvailable() or
+//! getPlaybackRegionHeadAndTailTime() without sending a message, see ARAIPCModelMirror.h.
+//! The capacity is the maximum count of audio sources, audio modifications and playback regions per document
+//! that are mirrored, 0 disables the mirror (the default). The mirror also is not used if the host does not
+//! provide a model update controller, or if shared memory is not available.
+void ARAIPCProxyHostSetModelMirrorCapacity(uint32_t capacity);
+
 //! static configuration: set the callback to execute the binding of Companion API plug-in instances to ARA document controllers
 void ARAIPCProxyHostSetBindingHandler(ARAIPCBindingHandler handler);
 
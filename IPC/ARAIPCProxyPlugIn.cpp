@@ -22,6 +22,7 @@
 #if ARA_ENABLE_IPC
 
 #include "ARA_Library/IPC/ARAIPCEncoding.h"
+#include "ARA_Library/IPC/ARAIPCModelMirror.h"
 #include "ARA_Library/Dispatch/ARAPlugInDispatch.h"
 #include "ARA_Library/Dispatch/ARAHostDispatch.h"
 
@@ -29,10 +30,13 @@
     #include "ARA_Library/Debug/ARAContentValidator.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 
 #if ARA_SUPPORT_VERSION_1
@@ -74,7 +78,11 @@ namespace ARA {
 namespace IPC {
 namespace ProxyPlugIn {
 
+struct MusicalContext;
+struct RegionSequence;
 struct AudioSource;
+struct AudioModification;
+struct PlaybackRegion;
 struct ContentReader;
 struct HostContentReader;
 struct HostAudioReader;
@@ -129,50 +137,231 @@ inline bool isValidInstance (const SubclassT* instance)
 
 /*******************************************************************************/
 
+// Copy of properties passed in by the host, which are only valid for the duration of the call.
+// The original structSize is retained so that the copy is encoded like the original, but unused
+// members beyond it are zeroed. Strings and other referenced data are stored separately and
+// only patched in by get (), so that the copies can be moved freely.
+
+template<typename StructType>
+class PropertiesCopy
+{
+public:
+    PropertiesCopy (const StructType* properties)
+    {
+        store (properties);
+    }
+
+    void store (const StructType* properties)
+    {
+        std::memset (&_properties, 0, sizeof (_properties));
+        std::memcpy (&_properties, properties, std::min (static_cast<size_t> (properties->structSize), sizeof (_properties)));
+        _storeReferencedData (_properties);
+    }
+
+    StructType get () const noexcept
+    {
+        auto result { _properties };
+        _patchReferencedData (result);
+        return result;
+    }
+
+private:
+    struct OptionalString
+    {
+        void store (ARAUtf8String string) { isValid = (string != nullptr); value = (isValid) ? string : ""; }
+        ARAUtf8String get () const noexcept { return (isValid) ? value.c_str () : nullptr; }
+
+        bool isValid { false };
+        std::string value;
+    };
+
+    struct OptionalColor
+    {
+        void store (const ARAColor* color) noexcept { isValid = (color != nullptr); if (isValid) value = *color; }
+        const ARAColor* get () const noexcept { return (isValid) ? &value : nullptr; }
+
+        bool isValid { false };
+        ARAColor value {};
+    };
+
+    void _storeReferencedData (const ARADocumentProperties& properties) { _name.store (properties.name); }
+    void _patchReferencedData (ARADocumentProperties& properties) const noexcept { properties.name = _name.get (); }
+
+    void _storeReferencedData (const ARAMusicalContextProperties& properties) { _name.store (properties.name); _color.store (properties.color); }
+    void _patchReferencedData (ARAMusicalContextProperties& properties) const noexcept { properties.name = _name.get (); properties.color = _color.get (); }
+
+    void _storeReferencedData (const ARARegionSequenceProperties& properties) { _name.store (properties.name); _color.store (properties.color); }
+    void _patchReferencedData (ARARegionSequenceProperties& properties) const noexcept { properties.name = _name.get (); properties.color = _color.get (); }
+
+    void _storeReferencedData (const ARAAudioSourceProperties& properties)
+    {
+        _name.store (properties.name);
+        _persistentID.store (properties.persistentID);
+        const ChannelArrangement channelArrangement { properties.channelArrangementDataType, properties.channelArrangement };
+        const auto channelArrangementBytes { static_cast<const ARAByte*> (properties.channelArrangement) };
+        _channelArrangement.assign (channelArrangementBytes, channelArrangementBytes + channelArrangement.getDataSize ());
+    }
+    void _patchReferencedData (ARAAudioSourceProperties& properties) const noexcept
+    {
+        properties.name = _name.get ();
+        properties.persistentID = _persistentID.get ();
+        properties.channelArrangement = (_channelArrangement.empty ()) ? nullptr : _channelArrangement.data ();
+    }
+
+    void _storeReferencedData (const ARAAudioModificationProperties& properties) { _name.store (properties.name); _persistentID.store (properties.persistentID); }
+    void _patchReferencedData (ARAAudioModificationProperties& properties) const noexcept { properties.name = _name.get (); properties.persistentID = _persistentID.get (); }
+
+    void _storeReferencedData (const ARAPlaybackRegionProperties& properties) { _name.store (properties.name); _color.store (properties.color); }
+    void _patchReferencedData (ARAPlaybackRegionProperties& properties) const noexcept { properties.name = _name.get (); properties.color = _color.get (); }
+
+private:
+    StructType _properties;
+    OptionalString _name;
+    OptionalString _persistentID;
+    OptionalColor _color;
+    std::vector<ARAByte> _channelArrangement;
+};
+
+
+/*******************************************************************************/
+// Proxies for the plug-in model objects.
+// In addition to mapping to the remote objects, they record the properties and state that the
+// host has established, so that the objects can be re-created if the remote process needs to be
+// replaced, see DocumentController::recoverRemoteDocument ().
+
+struct MusicalContext
+#if ARA_VALIDATE_API_CALLS
+                      : public InstanceValidator<MusicalContext>
+#endif
+{
+    MusicalContext (ARAMusicalContextHostRef hostRef_, const ARAMusicalContextProperties* properties_)
+    : hostRef { hostRef_ }, properties { properties_ }
+    {}
+
+    ARAMusicalContextHostRef hostRef;
+    ARAMusicalContextRef remoteRef {};
+    PropertiesCopy<ARAMusicalContextProperties> properties;
+};
+ARA_MAP_REF (MusicalContext, ARAMusicalContextRef)
+
+struct RegionSequence
+#if ARA_VALIDATE_API_CALLS
+                      : public InstanceValidator<RegionSequence>
+#endif
+{
+    RegionSequence (ARARegionSequenceHostRef hostRef_, const ARARegionSequenceProperties* properties_)
+    : hostRef { hostRef_ }, properties { properties_ }
+    {}
+
+    ARARegionSequenceHostRef hostRef;
+    ARARegionSequenceRef remoteRef {};
+    PropertiesCopy<ARARegionSequenceProperties> properties;     // refs are not yet translated
+};
+ARA_MAP_REF (RegionSequence, ARARegionSequenceRef)
+
 struct AudioSource
 #if ARA_VALIDATE_API_CALLS
                   : public InstanceValidator<AudioSource>
 #endif
 {
+    AudioSource (ARAAudioSourceHostRef hostRef_, const ARAAudioSourceProperties* properties_)
+    : hostRef { hostRef_ }, channelCount { properties_->channelCount },
 #if ARA_VALIDATE_API_CALLS
-    AudioSource (ARAAudioSourceHostRef hostRef_, ARAAudioSourceRef remoteRef_, ARAChannelCount channelCount_,
-                 ARASampleCount sampleCount_, ARASampleRate sampleRate_)
-    : hostRef { hostRef_ }, remoteRef { remoteRef_ }, channelCount { channelCount_ },
-      sampleCount { sampleCount_ }, sampleRate { sampleRate_ }
-    {}
+      sampleCount { properties_->sampleCount }, sampleRate { properties_->sampleRate },
 #endif
+      properties { properties_ }
+    {}
 
     ARAAudioSourceHostRef hostRef;
-    ARAAudioSourceRef remoteRef;
+    ARAAudioSourceRef remoteRef {};
     ARAChannelCount channelCount;
 #if ARA_VALIDATE_API_CALLS
     ARASampleCount sampleCount;
     ARASampleRate sampleRate;
 #endif
+    PropertiesCopy<ARAAudioSourceProperties> properties;
+    bool isSamplesAccessEnabled { false };
+    bool isDeactivatedForUndoHistory { false };
+    ARAInt32 requestedProcessingAlgorithm { -1 };   // -1 if not requested
 };
 ARA_MAP_REF (AudioSource, ARAAudioSourceRef)
 ARA_MAP_HOST_REF (AudioSource, ARAAudioSourceHostRef)
 
-struct ContentReader
+struct AudioModification
 #if ARA_VALIDATE_API_CALLS
-                     : public InstanceValidator<ContentReader>
+                        : public InstanceValidator<AudioModification>
 #endif
 {
+    AudioModification (AudioSource* audioSource_, ARAAudioModificationHostRef hostRef_, const ARAAudioModificationProperties* properties_)
+    : audioSource { audioSource_ }, hostRef { hostRef_ }, properties { properties_ }
+    {}
+
+    AudioSource* audioSource;
+    ARAAudioModificationHostRef hostRef;
+    ARAAudioModificationRef remoteRef {};
+    PropertiesCopy<ARAAudioModificationProperties> properties;
+    bool isDeactivatedForUndoHistory { false };
+};
+ARA_MAP_REF (AudioModification, ARAAudioModificationRef)
+
+struct PlaybackRegion
 #if ARA_VALIDATE_API_CALLS
-    ContentReader (ARAContentReaderRef remoteRef_, ARAContentType type_)
-    : remoteRef { remoteRef_ }, decoder { type_ }
+                      : public InstanceValidator<PlaybackRegion>
+#endif
+{
+    PlaybackRegion (AudioModification* audioModification_, ARAPlaybackRegionHostRef hostRef_, const ARAPlaybackRegionProperties* properties_)
+    : audioModification { audioModification_ }, hostRef { hostRef_ }, properties { properties_ }
     {}
+
+    AudioModification* audioModification;
+    ARAPlaybackRegionHostRef hostRef;
+    ARAPlaybackRegionRef remoteRef {};
+    PropertiesCopy<ARAPlaybackRegionProperties> properties;     // refs are not yet translated
+};
+ARA_MAP_REF (PlaybackRegion, ARAPlaybackRegionRef)
+
+// properties with all contained object refs translated to their remote counterparts
+inline ARARegionSequenceProperties getRemoteProperties (const PropertiesCopy<ARARegionSequenceProperties>& properties) noexcept
+{
+    auto result { properties.get () };
+    result.musicalContextRef = fromRef (result.musicalContextRef)->remoteRef;
+    return result;
+}
+
+inline ARAPlaybackRegionProperties getRemoteProperties (const PropertiesCopy<ARAPlaybackRegionProperties>& properties) noexcept
+{
+    auto result { properties.get () };
+    if (result.musicalContextRef != nullptr)
+        result.musicalContextRef = fromRef (result.musicalContextRef)->remoteRef;
+    if (result.regionSequenceRef != nullptr)
+        result.regionSequenceRef = fromRef (result.regionSequenceRef)->remoteRef;
+    return result;
+}
+
+struct ContentReader
+#if ARA_VALIDATE_API_CALLS
+                     : public InstanceValidator<ContentReader>
 #endif
+{
+    ContentReader (ARAContentReaderRef remoteRef_, ARAContentType type_, uint32_t remoteGeneration_)
+    : remoteRef { remoteRef_ }, decoder { type_ }, remoteGeneration { remoteGeneration_ }
+    {}
 
     ARAContentReaderRef remoteRef;
     ContentEventDecoder decoder;
+    uint32_t remoteGeneration;      // the reader is lost if the remote process has been replaced since creating it
+    ARAInt32 eventCount { -1 };     // -1 until queried
 };
 ARA_MAP_REF (ContentReader, ARAContentReaderRef)
 
 struct HostContentReader
 {
+    HostContentReader (ARAContentReaderHostRef hostRef_, ARAContentType type_)
+    : hostRef { hostRef_ }, encoder { type_ }
+    {}
+
     ARAContentReaderHostRef hostRef;
-    ARAContentType contentType;
+    ContentEventEncoder encoder;
 };
 ARA_MAP_HOST_REF (HostContentReader, ARAContentReaderHostRef)
 
@@ -185,6 +374,17 @@ struct HostAudioReader
 ARA_MAP_HOST_REF (HostAudioReader, ARAAudioReaderHostRef)
 
 
+/*******************************************************************************/
+// copy of the last archive of the entire document, restored when replacing the remote process
+
+struct ReplayArchive
+{
+    std::vector<ARAByte> bytes;
+    std::string documentArchiveID;
+};
+ARA_MAP_HOST_REF (ReplayArchive, ARAArchiveReaderHostRef)
+
+
 /*******************************************************************************/
 // Implementation of DocumentControllerInterface that channels all calls through IPC
 
@@ -281,6 +481,21 @@ public:
     // Accessors for Proxy
     const ARADocumentControllerInstance* getInstance () const noexcept { return &_instance; }
     ARADocumentControllerRef getRemoteRef () const noexcept { return _remoteRef; }
+    using RemoteCaller::receiverEndianessMatches;
+    using RemoteCaller::isRemoteConnected;
+
+    // Crash recovery: re-create the remote document on the given sender, see ARAIPCProxyPlugInRecoverDocumentController ()
+    bool recoverRemoteDocument (ARAIPCMessageSender sender) noexcept;
+    uint32_t getRemoteGeneration () const noexcept { return _remoteGeneration; }
+
+    // hooks for the callbacks dispatcher to maintain the replay archive
+    void didWriteBytesToArchive (ARAArchiveWriterHostRef archiveWriterHostRef, ARASize position, const std::vector<ARAByte>& bytes) noexcept;
+    const ReplayArchive* getReplayArchive (ARAArchiveReaderHostRef archiveReaderHostRef) const noexcept
+    {
+        return (_isReplayingArchive && (archiveReaderHostRef == toHostRef (&_replayArchive))) ? &_replayArchive : nullptr;
+    }
+    // the host is not aware of the replay, so it must not receive any related progress notifications
+    bool isReplayingArchive () const noexcept { return _isReplayingArchive; }
 
     // Host Interface Access
     PlugIn::HostAudioAccessController* getHostAudioAccessController () noexcept { return &_hostAudioAccessController; }
@@ -292,6 +507,17 @@ public:
 private:
     void destroyIfUnreferenced () noexcept;
 
+    bool createRemoteDocumentController () noexcept;
+    void openModelMirror () noexcept;
+    void storeReplayArchive (ARAArchiveReaderHostRef archiveReaderHostRef) noexcept;
+
+    // read the state published by the proxy host, if available - otherwise the query must be sent
+    template<typename RefT>
+    bool readMirroredState (ModelMirror::ObjectKind kind, RefT remoteRef, ModelMirror::ObjectState& state) const noexcept
+    {
+        return _modelMirror && _modelMirror->read (kind, ModelMirror::getKey (remoteRef), state);
+    }
+
     friend class PlugInExtension;
     void addPlugInExtension (PlugInExtension* plugInExtension) noexcept { _plugInExtensions.insert (plugInExtension); }
     void removePlugInExtension (PlugInExtension* plugInExtension) noexcept { _plugInExtensions.erase (plugInExtension); if (_plugInExtensions.empty ()) destroyIfUnreferenced (); }
@@ -307,7 +533,26 @@ private:
 
     PlugIn::DocumentControllerInstance _instance;
 
-    ARADocumentControllerRef _remoteRef;
+    ARADocumentControllerRef _remoteRef {};
+    uint32_t _remoteGeneration { 0 };
+
+    std::unique_ptr<ModelMirrorReader> _modelMirror;
+
+    // replay log: all current objects and their state as established by the host
+    PropertiesCopy<ARADocumentProperties> _documentProperties;
+    std::set<MusicalContext*> _musicalContexts;
+    std::set<RegionSequence*> _regionSequences;
+    std::set<AudioSource*> _audioSources;
+    std::set<AudioModification*> _audioModifications;
+    std::set<PlaybackRegion*> _playbackRegions;
+
+    ReplayArchive _replayArchive;
+    bool _isReplayingArchive { false };
+    bool _isCapturingArchive { false };
+    ARAArchiveWriterHostRef _capturedArchiveWriterHostRef {};
+    std::vector<ARAByte> _capturedArchiveBytes;
+
+    bool _isEditing { false };
 
     bool _hasBeenDestroyed { false };
 
@@ -336,21 +581,48 @@ DocumentController::DocumentController (ARAIPCMessageSender sender, const ARAFac
   _hostContentAccessController { instance },
   _hostModelUpdateController { instance },
   _hostPlaybackController { instance },
-  _instance { this }
+  _instance { this },
+  _documentProperties { properties }
+{
+    createRemoteDocumentController ();
+    openModelMirror ();
+
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create document controller", _remoteRef);
+}
+
+bool DocumentController::createRemoteDocumentController () noexcept
 {
     ARAAudioAccessControllerHostRef audioAccessControllerHostRef { toHostRef (this) };
     ARAArchivingControllerHostRef archivingControllerHostRef { toHostRef (this) };
     ARAContentAccessControllerHostRef contentAccessControllerHostRef { toHostRef (this) };
     ARAModelUpdateControllerHostRef modelUpdateControllerHostRef { toHostRef (this) };
     ARAPlaybackControllerHostRef playbackControllerHostRef { toHostRef (this) };
-    remoteCallWithReply (_remoteRef, false, kCreateDocumentControllerMessageID, _factory->factoryID,
-                          audioAccessControllerHostRef, archivingControllerHostRef,
-                          (_hostContentAccessController.isProvided ()) ? kARATrue : kARAFalse, contentAccessControllerHostRef,
-                          (_hostModelUpdateController.isProvided ()) ? kARATrue : kARAFalse, modelUpdateControllerHostRef,
-                          (_hostPlaybackController.isProvided ()) ? kARATrue : kARAFalse, playbackControllerHostRef,
-                          properties);
+    return remoteCallWithReply (_remoteRef, false, kCreateDocumentControllerMessageID, _factory->factoryID,
+                                audioAccessControllerHostRef, archivingControllerHostRef,
+                                (_hostContentAccessController.isProvided ()) ? kARATrue : kARAFalse, contentAccessControllerHostRef,
+                                (_hostModelUpdateController.isProvided ()) ? kARATrue : kARAFalse, modelUpdateControllerHostRef,
+                                (_hostPlaybackController.isProvided ()) ? kARATrue : kARAFalse, playbackControllerHostRef,
+                                _documentProperties.get ());
+}
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create document controller", _remoteRef);
+void DocumentController::openModelMirror () noexcept
+{
+    _modelMirror.reset ();
+
+    // the proxy host can only track changes of the plug-in state if it receives model update notifications
+    if (!_hostModelUpdateController.isProvided ())
+        return;
+
+    std::string modelMirrorName;
+    RemoteCaller::CustomDecodeFunction customDecode { [&modelMirrorName] (const ARAIPCMessageDecoder& decoder) -> void
+        {
+            const char* name;
+            if (decodeReply (name, decoder))
+                modelMirrorName = name;
+        } };
+    remoteCallWithReply (customDecode, false, kGetModelMirrorMessageID, _remoteRef);
+    if (!modelMirrorName.empty ())
+        _modelMirror.reset (ModelMirrorReader::open (modelMirrorName.c_str ()));
 }
 
 void DocumentController::destroyDocumentController () noexcept
@@ -396,6 +668,7 @@ void DocumentController::beginEditing () noexcept
     ARA_LOG_HOST_ENTRY (this);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
 
+    _isEditing = true;
     remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, beginEditing), _remoteRef);
 }
 
@@ -405,6 +678,7 @@ void DocumentController::endEditing () noexcept
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
 
     remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, endEditing), _remoteRef);
+    _isEditing = false;
 }
 
 void DocumentController::notifyModelUpdates () noexcept
@@ -434,6 +708,11 @@ bool DocumentController::restoreObjectsFromArchive (ARAArchiveReaderHostRef arch
 
     ARABool success;
     remoteCallWithReply (success, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, restoreObjectsFromArchive), _remoteRef, archiveReaderHostRef, filter);
+
+    // the entire document has been restored, so its archive is a suitable starting point for a replay
+    if ((success != kARAFalse) && (filter == nullptr))
+        storeReplayArchive (archiveReaderHostRef);
+
     return (success != kARAFalse);
 }
 
@@ -442,22 +721,68 @@ bool DocumentController::storeObjectsToArchive (ARAArchiveWriterHostRef archiveW
     ARA_LOG_HOST_ENTRY (this);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
 
+    // the host filters by the refs of our wrapper objects, which must be translated to the remote refs
     ARAStoreObjectsFilter tempFilter;
     std::vector<ARAAudioSourceRef> remoteAudioSourceRefs;
-    if ((filter != nullptr) && (filter->audioSourceRefsCount > 0))
+    std::vector<ARAAudioModificationRef> remoteAudioModificationRefs;
+    if ((filter != nullptr) && ((filter->audioSourceRefsCount > 0) || (filter->audioModificationRefsCount > 0)))
     {
         remoteAudioSourceRefs.reserve (filter->audioSourceRefsCount);
         for (auto i { 0U }; i < filter->audioSourceRefsCount; ++i)
             remoteAudioSourceRefs.emplace_back (fromRef (filter->audioSourceRefs[i])->remoteRef);
 
+        remoteAudioModificationRefs.reserve (filter->audioModificationRefsCount);
+        for (auto i { 0U }; i < filter->audioModificationRefsCount; ++i)
+            remoteAudioModificationRefs.emplace_back (fromRef (filter->audioModificationRefs[i])->remoteRef);
+
         tempFilter = *filter;
         tempFilter.audioSourceRefs = remoteAudioSourceRefs.data ();
+        tempFilter.audioModificationRefs = remoteAudioModificationRefs.data ();
         filter = &tempFilter;
     }
 
+    // when storing the entire document, keep a copy of the archive for replaying it if needed
+    _isCapturingArchive = (filter == nullptr);
+    _capturedArchiveWriterHostRef = archiveWriterHostRef;
+    _capturedArchiveBytes.clear ();
+
     ARABool success;
     remoteCallWithReply (success, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, storeObjectsToArchive), _remoteRef, archiveWriterHostRef, filter);
-    return (success!= kARAFalse);
+
+    if ((success != kARAFalse) && _isCapturingArchive)
+    {
+        _replayArchive.bytes.swap (_capturedArchiveBytes);
+        _replayArchive.documentArchiveID = _factory->documentArchiveID;
+    }
+    _isCapturingArchive = false;
+    _capturedArchiveBytes.clear ();
+
+    return (success != kARAFalse);
+}
+
+void DocumentController::didWriteBytesToArchive (ARAArchiveWriterHostRef archiveWriterHostRef, ARASize position, const std::vector<ARAByte>& bytes) noexcept
+{
+    if (!_isCapturingArchive || (archiveWriterHostRef != _capturedArchiveWriterHostRef))
+        return;
+
+    if (_capturedArchiveBytes.size () < position + bytes.size ())
+        _capturedArchiveBytes.resize (position + bytes.size ());
+    std::memcpy (_capturedArchiveBytes.data () + position, bytes.data (), bytes.size ());
+}
+
+void DocumentController::storeReplayArchive (ARAArchiveReaderHostRef archiveReaderHostRef) noexcept
+{
+    const auto archiveSize { _hostArchivingController.getArchiveSize (archiveReaderHostRef) };
+    _replayArchive.bytes.resize (archiveSize);
+    if ((archiveSize == 0) || !_hostArchivingController.readBytesFromArchive (archiveReaderHostRef, 0, archiveSize, _replayArchive.bytes.data ()))
+    {
+        _replayArchive.bytes.clear ();
+        _replayArchive.documentArchiveID.clear ();
+        return;
+    }
+
+    const auto documentArchiveID { _hostArchivingController.getDocumentArchiveID (archiveReaderHostRef) };
+    _replayArchive.documentArchiveID = (documentArchiveID != nullptr) ? documentArchiveID : _factory->documentArchiveID;
 }
 
 bool DocumentController::storeAudioSourceToAudioFileChunk (ARAArchiveWriterHostRef archiveWriterHostRef, ARAAudioSourceRef audioSourceRef, ARAPersistentID* documentArchiveID, bool* openAutomatically) noexcept
@@ -508,6 +833,7 @@ void DocumentController::updateDocumentProperties (PropertiesPtr<ARADocumentProp
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARADocumentProperties);
 
+    _documentProperties.store (properties);
     remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateDocumentProperties), _remoteRef, *properties);
 }
 
@@ -519,37 +845,47 @@ ARAMusicalContextRef DocumentController::createMusicalContext (ARAMusicalContext
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAMusicalContextProperties);
 
-    ARAMusicalContextRef musicalContextRef;
-    remoteCallWithReply (musicalContextRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createMusicalContext), _remoteRef, hostRef, *properties);
+    auto musicalContext { new MusicalContext { hostRef, properties } };
+    remoteCallWithReply (musicalContext->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createMusicalContext), _remoteRef, hostRef, *properties);
+    _musicalContexts.insert (musicalContext);
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create musical context", musicalContextRef);
-    return musicalContextRef;
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create musical context", musicalContext->remoteRef);
+    return toRef (musicalContext);
 }
 
 void DocumentController::updateMusicalContextProperties (ARAMusicalContextRef musicalContextRef, PropertiesPtr<ARAMusicalContextProperties> properties) noexcept
 {
     ARA_LOG_HOST_ENTRY (musicalContextRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    auto musicalContext { fromRef (musicalContextRef) };
+    ARA_VALIDATE_API_ARGUMENT (musicalContext, isValidInstance (musicalContext));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAMusicalContextProperties);
 
-    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateMusicalContextProperties), _remoteRef, musicalContextRef, *properties);
+    musicalContext->properties.store (properties);
+    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateMusicalContextProperties), _remoteRef, musicalContext->remoteRef, *properties);
 }
 
 void DocumentController::updateMusicalContextContent (ARAMusicalContextRef musicalContextRef, const ARAContentTimeRange* range, ContentUpdateScopes flags) noexcept
 {
     ARA_LOG_HOST_ENTRY (musicalContextRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto musicalContext { fromRef (musicalContextRef) };
+    ARA_VALIDATE_API_ARGUMENT (musicalContext, isValidInstance (musicalContext));
 
-    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateMusicalContextContent), _remoteRef, musicalContextRef, range, flags);
+    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateMusicalContextContent), _remoteRef, musicalContext->remoteRef, range, flags);
 }
 
 void DocumentController::destroyMusicalContext (ARAMusicalContextRef musicalContextRef) noexcept
 {
     ARA_LOG_HOST_ENTRY (musicalContextRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto musicalContext { fromRef (musicalContextRef) };
+    ARA_VALIDATE_API_ARGUMENT (musicalContext, isValidInstance (musicalContext));
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy musical context", musicalContextRef);
-    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyMusicalContext), _remoteRef, musicalContextRef);
+    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy musical context", musicalContext->remoteRef);
+    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyMusicalContext), _remoteRef, musicalContext->remoteRef);
+    _musicalContexts.erase (musicalContext);
+    delete musicalContext;
 }
 
 /*******************************************************************************/
@@ -560,29 +896,39 @@ ARARegionSequenceRef DocumentController::createRegionSequence (ARARegionSequence
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARARegionSequenceProperties);
 
-    ARARegionSequenceRef regionSequenceRef;
-    remoteCallWithReply (regionSequenceRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createRegionSequence), _remoteRef, hostRef, *properties);
+    auto regionSequence { new RegionSequence { hostRef, properties } };
+    remoteCallWithReply (regionSequence->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createRegionSequence),
+                        _remoteRef, hostRef, getRemoteProperties (regionSequence->properties));
+    _regionSequences.insert (regionSequence);
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create region sequence", regionSequenceRef);
-    return regionSequenceRef;
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create region sequence", regionSequence->remoteRef);
+    return toRef (regionSequence);
 }
 
 void DocumentController::updateRegionSequenceProperties (ARARegionSequenceRef regionSequenceRef, PropertiesPtr<ARARegionSequenceProperties> properties) noexcept
 {
     ARA_LOG_HOST_ENTRY (regionSequenceRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    auto regionSequence { fromRef (regionSequenceRef) };
+    ARA_VALIDATE_API_ARGUMENT (regionSequence, isValidInstance (regionSequence));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARARegionSequenceProperties);
 
-    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateRegionSequenceProperties), _remoteRef, regionSequenceRef, *properties);
+    regionSequence->properties.store (properties);
+    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateRegionSequenceProperties),
+                            _remoteRef, regionSequence->remoteRef, getRemoteProperties (regionSequence->properties));
 }
 
 void DocumentController::destroyRegionSequence (ARARegionSequenceRef regionSequenceRef) noexcept
 {
     ARA_LOG_HOST_ENTRY (regionSequenceRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto regionSequence { fromRef (regionSequenceRef) };
+    ARA_VALIDATE_API_ARGUMENT (regionSequence, isValidInstance (regionSequence));
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy region sequence", regionSequenceRef);
-    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyRegionSequence), _remoteRef, regionSequenceRef);
+    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy region sequence", regionSequence->remoteRef);
+    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyRegionSequence), _remoteRef, regionSequence->remoteRef);
+    _regionSequences.erase (regionSequence);
+    delete regionSequence;
 }
 
 /*******************************************************************************/
@@ -593,16 +939,12 @@ ARAAudioSourceRef DocumentController::createAudioSource (ARAAudioSourceHostRef h
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioSourceProperties);
 
-    auto audioSource { new AudioSource { hostRef, nullptr, properties->channelCount
-#if ARA_VALIDATE_API_CALLS
-                                                , properties->sampleCount, properties->sampleRate
-#endif
-                                        } };
-
+    auto audioSource { new AudioSource { hostRef, properties } };
     remoteCallWithReply (audioSource->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioSource),
                         _remoteRef, ARAAudioSourceHostRef { toHostRef (audioSource) }, *properties);
+    _audioSources.insert (audioSource);
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create audio source", audioSourceRef);
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create audio source", audioSource->remoteRef);
     return toRef (audioSource);
 }
 
@@ -614,6 +956,7 @@ void DocumentController::updateAudioSourceProperties (ARAAudioSourceRef audioSou
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioSourceProperties);
 
+    audioSource->properties.store (properties);
     remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateAudioSourceProperties), _remoteRef, audioSource->remoteRef, *properties);
 }
 
@@ -634,6 +977,7 @@ void DocumentController::enableAudioSourceSamplesAccess (ARAAudioSourceRef audio
     const auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
 
+    audioSource->isSamplesAccessEnabled = enable;
     remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, enableAudioSourceSamplesAccess), _remoteRef, audioSource->remoteRef, (enable) ? kARATrue : kARAFalse);
 }
 
@@ -644,6 +988,7 @@ void DocumentController::deactivateAudioSourceForUndoHistory (ARAAudioSourceRef
     const auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
 
+    audioSource->isDeactivatedForUndoHistory = deactivate;
     remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, deactivateAudioSourceForUndoHistory), _remoteRef, audioSource->remoteRef, (deactivate) ? kARATrue : kARAFalse);
 }
 
@@ -656,6 +1001,7 @@ void DocumentController::destroyAudioSource (ARAAudioSourceRef audioSourceRef) n
 
     ARA_LOG_MODELOBJECT_LIFETIME ("will destroy audio source", audioSource->remoteRef);
     remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyAudioSource), _remoteRef, audioSource->remoteRef);
+    _audioSources.erase (audioSource);
     delete audioSource;
 }
 
@@ -669,44 +1015,58 @@ ARAAudioModificationRef DocumentController::createAudioModification (ARAAudioSou
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioModificationProperties);
 
-    ARAAudioModificationRef audioModificationRef;
-    remoteCallWithReply (audioModificationRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioModification),
+    auto audioModification { new AudioModification { audioSource, hostRef, properties } };
+    remoteCallWithReply (audioModification->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioModification),
                         _remoteRef, audioSource->remoteRef, hostRef, *properties);
+    _audioModifications.insert (audioModification);
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create audio modification", audioModificationRef);
-    return audioModificationRef;
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create audio modification", audioModification->remoteRef);
+    return toRef (audioModification);
 }
 
 ARAAudioModificationRef DocumentController::cloneAudioModification (ARAAudioModificationRef srcAudioModificationRef, ARAAudioModificationHostRef hostRef, PropertiesPtr<ARAAudioModificationProperties> properties) noexcept
 {
     ARA_LOG_HOST_ENTRY (srcAudioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto srcAudioModification { fromRef (srcAudioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (srcAudioModification, isValidInstance (srcAudioModification));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioModificationProperties);
 
-    ARAAudioModificationRef clonedAudioModificationRef;
-    remoteCallWithReply (clonedAudioModificationRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, cloneAudioModification),
-                        _remoteRef, srcAudioModificationRef, hostRef, *properties);
+    // when replaying, the clone is created like any other modification, its state is then restored from the archive
+    auto clonedAudioModification { new AudioModification { srcAudioModification->audioSource, hostRef, properties } };
+    remoteCallWithReply (clonedAudioModification->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, cloneAudioModification),
+                        _remoteRef, srcAudioModification->remoteRef, hostRef, *properties);
+    _audioModifications.insert (clonedAudioModification);
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create cloned audio modification", clonedAudioModificationRef);
-    return clonedAudioModificationRef;
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create cloned audio modification", clonedAudioModification->remoteRef);
+    return toRef (clonedAudioModification);
 }
 
 void DocumentController::updateAudioModificationProperties (ARAAudioModificationRef audioModificationRef, PropertiesPtr<ARAAudioModificationProperties> properties) noexcept
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioModificationProperties);
 
-    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateAudioModificationProperties), _remoteRef, audioModificationRef, *properties);
+    audioModification->properties.store (properties);
+    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updateAudioModificationProperties), _remoteRef, audioModification->remoteRef, *properties);
 }
 
 bool DocumentController::isAudioModificationPreservingAudioSourceSignal (ARAAudioModificationRef audioModificationRef) noexcept
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
+
+    ModelMirror::ObjectState state;
+    if (readMirroredState (ModelMirror::ObjectKind::audioModification, audioModification->remoteRef, state))
+        return state.preservesAudioSourceSignal;
 
     ARABool result;
-    remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioModificationPreservingAudioSourceSignal), _remoteRef, audioModificationRef);
+    remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioModificationPreservingAudioSourceSignal), _remoteRef, audioModification->remoteRef);
     return (result != kARAFalse);
 }
 
@@ -714,17 +1074,24 @@ void DocumentController::deactivateAudioModificationForUndoHistory (ARAAudioModi
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
 
-    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, deactivateAudioModificationForUndoHistory), _remoteRef, audioModificationRef, (deactivate) ? kARATrue : kARAFalse);
+    audioModification->isDeactivatedForUndoHistory = deactivate;
+    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, deactivateAudioModificationForUndoHistory), _remoteRef, audioModification->remoteRef, (deactivate) ? kARATrue : kARAFalse);
 }
 
 void DocumentController::destroyAudioModification (ARAAudioModificationRef audioModificationRef) noexcept
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy audio modification", audioModification);
-    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyAudioModification), _remoteRef, audioModificationRef);
+    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy audio modification", audioModification->remoteRef);
+    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyAudioModification), _remoteRef, audioModification->remoteRef);
+    _audioModifications.erase (audioModification);
+    delete audioModification;
 }
 
 /*******************************************************************************/
@@ -733,35 +1100,54 @@ ARAPlaybackRegionRef DocumentController::createPlaybackRegion (ARAAudioModificat
 {
     ARA_LOG_HOST_ENTRY (this);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAPlaybackRegionProperties);
 
-    ARAPlaybackRegionRef playbackRegionRef;
-    remoteCallWithReply (playbackRegionRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createPlaybackRegion),
-                        _remoteRef, audioModificationRef, hostRef, *properties);
+    auto playbackRegion { new PlaybackRegion { audioModification, hostRef, properties } };
+    remoteCallWithReply (playbackRegion->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createPlaybackRegion),
+                        _remoteRef, audioModification->remoteRef, hostRef, getRemoteProperties (playbackRegion->properties));
+    _playbackRegions.insert (playbackRegion);
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("did create playback region", playbackRegionRef);
-    return playbackRegionRef;
+    ARA_LOG_MODELOBJECT_LIFETIME ("did create playback region", playbackRegion->remoteRef);
+    return toRef (playbackRegion);
 }
 
 void DocumentController::updatePlaybackRegionProperties (ARAPlaybackRegionRef playbackRegionRef, PropertiesPtr<ARAPlaybackRegionProperties> properties) noexcept
 {
     ARA_LOG_HOST_ENTRY (playbackRegionRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    auto playbackRegion { fromRef (playbackRegionRef) };
+    ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAPlaybackRegionProperties);
 
-    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updatePlaybackRegionProperties), _remoteRef, playbackRegionRef, *properties);
+    playbackRegion->properties.store (properties);
+    remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, updatePlaybackRegionProperties),
+                            _remoteRef, playbackRegion->remoteRef, getRemoteProperties (playbackRegion->properties));
 }
 
 void DocumentController::getPlaybackRegionHeadAndTailTime (ARAPlaybackRegionRef playbackRegionRef, ARATimeDuration* headTime, ARATimeDuration* tailTime) noexcept
 {
     ARA_LOG_HOST_ENTRY (playbackRegionRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto playbackRegion { fromRef (playbackRegionRef) };
+    ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
     ARA_VALIDATE_API_ARGUMENT (headTime, headTime != nullptr);
     ARA_VALIDATE_API_ARGUMENT (tailTime, tailTime != nullptr);
 
+    ModelMirror::ObjectState state;
+    if (readMirroredState (ModelMirror::ObjectKind::playbackRegion, playbackRegion->remoteRef, state))
+    {
+        if (headTime != nullptr)
+            *headTime = state.headTime;
+        if (tailTime != nullptr)
+            *tailTime = state.tailTime;
+        return;
+    }
+
     GetPlaybackRegionHeadAndTailTimeReply reply;
     remoteCallWithReply (reply, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getPlaybackRegionHeadAndTailTime),
-                        _remoteRef, playbackRegionRef, (headTime != nullptr) ? kARATrue : kARAFalse, (tailTime != nullptr) ? kARATrue : kARAFalse);
+                        _remoteRef, playbackRegion->remoteRef, (headTime != nullptr) ? kARATrue : kARAFalse, (tailTime != nullptr) ? kARATrue : kARAFalse);
     if (headTime != nullptr)
         *headTime = reply.headTime;
     if (tailTime != nullptr)
@@ -772,9 +1158,13 @@ void DocumentController::destroyPlaybackRegion (ARAPlaybackRegionRef playbackReg
 {
     ARA_LOG_HOST_ENTRY (playbackRegionRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto playbackRegion { fromRef (playbackRegionRef) };
+    ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
 
-    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy playback region", playbackRegionRef);
-    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyPlaybackRegion), _remoteRef, playbackRegionRef);
+    ARA_LOG_MODELOBJECT_LIFETIME ("will destroy playback region", playbackRegion->remoteRef);
+    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyPlaybackRegion), _remoteRef, playbackRegion->remoteRef);
+    _playbackRegions.erase (playbackRegion);
+    delete playbackRegion;
 }
 
 /*******************************************************************************/
@@ -782,9 +1172,14 @@ void DocumentController::destroyPlaybackRegion (ARAPlaybackRegionRef playbackReg
 bool DocumentController::isAudioSourceContentAvailable (ARAAudioSourceRef audioSourceRef, ARAContentType type) noexcept
 {
     ARA_LOG_HOST_ENTRY (audioSourceRef);
-    ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));    const auto audioSource { fromRef (audioSourceRef) };
+    ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
 
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::audioSource, audioSource->remoteRef, state))
+        return state.isContentAvailable (type);
+
     ARABool result;
     remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioSourceContentAvailable), _remoteRef, audioSource->remoteRef, type);
     return (result != kARAFalse);
@@ -797,6 +1192,10 @@ ARAContentGrade DocumentController::getAudioSourceContentGrade (ARAAudioSourceRe
     const auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
 
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::audioSource, audioSource->remoteRef, state))
+        return state.getContentGrade (type);
+
     ARAContentGrade grade;
     remoteCallWithReply (grade, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getAudioSourceContentGrade), _remoteRef, audioSource->remoteRef, type);
     return grade;
@@ -813,7 +1212,7 @@ ARAContentReaderRef DocumentController::createAudioSourceContentReader (ARAAudio
     remoteCallWithReply (contentReaderRef, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioSourceContentReader),
                         _remoteRef, audioSource->remoteRef, type, range);
 
-    auto contentReader { new ContentReader { contentReaderRef, type } };
+    auto contentReader { new ContentReader { contentReaderRef, type, _remoteGeneration } };
 #if ARA_ENABLE_OBJECT_LIFETIME_LOG
     ARA_LOG ("Plug success: did create content reader %p for audio source %p", contentReaderRef, audioSourceRef);
 #endif
@@ -826,9 +1225,15 @@ bool DocumentController::isAudioModificationContentAvailable (ARAAudioModificati
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
+
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::audioModification, audioModification->remoteRef, state))
+        return state.isContentAvailable (type);
 
     ARABool result;
-    remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioModificationContentAvailable), _remoteRef, audioModificationRef, type);
+    remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioModificationContentAvailable), _remoteRef, audioModification->remoteRef, type);
     return (result != kARAFalse);
 }
 
@@ -836,9 +1241,15 @@ ARAContentGrade DocumentController::getAudioModificationContentGrade (ARAAudioMo
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
+
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::audioModification, audioModification->remoteRef, state))
+        return state.getContentGrade (type);
 
     ARAContentGrade grade;
-    remoteCallWithReply (grade, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getAudioModificationContentGrade), _remoteRef, audioModificationRef, type);
+    remoteCallWithReply (grade, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getAudioModificationContentGrade), _remoteRef, audioModification->remoteRef, type);
     return grade;
 }
 
@@ -846,12 +1257,14 @@ ARAContentReaderRef DocumentController::createAudioModificationContentReader (AR
 {
     ARA_LOG_HOST_ENTRY (audioModificationRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto audioModification { fromRef (audioModificationRef) };
+    ARA_VALIDATE_API_ARGUMENT (audioModification, isValidInstance (audioModification));
 
     ARAContentReaderRef contentReaderRef;
     remoteCallWithReply (contentReaderRef, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioModificationContentReader),
-                        _remoteRef, audioModificationRef, type, range);
+                        _remoteRef, audioModification->remoteRef, type, range);
 
-    auto contentReader { new ContentReader { contentReaderRef, type } };
+    auto contentReader { new ContentReader { contentReaderRef, type, _remoteGeneration } };
 #if ARA_ENABLE_OBJECT_LIFETIME_LOG
     ARA_LOG ("Plug success: did create content reader %p for audio modification %p", contentReaderRef, audioModificationRef);
 #endif
@@ -864,9 +1277,15 @@ bool DocumentController::isPlaybackRegionContentAvailable (ARAPlaybackRegionRef
 {
     ARA_LOG_HOST_ENTRY (playbackRegionRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto playbackRegion { fromRef (playbackRegionRef) };
+    ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
+
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::playbackRegion, playbackRegion->remoteRef, state))
+        return state.isContentAvailable (type);
 
     ARABool result;
-    remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isPlaybackRegionContentAvailable), _remoteRef, playbackRegionRef, type);
+    remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isPlaybackRegionContentAvailable), _remoteRef, playbackRegion->remoteRef, type);
     return (result != kARAFalse);
 }
 
@@ -874,9 +1293,15 @@ ARAContentGrade DocumentController::getPlaybackRegionContentGrade (ARAPlaybackRe
 {
     ARA_LOG_HOST_ENTRY (playbackRegionRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto playbackRegion { fromRef (playbackRegionRef) };
+    ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
+
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::playbackRegion, playbackRegion->remoteRef, state))
+        return state.getContentGrade (type);
 
     ARAContentGrade grade;
-    remoteCallWithReply (grade, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getPlaybackRegionContentGrade), _remoteRef, playbackRegionRef, type);
+    remoteCallWithReply (grade, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getPlaybackRegionContentGrade), _remoteRef, playbackRegion->remoteRef, type);
     return grade;
 }
 
@@ -884,12 +1309,14 @@ ARAContentReaderRef DocumentController::createPlaybackRegionContentReader (ARAPl
 {
     ARA_LOG_HOST_ENTRY (playbackRegionRef);
     ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    const auto playbackRegion { fromRef (playbackRegionRef) };
+    ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
 
     ARAContentReaderRef contentReaderRef;
     remoteCallWithReply (contentReaderRef, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createPlaybackRegionContentReader),
-                        _remoteRef, playbackRegionRef, type, range);
+                        _remoteRef, playbackRegion->remoteRef, type, range);
 
-    auto contentReader { new ContentReader { contentReaderRef, type } };
+    auto contentReader { new ContentReader { contentReaderRef, type, _remoteGeneration } };
 #if ARA_ENABLE_OBJECT_LIFETIME_LOG
     ARA_LOG ("Plug success: did create content reader %p for playback region %p", contentReaderRef, playbackRegionRef);
 #endif
@@ -905,8 +1332,13 @@ ARAInt32 DocumentController::getContentReaderEventCount (ARAContentReaderRef con
     const auto contentReader { fromRef (contentReaderRef) };
     ARA_VALIDATE_API_ARGUMENT (contentReader, isValidInstance (contentReader));
 
+    // readers created before replacing the remote process no longer provide any data
+    if (contentReader->remoteGeneration != _remoteGeneration)
+        return 0;
+
     ARAInt32 count;
     remoteCallWithReply (count, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, getContentReaderEventCount), _remoteRef, contentReader->remoteRef);
+    contentReader->eventCount = count;
     return count;
 }
 
@@ -917,6 +1349,25 @@ const void* DocumentController::getContentReaderDataForEvent (ARAContentReaderRe
     const auto contentReader { fromRef (contentReaderRef) };
     ARA_VALIDATE_API_ARGUMENT (contentReader, isValidInstance (contentReader));
 
+    if (const auto decodedEvent { contentReader->decoder.findDecodedEvent (eventIndex) })
+        return decodedEvent;
+
+    if (contentReader->remoteGeneration != _remoteGeneration)
+        return nullptr;
+
+    // events are typically read in order, so if the event count is known, fetch a batch of subsequent events
+    if ((0 <= eventIndex) && (eventIndex < contentReader->eventCount))
+    {
+        const auto eventCount { std::min (kContentReaderEventsBatchSize, contentReader->eventCount - eventIndex) };
+        RemoteCaller::CustomDecodeFunction customDecode { [&contentReader, eventIndex] (const ARAIPCMessageDecoder& decoder) -> void
+            {
+                contentReader->decoder.decodeEvents (decoder, eventIndex);
+            } };
+        remoteCallWithReply (customDecode, false, kGetContentReaderDataForEventsMessageID,
+                            _remoteRef, contentReader->remoteRef, eventIndex, eventCount);
+        return contentReader->decoder.findDecodedEvent (eventIndex);
+    }
+
     const void* result {};
     RemoteCaller::CustomDecodeFunction customDecode { [&result, &contentReader] (const ARAIPCMessageDecoder& decoder) -> void
         {
@@ -935,7 +1386,8 @@ void DocumentController::destroyContentReader (ARAContentReaderRef contentReader
     ARA_VALIDATE_API_ARGUMENT (contentReader, isValidInstance (contentReader));
 
     ARA_LOG_MODELOBJECT_LIFETIME ("will destroy content reader", contentReader->remoteRef);
-    remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyContentReader), _remoteRef, contentReader->remoteRef);
+    if (contentReader->remoteGeneration == _remoteGeneration)
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, destroyContentReader), _remoteRef, contentReader->remoteRef);
 
     delete contentReader;
 }
@@ -949,6 +1401,10 @@ bool DocumentController::isAudioSourceContentAnalysisIncomplete (ARAAudioSourceR
     const auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
 
+    ModelMirror::ObjectState state;
+    if ((ModelMirror::getContentTypeIndex (type) >= 0) && readMirroredState (ModelMirror::ObjectKind::audioSource, audioSource->remoteRef, state))
+        return state.isContentAnalysisIncomplete (type);
+
     ARABool result;
     remoteCallWithReply (result, false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, isAudioSourceContentAnalysisIncomplete),
                         _remoteRef, audioSource->remoteRef, type);
@@ -1014,6 +1470,7 @@ void DocumentController::requestProcessingAlgorithmForAudioSource (ARAAudioSourc
     const auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSource, isValidInstance (audioSource));
 
+    audioSource->requestedProcessingAlgorithm = algorithmIndex;
     remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, requestProcessingAlgorithmForAudioSource), _remoteRef, audioSource->remoteRef, algorithmIndex);
 }
 
@@ -1032,6 +1489,89 @@ bool DocumentController::isLicensedForCapabilities (bool runModalActivationDialo
 }
 
 
+/*******************************************************************************/
+
+bool DocumentController::recoverRemoteDocument (ARAIPCMessageSender sender) noexcept
+{
+    ARA_LOG_HOST_ENTRY (this);
+    ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+    ARA_VALIDATE_API_STATE (!_isEditing);
+
+    // all remote objects of the lost process are gone, including any content readers
+    setSender (sender);
+    ++_remoteGeneration;
+    _remoteRef = nullptr;
+    if (!createRemoteDocumentController ())
+        return false;
+
+    // re-create the model graph in dependency order - clones are re-created like any other
+    // audio modification, since their state is restored from the archive anyways
+    // every call must reach the new process, otherwise the remote document is incomplete
+    bool success { remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, beginEditing), _remoteRef) };
+
+    for (auto musicalContext : _musicalContexts)
+        success &= remoteCallWithReply (musicalContext->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createMusicalContext),
+                                        _remoteRef, musicalContext->hostRef, musicalContext->properties.get ());
+    for (auto regionSequence : _regionSequences)
+        success &= remoteCallWithReply (regionSequence->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createRegionSequence),
+                                        _remoteRef, regionSequence->hostRef, getRemoteProperties (regionSequence->properties));
+    for (auto audioSource : _audioSources)
+        success &= remoteCallWithReply (audioSource->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioSource),
+                                        _remoteRef, ARAAudioSourceHostRef { toHostRef (audioSource) }, audioSource->properties.get ());
+    for (auto audioModification : _audioModifications)
+        success &= remoteCallWithReply (audioModification->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createAudioModification),
+                                        _remoteRef, audioModification->audioSource->remoteRef, audioModification->hostRef, audioModification->properties.get ());
+    for (auto playbackRegion : _playbackRegions)
+        success &= remoteCallWithReply (playbackRegion->remoteRef, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, createPlaybackRegion),
+                                        _remoteRef, playbackRegion->audioModification->remoteRef, playbackRegion->hostRef, getRemoteProperties (playbackRegion->properties));
+
+    // restore the plug-in specific state from the last archive of the entire document,
+    // reading it from our copy instead of from the host, see the callbacks dispatcher below
+    if (!_replayArchive.bytes.empty ())
+    {
+        _isReplayingArchive = true;
+        ARABool didRestore { kARAFalse };
+        const ARAArchiveReaderHostRef archiveReaderHostRef { toHostRef (&_replayArchive) };
+        const ARARestoreObjectsFilter* const filter { nullptr };
+        success &= remoteCallWithReply (didRestore, true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, restoreObjectsFromArchive),
+                                        _remoteRef, archiveReaderHostRef, filter);
+        success &= (didRestore != kARAFalse);
+        _isReplayingArchive = false;
+    }
+
+    // re-establish the undo state and the requests made by the host
+    for (auto audioModification : _audioModifications)
+    {
+        if (audioModification->isDeactivatedForUndoHistory)
+            success &= remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, deactivateAudioModificationForUndoHistory),
+                                               _remoteRef, audioModification->remoteRef, kARATrue);
+    }
+    for (auto audioSource : _audioSources)
+    {
+        if (audioSource->isDeactivatedForUndoHistory)
+            success &= remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, deactivateAudioSourceForUndoHistory),
+                                               _remoteRef, audioSource->remoteRef, kARATrue);
+        if (audioSource->requestedProcessingAlgorithm >= 0)
+            success &= remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, requestProcessingAlgorithmForAudioSource),
+                                               _remoteRef, audioSource->remoteRef, audioSource->requestedProcessingAlgorithm);
+    }
+
+    success &= remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, endEditing), _remoteRef);
+
+    for (auto audioSource : _audioSources)
+    {
+        if (audioSource->isSamplesAccessEnabled)
+            success &= remoteCallWithoutReply (true, ARA_IPC_PLUGIN_METHOD_ID (ARADocumentControllerInterface, enableAudioSourceSamplesAccess),
+                                               _remoteRef, audioSource->remoteRef, kARATrue);
+    }
+
+    openModelMirror ();
+
+    ARA_LOG_MODELOBJECT_LIFETIME ("did recover document controller", _remoteRef);
+    return success;
+}
+
+
 /*******************************************************************************/
 // Implementation of PlaybackRendererInterface that channels all calls through IPC
 
@@ -1048,15 +1588,19 @@ public:
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+        const auto playbackRegion { fromRef (playbackRegionRef) };
+        ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAPlaybackRendererInterface, addPlaybackRegion), _remoteRef, playbackRegionRef);
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAPlaybackRendererInterface, addPlaybackRegion), _remoteRef, playbackRegion->remoteRef);
     }
     void removePlaybackRegion (ARAPlaybackRegionRef playbackRegionRef) noexcept override
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+        const auto playbackRegion { fromRef (playbackRegionRef) };
+        ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAPlaybackRendererInterface, removePlaybackRegion), _remoteRef, playbackRegionRef);
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAPlaybackRendererInterface, removePlaybackRegion), _remoteRef, playbackRegion->remoteRef);
     }
 
 private:
@@ -1082,30 +1626,38 @@ public:
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+        const auto playbackRegion { fromRef (playbackRegionRef) };
+        ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, addPlaybackRegion), _remoteRef, playbackRegionRef);
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, addPlaybackRegion), _remoteRef, playbackRegion->remoteRef);
     }
     void removePlaybackRegion (ARAPlaybackRegionRef playbackRegionRef) noexcept override
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+        const auto playbackRegion { fromRef (playbackRegionRef) };
+        ARA_VALIDATE_API_ARGUMENT (playbackRegion, isValidInstance (playbackRegion));
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, removePlaybackRegion), _remoteRef, playbackRegionRef);
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, removePlaybackRegion), _remoteRef, playbackRegion->remoteRef);
     }
 
     void addRegionSequence (ARARegionSequenceRef regionSequenceRef) noexcept override
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+        const auto regionSequence { fromRef (regionSequenceRef) };
+        ARA_VALIDATE_API_ARGUMENT (regionSequence, isValidInstance (regionSequence));
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, addRegionSequence), _remoteRef, regionSequenceRef);
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, addRegionSequence), _remoteRef, regionSequence->remoteRef);
     }
     void removeRegionSequence (ARARegionSequenceRef regionSequenceRef) noexcept override
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
+        const auto regionSequence { fromRef (regionSequenceRef) };
+        ARA_VALIDATE_API_ARGUMENT (regionSequence, isValidInstance (regionSequence));
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, removeRegionSequence), _remoteRef, regionSequenceRef);
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorRendererInterface, removeRegionSequence), _remoteRef, regionSequence->remoteRef);
     }
 
 private:
@@ -1133,17 +1685,37 @@ public:
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
         ARA_VALIDATE_API_STRUCT_PTR (selection, ARAViewSelection);
 
-        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorViewInterface, notifySelection), _remoteRef, *selection);
+        std::vector<ARAPlaybackRegionRef> playbackRegionRefs;
+        playbackRegionRefs.reserve (selection->playbackRegionRefsCount);
+        for (auto i { 0U }; i < selection->playbackRegionRefsCount; ++i)
+            playbackRegionRefs.emplace_back (fromRef (selection->playbackRegionRefs[i])->remoteRef);
+        const auto regionSequenceRefs { getRemoteRegionSequenceRefs (selection->regionSequenceRefsCount, selection->regionSequenceRefs) };
+
+        auto remoteSelection { *selection };
+        remoteSelection.playbackRegionRefs = playbackRegionRefs.data ();
+        remoteSelection.regionSequenceRefs = regionSequenceRefs.data ();
+        remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorViewInterface, notifySelection), _remoteRef, remoteSelection);
     }
     void notifyHideRegionSequences (ARASize regionSequenceRefsCount, const ARARegionSequenceRef regionSequenceRefs[]) noexcept override
     {
         ARA_LOG_HOST_ENTRY (this);
         ARA_VALIDATE_API_ARGUMENT (this, isValidInstance (this));
 
-        const ArrayArgument<const ARARegionSequenceRef> sequences { regionSequenceRefs, regionSequenceRefsCount };
+        const auto remoteRegionSequenceRefs { getRemoteRegionSequenceRefs (regionSequenceRefsCount, regionSequenceRefs) };
+        const ArrayArgument<const ARARegionSequenceRef> sequences { remoteRegionSequenceRefs.data (), remoteRegionSequenceRefs.size () };
         remoteCallWithoutReply (false, ARA_IPC_PLUGIN_METHOD_ID (ARAEditorViewInterface, notifyHideRegionSequences), _remoteRef, sequences);
     }
 
+private:
+    static std::vector<ARARegionSequenceRef> getRemoteRegionSequenceRefs (ARASize regionSequenceRefsCount, const ARARegionSequenceRef regionSequenceRefs[]) noexcept
+    {
+        std::vector<ARARegionSequenceRef> result;
+        result.reserve (regionSequenceRefsCount);
+        for (auto i { 0U }; i < regionSequenceRefsCount; ++i)
+            result.emplace_back (fromRef (regionSequenceRefs[i])->remoteRef);
+        return result;
+    }
+
 private:
     ARAEditorViewRef const _remoteRef;
 
@@ -1321,6 +1893,16 @@ const ARADocumentControllerInstance* ARAIPCProxyPlugInCreateDocumentControllerWi
     return result->getInstance ();
 }
 
+bool ARAIPCProxyPlugInIsDocumentControllerConnected (const ARADocumentControllerInstance* documentControllerInstance)
+{
+    return static_cast<DocumentController*> (PlugIn::fromRef (documentControllerInstance->documentControllerRef))->isRemoteConnected ();
+}
+
+bool ARAIPCProxyPlugInRecoverDocumentController (const ARADocumentControllerInstance* documentControllerInstance, ARAIPCMessageSender hostCommandsSender)
+{
+    return static_cast<DocumentController*> (PlugIn::fromRef (documentControllerInstance->documentControllerRef))->recoverRemoteDocument (hostCommandsSender);
+}
+
 const ARAPlugInExtensionInstance* ARAIPCProxyPlugInBindToDocumentController (ARAIPCPlugInInstanceRef remoteRef, ARAIPCMessageSender sender, ARADocumentControllerRef documentControllerRef,
                                                                             ARAPlugInInstanceRoleFlags knownRoles, ARAPlugInInstanceRoleFlags assignedRoles)
 {
@@ -1350,6 +1932,9 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
 {
 //  ARA_LOG ("plugInCallbackDispatcher received message %s", decodeHostMessageID (messageID));
 
+    // temporary storage for decoding the arguments is only needed while handling the call
+    const DecodeScratchScope decodeScratchScope {};
+
     // ARAAudioAccessControllerInterface
     if (messageID == ARA_IPC_HOST_METHOD_ID (ARAAudioAccessControllerInterface, createAudioReaderForSource))
     {
@@ -1431,6 +2016,9 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto documentController { fromHostRef (controllerHostRef) };
         ARA_VALIDATE_API_ARGUMENT (controllerHostRef, isValidInstance (documentController));
 
+        if (const auto replayArchive { documentController->getReplayArchive (archiveReaderHostRef) })
+            return encodeReply (replyEncoder, static_cast<ARASize> (replayArchive->bytes.size ()));
+
         return encodeReply (replyEncoder, documentController->getHostArchivingController ()->getArchiveSize (archiveReaderHostRef));
     }
     else if (messageID == ARA_IPC_HOST_METHOD_ID (ARAArchivingControllerInterface, readBytesFromArchive))
@@ -1446,6 +2034,16 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
 
         // \todo using static here assumes single-threaded callbacks, but currently this is a valid requirement
         static std::vector<ARAByte> bytes;
+        if (const auto replayArchive { documentController->getReplayArchive (archiveReaderHostRef) })
+        {
+            if ((position > replayArchive->bytes.size ()) || (length > replayArchive->bytes.size () - position))
+                bytes.clear ();
+            else
+                bytes.assign (replayArchive->bytes.begin () + static_cast<std::ptrdiff_t> (position),
+                              replayArchive->bytes.begin () + static_cast<std::ptrdiff_t> (position + length));
+            return encodeReply (replyEncoder, BytesEncoder { bytes, false });
+        }
+
         bytes.resize (length);
         if (!documentController->getHostArchivingController ()->readBytesFromArchive (archiveReaderHostRef, position, length, bytes.data ()))
             bytes.clear ();
@@ -1464,7 +2062,10 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto documentController { fromHostRef (controllerHostRef) };
         ARA_VALIDATE_API_ARGUMENT (controllerHostRef, isValidInstance (documentController));
 
-        return encodeReply (replyEncoder, documentController->getHostArchivingController ()->writeBytesToArchive (archiveWriterHostRef, position, bytes.size (), bytes.data ()));
+        const auto success { documentController->getHostArchivingController ()->writeBytesToArchive (archiveWriterHostRef, position, bytes.size (), bytes.data ()) };
+        if (success)
+            documentController->didWriteBytesToArchive (archiveWriterHostRef, position, bytes);
+        return encodeReply (replyEncoder, success);
     }
     else if (messageID == ARA_IPC_HOST_METHOD_ID (ARAArchivingControllerInterface, notifyDocumentArchivingProgress))
     {
@@ -1486,7 +2087,8 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto documentController { fromHostRef (controllerHostRef) };
         ARA_VALIDATE_API_ARGUMENT (controllerHostRef, isValidInstance (documentController));
 
-        documentController->getHostArchivingController ()->notifyDocumentUnarchivingProgress (value);
+        if (!documentController->isReplayingArchive ())
+            documentController->getHostArchivingController ()->notifyDocumentUnarchivingProgress (value);
     }
     else if (messageID == ARA_IPC_HOST_METHOD_ID (ARAArchivingControllerInterface, getDocumentArchiveID))
     {
@@ -1497,6 +2099,9 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto documentController { fromHostRef (controllerHostRef) };
         ARA_VALIDATE_API_ARGUMENT (controllerHostRef, isValidInstance (documentController));
 
+        if (const auto replayArchive { documentController->getReplayArchive (archiveReaderHostRef) })
+            return encodeReply (replyEncoder, replayArchive->documentArchiveID.c_str ());
+
         return encodeReply (replyEncoder, documentController->getHostArchivingController ()->getDocumentArchiveID (archiveReaderHostRef));
     }
 
@@ -1536,9 +2141,7 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto documentController { fromHostRef (controllerHostRef) };
         ARA_VALIDATE_API_ARGUMENT (controllerHostRef, isValidInstance (documentController));
 
-        auto hostContentReader { new HostContentReader };
-        hostContentReader->hostRef = documentController->getHostContentAccessController ()->createMusicalContextContentReader (musicalContextHostRef, contentType, (range.second) ? &range.first : nullptr);
-        hostContentReader->contentType = contentType;
+        auto hostContentReader { new HostContentReader { documentController->getHostContentAccessController ()->createMusicalContextContentReader (musicalContextHostRef, contentType, (range.second) ? &range.first : nullptr), contentType } };
 
         return encodeReply (replyEncoder, ARAContentReaderHostRef { toHostRef (hostContentReader) });
     }
@@ -1583,9 +2186,7 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto audioSource { fromHostRef (audioSourceHostRef) };
         ARA_VALIDATE_API_ARGUMENT (audioSourceHostRef, isValidInstance (audioSource));
 
-        auto hostContentReader { new HostContentReader };
-        hostContentReader->hostRef = documentController->getHostContentAccessController ()->createAudioSourceContentReader (audioSource->hostRef, contentType, (range.second) ? &range.first : nullptr);
-        hostContentReader->contentType = contentType;
+        auto hostContentReader { new HostContentReader { documentController->getHostContentAccessController ()->createAudioSourceContentReader (audioSource->hostRef, contentType, (range.second) ? &range.first : nullptr), contentType } };
         return encodeReply (replyEncoder, ARAContentReaderHostRef { toHostRef (hostContentReader) });
     }
     else if (messageID == ARA_IPC_HOST_METHOD_ID (ARAContentAccessControllerInterface, getContentReaderEventCount))
@@ -1612,7 +2213,29 @@ void ARAIPCProxyPlugInCallbacksDispatcher (const ARAIPCMessageID messageID, cons
         auto hostContentReader { fromHostRef (contentReaderHostRef) };
 
         const void* eventData { documentController->getHostContentAccessController ()->getContentReaderDataForEvent (hostContentReader->hostRef, eventIndex) };
-        return encodeContentEvent (replyEncoder, hostContentReader->contentType, eventData);
+        const PODEncodingScope podEncodingScope { documentController->receiverEndianessMatches () };
+        return hostContentReader->encoder.encode (replyEncoder, eventData);
+    }
+    else if (messageID == kGetContentReaderDataForEventsMessageID)
+    {
+        ARAContentAccessControllerHostRef controllerHostRef;
+        ARAContentReaderHostRef contentReaderHostRef;
+        ARAInt32 firstEventIndex;
+        ARAInt32 eventCount;
+        decodeArguments (decoder, controllerHostRef, contentReaderHostRef, firstEventIndex, eventCount);
+        ARA_INTERNAL_ASSERT ((0 < eventCount) && (eventCount <= kContentReaderEventsBatchSize));
+
+        auto documentController { fromHostRef (controllerHostRef) };
+        ARA_VALIDATE_API_ARGUMENT (controllerHostRef, isValidInstance (documentController));
+        auto hostContentReader { fromHostRef (contentReaderHostRef) };
+
+        const auto hostContentAccessController { documentController->getHostContentAccessController () };
+        const PODEncodingScope podEncodingScope { documentController->receiverEndianessMatches () };
+        return hostContentReader->encoder.encodeEvents (replyEncoder, firstEventIndex, eventCount,
+                    [hostContentAccessController, hostContentReader] (const ARAInt32 eventIndex) -> const void*
+                    {
+                        return hostContentAccessController->getContentReaderDataForEvent (hostContentReader->hostRef, eventIndex);
+                    });
     }
     else if (messageID == ARA_IPC_HOST_METHOD_ID (ARAContentAccessControllerInterface, destroyContentReader))
     {
@@ -50,6 +50,35 @@ const ARADocumentControllerInstance * ARAIPCProxyPlugInCreateDocumentControllerW
                                                                                             const ARADocumentControllerHostInstance * hostInstance,
                                                                                             const ARADocumentProperties * properties);
 
+//! Crash Recovery
+//! The proxy plug-in records the current state of each document controller as established by the
+//! host: all model objects with their properties and undo state, the requests made by the host,
+//! and a copy of the last archive of the entire document (i.e. the archive of the latest call to
+//! storeObjectsToArchive() or restoreObjectsFromArchive() without a filter). If the remote process
+//! is lost, e.g. because the plug-in crashed, the host can launch a replacement process, establish a
+//! new connection to it, call ARAIPCProxyPlugInInitializeARA() for the new sender, and then replay
+//! this state to bring each document controller back to where it was.
+//! The refs that the host received for the document controller and its objects remain valid.
+//! Any plug-in internal edits made since the last archive are lost, as are all content readers
+//! that were created before the recovery (they will report no events), and all plug-in extensions
+//! must be re-bound to the recovered document controller via ARAIPCProxyPlugInBindToDocumentController().
+//! @{
+
+//! test whether the remote side of the document controller still is reachable
+//! Returns true if the underlying message sender does not support detecting a lost connection
+//! (see ARAIPCMessageSenderInterface::isReceiverConnected()).
+bool ARAIPCProxyPlugInIsDocumentControllerConnected(const ARADocumentControllerInstance * documentControllerInstance);
+
+//! re-create the remote document controller and all its objects via the given (new) sender,
+//! restoring the last archive of the document if available
+//! Must not be called while the host is editing the document.
+//! Returns false if the replay failed, including if any call did not reach the new process, in which
+//! case the host should destroy the document controller.
+//! The remote unarchiving progress of the replay is not forwarded to the host.
+bool ARAIPCProxyPlugInRecoverDocumentController(const ARADocumentControllerInstance * documentControllerInstance, ARAIPCMessageSender hostCommandsSender);
+
+//! @}
+
 //! static handler of received messages
 void ARAIPCProxyPlugInCallbacksDispatcher(const ARAIPCMessageID messageID, const ARAIPCMessageDecoder * decoder, ARAIPCMessageEncoder *  replyEncoder);
 
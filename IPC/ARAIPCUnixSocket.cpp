@@ -0,0 +1,1409 @@
+//------------------------------------------------------------------------------
+//! \file       ARAIPCUnixSocket.cpp
+//!             Implementation of ARAIPCMessageSender based on Unix domain sockets,
+//!             passing bulk data via memfd file descriptors
+//! \project    ARA SDK Examples
+//! \copyright  Copyright (c) 2021-2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#include "ARAIPCUnixSocket.h"
+
+
+#if ARA_ENABLE_IPC && defined (__linux__)
+
+
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace ARA {
+namespace IPC {
+
+
+//------------------------------------------------------------------------------
+// wire format
+//------------------------------------------------------------------------------
+
+// each datagram starts with this header, followed by the inline payload (if any)
+struct _FrameHeader
+{
+    uint32_t magic;                 // kFrameMagic - also used to detect invalid data
+    ARAIPCMessageID messageID;      // kReplyMessageID for replies
+    uint32_t flags;
+    uint32_t fileDescriptorsCount;  // count of memfd descriptors passed along via SCM_RIGHTS
+    uint32_t streamID;              // logical stream the message, reply or acknowledge belongs to
+    uint32_t sequenceNumber;        // per-stream number of the message, echoed by its reply
+    uint64_t payloadSize;
+};
+
+constexpr uint32_t kFrameMagic { 0x41524131 };      // 'ARA1'
+constexpr ARAIPCMessageID kReplyMessageID { 0 };    // message IDs start at kARAIPCMessageIDRangeStart
+
+// stream used by ARAIPCUnixSocketGetMessageSender () and ARAIPCUnixSocketProcessReceivedMessages ()
+constexpr uint32_t kDefaultStreamID { 0 };
+static_assert (kReplyMessageID < kARAIPCMessageIDRangeStart, "reply ID must not collide with message IDs");
+
+// if set, the payload is not sent inline but through the last file descriptor
+constexpr uint32_t kFrameFlagPayloadIsMapped { 0x1 };
+// if set, the sender does not wait for a reply - the receiver only acknowledges the message
+// after handling it to return the flow control credit to the sender
+constexpr uint32_t kFrameFlagOneWay { 0x2 };
+// set for the payload-less acknowledgement of a one-way message, sent with kReplyMessageID
+constexpr uint32_t kFrameFlagAcknowledge { 0x4 };
+// set for a payload-less reply that replaces a reply which could not be sent, sent with kReplyMessageID
+constexpr uint32_t kFrameFlagReplyFailed { 0x8 };
+
+// raw bytes of this size or larger are passed via memfd instead of being copied into the payload
+constexpr size_t kMappedBytesThreshold { 32 * 1024 };
+// payloads larger than this are passed via memfd as a whole (must fit into the socket send buffer)
+constexpr size_t kMaxInlinePayloadSize { 64 * 1024 };
+// the kernel limit for SCM_RIGHTS is SCM_MAX_FD (253), we need one descriptor for a mapped payload
+constexpr size_t kMaxFileDescriptorsPerFrame { 252 };
+
+// each value in a payload is encoded as key, type, and type-dependent data, in native byte order
+enum class _ValueType : uint8_t
+{
+    int32 = 1,      // int32_t
+    int64,          // int64_t
+    size,           // uint64_t
+    float32,        // float
+    float64,        // double
+    string,         // uint64_t length (including terminating 0) followed by the characters
+    bytes,          // uint64_t size followed by the bytes
+    mappedBytes,    // uint64_t size followed by uint32_t index of the file descriptor
+    subMessage      // uint64_t size followed by the encoded values of the sub-message
+};
+
+
+template<typename T>
+inline void _appendRaw (std::vector<uint8_t>& data, const T& value)
+{
+    const auto position { data.size () };
+    data.resize (position + sizeof (T));
+    std::memcpy (data.data () + position, &value, sizeof (T));
+}
+
+inline void _appendRaw (std::vector<uint8_t>& data, const uint8_t* bytes, size_t size)
+{
+    data.insert (data.end (), bytes, bytes + size);
+}
+
+inline void _appendValueHeader (std::vector<uint8_t>& data, ARAIPCMessageKey argKey, _ValueType type)
+{
+    _appendRaw (data, argKey);
+    _appendRaw (data, type);
+}
+
+template<typename T>
+inline T _readRaw (const uint8_t* data)
+{
+    T value;
+    std::memcpy (&value, data, sizeof (T));
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+// memfd helpers
+//------------------------------------------------------------------------------
+
+// create a sealed memfd file containing a copy of the given bytes, returns -1 upon failure
+static int _createSealedMemFD (const uint8_t* bytes, size_t size)
+{
+    const auto fd { memfd_create ("ARAIPCPayload", MFD_CLOEXEC | MFD_ALLOW_SEALING) };
+    if (fd < 0)
+    {
+        ARA_WARN ("memfd_create () failed with error %i", errno);
+        return -1;
+    }
+
+    size_t written { 0 };
+    while (written < size)
+    {
+        const auto result { ::write (fd, bytes + written, size - written) };
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            ARA_WARN ("writing to memfd failed with error %i", errno);
+            ::close (fd);
+            return -1;
+        }
+        written += static_cast<size_t> (result);
+    }
+
+    // sealing guarantees that the receiver can safely map the file - it can neither be modified
+    // nor truncated afterwards, which otherwise could raise SIGBUS when accessing the mapping
+    if (fcntl (fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+    {
+        ARA_WARN ("sealing memfd failed with error %i", errno);
+        ::close (fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// read-only mapping of a received memfd file
+class _MappedFile
+{
+public:
+    explicit _MappedFile (int fd)
+    {
+        const auto seals { fcntl (fd, F_GET_SEALS) };
+        if ((seals < 0) || ((seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) != (F_SEAL_SHRINK | F_SEAL_WRITE)))
+        {
+            ARA_INTERNAL_ASSERT (false && "received file descriptor is not a properly sealed memfd");
+            return;
+        }
+
+        struct stat fileStat;
+        if ((fstat (fd, &fileStat) != 0) || (fileStat.st_size <= 0))
+            return;
+
+        const auto size { static_cast<size_t> (fileStat.st_size) };
+        const auto address { mmap (nullptr, size, PROT_READ, MAP_SHARED, fd, 0) };
+        if (address == MAP_FAILED)
+        {
+            ARA_WARN ("mapping memfd failed with error %i", errno);
+            return;
+        }
+
+        _address = static_cast<const uint8_t*> (address);
+        _size = size;
+    }
+
+    ~_MappedFile ()
+    {
+        if (_address)
+            munmap (const_cast<uint8_t*> (_address), _size);
+    }
+
+    const uint8_t* getAddress () const { return _address; }
+    size_t getSize () const { return _size; }
+
+    _MappedFile (const _MappedFile& other) = delete;
+    _MappedFile& operator= (const _MappedFile& other) = delete;
+
+private:
+    const uint8_t* _address { nullptr };
+    size_t _size { 0 };
+};
+
+
+//------------------------------------------------------------------------------
+// encoder
+//------------------------------------------------------------------------------
+
+// Numbers, strings and small bytes are encoded directly when appended, raw bytes that
+// potentially need to be mapped and sub-messages are encoded when serializing the message.
+class _MessageEncoder
+{
+public:
+    _MessageEncoder () = default;
+    _MessageEncoder (const _MessageEncoder& other) = delete;
+    _MessageEncoder& operator= (const _MessageEncoder& other) = delete;
+
+    void retain ()
+    {
+        ++_retainCount;
+    }
+
+    void release ()
+    {
+        ARA_INTERNAL_ASSERT (_retainCount > 0);
+        if (--_retainCount == 0)
+            delete this;
+    }
+
+    template<typename T>
+    void appendNumber (ARAIPCMessageKey argKey, _ValueType type, T argValue)
+    {
+        _appendValueHeader (_data, argKey, type);
+        _appendRaw (_data, argValue);
+    }
+
+    void appendString (ARAIPCMessageKey argKey, const char* argValue)
+    {
+        const auto length { std::strlen (argValue) + 1 };
+        _appendValueHeader (_data, argKey, _ValueType::string);
+        _appendRaw (_data, static_cast<uint64_t> (length));
+        _appendRaw (_data, reinterpret_cast<const uint8_t*> (argValue), length);
+    }
+
+    void appendBytes (ARAIPCMessageKey argKey, const uint8_t* argValue, size_t argSize, bool copy)
+    {
+        if (argSize < kMappedBytesThreshold)
+        {
+            _appendValueHeader (_data, argKey, _ValueType::bytes);
+            _appendRaw (_data, static_cast<uint64_t> (argSize));
+            _appendRaw (_data, argValue, argSize);
+        }
+        else
+        {
+            _LargeBytes largeBytes { argKey, argValue, argSize, {} };
+            if (copy)
+            {
+                largeBytes.storage.assign (argValue, argValue + argSize);
+                largeBytes.bytes = largeBytes.storage.data ();
+            }
+            _largeBytes.emplace_back (std::move (largeBytes));
+        }
+    }
+
+    _MessageEncoder* appendSubMessage (ARAIPCMessageKey argKey)
+    {
+        auto subMessage { new _MessageEncoder };
+        subMessage->retain ();     // retained by both the caller and this parent message
+        _subMessages.emplace_back (argKey, subMessage);
+        return subMessage;
+    }
+
+    // serialize all values into payload, creating memfds for large bytes as needed
+    // The created file descriptors are appended to fileDescriptors and must be closed by the caller.
+    void serialize (std::vector<uint8_t>& payload, std::vector<int>& fileDescriptors) const
+    {
+        _appendRaw (payload, _data.data (), _data.size ());
+
+        for (const auto& largeBytes : _largeBytes)
+        {
+            if (fileDescriptors.size () < kMaxFileDescriptorsPerFrame)
+            {
+                const auto fd { _createSealedMemFD (largeBytes.bytes, largeBytes.size) };
+                if (fd >= 0)
+                {
+                    _appendValueHeader (payload, largeBytes.key, _ValueType::mappedBytes);
+                    _appendRaw (payload, static_cast<uint64_t> (largeBytes.size));
+                    _appendRaw (payload, static_cast<uint32_t> (fileDescriptors.size ()));
+                    fileDescriptors.push_back (fd);
+                    continue;
+                }
+            }
+
+            // fallback if running out of file descriptors: copy inline
+            _appendValueHeader (payload, largeBytes.key, _ValueType::bytes);
+            _appendRaw (payload, static_cast<uint64_t> (largeBytes.size));
+            _appendRaw (payload, largeBytes.bytes, largeBytes.size);
+        }
+
+        for (const auto& subMessage : _subMessages)
+        {
+            _appendValueHeader (payload, subMessage.first, _ValueType::subMessage);
+            const auto sizePosition { payload.size () };
+            _appendRaw (payload, uint64_t { 0 });
+            subMessage.second->serialize (payload, fileDescriptors);
+            const auto subMessageSize { static_cast<uint64_t> (payload.size () - sizePosition - sizeof (uint64_t)) };
+            std::memcpy (payload.data () + sizePosition, &subMessageSize, sizeof (subMessageSize));
+        }
+    }
+
+private:
+    ~_MessageEncoder ()
+    {
+        for (auto& subMessage : _subMessages)
+            subMessage.second->release ();
+    }
+
+private:
+    struct _LargeBytes
+    {
+        ARAIPCMessageKey key;
+        const uint8_t* bytes;
+        size_t size;
+        std::vector<uint8_t> storage;
+    };
+
+    int _retainCount { 1 };
+    std::vector<uint8_t> _data;
+    std::vector<_LargeBytes> _largeBytes;
+    std::vector<std::pair<ARAIPCMessageKey, _MessageEncoder*>> _subMessages;
+};
+
+
+//------------------------------------------------------------------------------
+// decoder
+//------------------------------------------------------------------------------
+
+// the data of a received frame, shared between all decoders created for it
+class _ReceivedMessage
+{
+public:
+    _ReceivedMessage (std::vector<uint8_t>&& inlinePayload, std::vector<std::unique_ptr<_MappedFile>>&& mappedFiles, bool payloadIsMapped)
+    : _inlinePayload { std::move (inlinePayload) },
+      _mappedFiles { std::move (mappedFiles) }
+    {
+        if (payloadIsMapped && !_mappedFiles.empty ())
+        {
+            _mappedPayload = std::move (_mappedFiles.back ());
+            _mappedFiles.pop_back ();
+            _payload = _mappedPayload->getAddress ();
+            _payloadSize = _mappedPayload->getSize ();
+        }
+        else
+        {
+            _payload = _inlinePayload.data ();
+            _payloadSize = _inlinePayload.size ();
+        }
+    }
+
+    const uint8_t* getPayload () const { return _payload; }
+    size_t getPayloadSize () const { return _payloadSize; }
+
+    const _MappedFile* getMappedFile (size_t index) const
+    {
+        return (index < _mappedFiles.size ()) ? _mappedFiles[index].get () : nullptr;
+    }
+
+private:
+    std::vector<uint8_t> _inlinePayload;
+    std::vector<std::unique_ptr<_MappedFile>> _mappedFiles;
+    std::unique_ptr<_MappedFile> _mappedPayload;
+    const uint8_t* _payload { nullptr };
+    size_t _payloadSize { 0 };
+};
+
+class _MessageDecoder
+{
+public:
+    struct DecodedValue
+    {
+        ARAIPCMessageKey key;
+        _ValueType type;
+        const uint8_t* data;
+        size_t size;
+    };
+
+public:
+    _MessageDecoder (std::shared_ptr<const _ReceivedMessage> message, const uint8_t* data, size_t size)
+    : _message { std::move (message) }
+    {
+        const auto end { data + size };
+        while (data < end)
+        {
+            constexpr auto valueHeaderSize { sizeof (ARAIPCMessageKey) + sizeof (_ValueType) };
+            if (static_cast<size_t> (end - data) < valueHeaderSize)
+                break;
+            DecodedValue value;
+            value.key = _readRaw<ARAIPCMessageKey> (data);
+            value.type = _readRaw<_ValueType> (data + sizeof (ARAIPCMessageKey));
+            data += valueHeaderSize;
+
+            size_t encodedSize;
+            switch (value.type)
+            {
+                case _ValueType::int32:
+                case _ValueType::float32:
+                    encodedSize = 4;
+                    value.data = data;
+                    value.size = encodedSize;
+                    break;
+                case _ValueType::int64:
+                case _ValueType::size:
+                case _ValueType::float64:
+                    encodedSize = 8;
+                    value.data = data;
+                    value.size = encodedSize;
+                    break;
+                case _ValueType::string:
+                case _ValueType::bytes:
+                case _ValueType::subMessage:
+                {
+                    encodedSize = SIZE_MAX;
+                    if (static_cast<size_t> (end - data) < sizeof (uint64_t))
+                        break;
+                    const auto length { _readRaw<uint64_t> (data) };
+                    if (length > static_cast<uint64_t> (end - data) - sizeof (uint64_t))
+                        break;
+                    value.data = data + sizeof (uint64_t);
+                    value.size = static_cast<size_t> (length);
+                    encodedSize = sizeof (uint64_t) + value.size;
+                    break;
+                }
+                case _ValueType::mappedBytes:
+                {
+                    encodedSize = sizeof (uint64_t) + sizeof (uint32_t);
+                    if (static_cast<size_t> (end - data) < encodedSize)
+                        break;
+                    value.size = static_cast<size_t> (_readRaw<uint64_t> (data));
+                    const auto mappedFile { _message->getMappedFile (_readRaw<uint32_t> (data + sizeof (uint64_t))) };
+                    if (!mappedFile || !mappedFile->getAddress () || (mappedFile->getSize () < value.size))
+                    {
+                        ARA_INTERNAL_ASSERT (false && "invalid mapped bytes in IPC message");
+                        encodedSize = SIZE_MAX;
+                        break;
+                    }
+                    value.data = mappedFile->getAddress ();
+                    break;
+                }
+                default:
+                    encodedSize = SIZE_MAX;
+                    break;
+            }
+            if (static_cast<size_t> (end - data) < encodedSize)
+            {
+                ARA_INTERNAL_ASSERT (false && "malformed IPC message");
+                break;
+            }
+            if ((value.type == _ValueType::string) && ((value.size == 0) || (value.data[value.size - 1] != 0)))
+            {
+                ARA_INTERNAL_ASSERT (false && "malformed string in IPC message");
+                break;
+            }
+
+            data += encodedSize;
+            _values.emplace_back (value);
+        }
+
+        // sorting allows for binary search - since values are mostly appended in ascending key order,
+        // this typically is a cheap operation. Stable sorting ensures that duplicate keys resolve to
+        // the last value appended, matching the behavior of dictionaries.
+        std::stable_sort (_values.begin (), _values.end (),
+                          [] (const DecodedValue& a, const DecodedValue& b) { return a.key < b.key; });
+    }
+
+    bool isEmpty () const
+    {
+        return _values.empty ();
+    }
+
+    bool readInteger (ARAIPCMessageKey argKey, int64_t& argValue) const
+    {
+        const auto value { _find (argKey) };
+        if (value)
+        {
+            switch (value->type)
+            {
+                case _ValueType::int32: argValue = _readRaw<int32_t> (value->data); return true;
+                case _ValueType::int64: argValue = _readRaw<int64_t> (value->data); return true;
+                case _ValueType::size: argValue = static_cast<int64_t> (_readRaw<uint64_t> (value->data)); return true;
+                default: ARA_INTERNAL_ASSERT (false && "IPC value type mismatch"); break;
+            }
+        }
+        argValue = 0;
+        return false;
+    }
+
+    bool readFloatingPoint (ARAIPCMessageKey argKey, double& argValue) const
+    {
+        const auto value { _find (argKey) };
+        if (value)
+        {
+            switch (value->type)
+            {
+                case _ValueType::float32: argValue = static_cast<double> (_readRaw<float> (value->data)); return true;
+                case _ValueType::float64: argValue = _readRaw<double> (value->data); return true;
+                default: ARA_INTERNAL_ASSERT (false && "IPC value type mismatch"); break;
+            }
+        }
+        argValue = 0.0;
+        return false;
+    }
+
+    bool readFloat (ARAIPCMessageKey argKey, float& argValue) const
+    {
+        // reading directly avoids double rounding issues
+        const auto value { _find (argKey) };
+        if (value && (value->type == _ValueType::float32))
+        {
+            argValue = _readRaw<float> (value->data);
+            return true;
+        }
+        double tmp;
+        const auto found { readFloatingPoint (argKey, tmp) };
+        argValue = static_cast<float> (tmp);
+        return found;
+    }
+
+    const char* readString (ARAIPCMessageKey argKey) const
+    {
+        const auto value { _find (argKey) };
+        if (!value)
+            return nullptr;
+        ARA_INTERNAL_ASSERT (value->type == _ValueType::string);
+        return (value->type == _ValueType::string) ? reinterpret_cast<const char*> (value->data) : nullptr;
+    }
+
+    const DecodedValue* findBytes (ARAIPCMessageKey argKey) const
+    {
+        const auto value { _find (argKey) };
+        if (!value)
+            return nullptr;
+        ARA_INTERNAL_ASSERT ((value->type == _ValueType::bytes) || (value->type == _ValueType::mappedBytes));
+        return ((value->type == _ValueType::bytes) || (value->type == _ValueType::mappedBytes)) ? value : nullptr;
+    }
+
+    _MessageDecoder* createSubMessageDecoder (ARAIPCMessageKey argKey) const
+    {
+        const auto value { _find (argKey) };
+        if (!value || (value->type != _ValueType::subMessage))
+            return nullptr;
+        return new _MessageDecoder { _message, value->data, value->size };
+    }
+
+    _MessageDecoder (const _MessageDecoder& other) = delete;
+    _MessageDecoder& operator= (const _MessageDecoder& other) = delete;
+
+private:
+    const DecodedValue* _find (ARAIPCMessageKey argKey) const
+    {
+        auto it { std::upper_bound (_values.begin (), _values.end (), argKey,
+                                    [] (ARAIPCMessageKey key, const DecodedValue& value) { return key < value.key; }) };
+        if ((it == _values.begin ()) || ((--it)->key != argKey))
+            return nullptr;
+        return &(*it);
+    }
+
+private:
+    std::shared_ptr<const _ReceivedMessage> _message;
+    std::vector<DecodedValue> _values;
+};
+
+
+//------------------------------------------------------------------------------
+// C adapters for en- and decoder
+//------------------------------------------------------------------------------
+
+extern "C" {
+
+inline ARAIPCMessageEncoderRef _toEncoderRef (_MessageEncoder* encoder)
+{
+    return reinterpret_cast<ARAIPCMessageEncoderRef> (encoder);
+}
+
+inline _MessageEncoder* _fromEncoderRef (ARAIPCMessageEncoderRef messageEncoderRef)
+{
+    return reinterpret_cast<_MessageEncoder*> (messageEncoderRef);
+}
+
+static void ARA_CALL ARAIPCUnixSocketDestroyEncoder (ARAIPCMessageEncoderRef messageEncoderRef)
+{
+    if (messageEncoderRef)
+        _fromEncoderRef (messageEncoderRef)->release ();
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendInt32 (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, int32_t argValue)
+{
+    _fromEncoderRef (messageEncoderRef)->appendNumber (argKey, _ValueType::int32, argValue);
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendInt64 (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, int64_t argValue)
+{
+    _fromEncoderRef (messageEncoderRef)->appendNumber (argKey, _ValueType::int64, argValue);
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendSize (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, size_t argValue)
+{
+    _fromEncoderRef (messageEncoderRef)->appendNumber (argKey, _ValueType::size, static_cast<uint64_t> (argValue));
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendFloat (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, float argValue)
+{
+    _fromEncoderRef (messageEncoderRef)->appendNumber (argKey, _ValueType::float32, argValue);
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendDouble (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, double argValue)
+{
+    _fromEncoderRef (messageEncoderRef)->appendNumber (argKey, _ValueType::float64, argValue);
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendString (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, const char* argValue)
+{
+    _fromEncoderRef (messageEncoderRef)->appendString (argKey, argValue);
+}
+
+static void ARA_CALL ARAIPCUnixSocketAppendBytes (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey, const uint8_t* argValue, size_t argSize, bool copy)
+{
+    _fromEncoderRef (messageEncoderRef)->appendBytes (argKey, argValue, argSize, copy);
+}
+
+static ARAIPCMessageEncoderRef ARA_CALL ARAIPCUnixSocketAppendSubMessage (ARAIPCMessageEncoderRef messageEncoderRef, ARAIPCMessageKey argKey)
+{
+    return _toEncoderRef (_fromEncoderRef (messageEncoderRef)->appendSubMessage (argKey));
+}
+
+}   // extern "C"
+
+static ARAIPCMessageEncoder _createMessageEncoder ()
+{
+    static const ARAIPCMessageEncoderInterface encoderMethods
+    {
+        ARAIPCUnixSocketDestroyEncoder,
+        ARAIPCUnixSocketAppendInt32,
+        ARAIPCUnixSocketAppendInt64,
+        ARAIPCUnixSocketAppendSize,
+        ARAIPCUnixSocketAppendFloat,
+        ARAIPCUnixSocketAppendDouble,
+        ARAIPCUnixSocketAppendString,
+        ARAIPCUnixSocketAppendBytes,
+        ARAIPCUnixSocketAppendSubMessage
+    };
+
+    return { _toEncoderRef (new _MessageEncoder), &encoderMethods };
+}
+
+extern "C" {
+
+
+inline ARAIPCMessageDecoderRef _toDecoderRef (_MessageDecoder* decoder)
+{
+    return reinterpret_cast<ARAIPCMessageDecoderRef> (decoder);
+}
+
+inline const _MessageDecoder* _fromDecoderRef (ARAIPCMessageDecoderRef messageDecoderRef)
+{
+    return reinterpret_cast<const _MessageDecoder*> (messageDecoderRef);
+}
+
+static void ARA_CALL ARAIPCUnixSocketDestroyDecoder (ARAIPCMessageDecoderRef messageDecoderRef)
+{
+    delete _fromDecoderRef (messageDecoderRef);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketIsEmpty (ARAIPCMessageDecoderRef messageDecoderRef)
+{
+    return (!messageDecoderRef) || _fromDecoderRef (messageDecoderRef)->isEmpty ();
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadInt32 (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, int32_t* argValue)
+{
+    int64_t tmp;
+    const auto found { _fromDecoderRef (messageDecoderRef)->readInteger (argKey, tmp) };
+    ARA_INTERNAL_ASSERT ((INT32_MIN <= tmp) && (tmp <= INT32_MAX));
+    *argValue = static_cast<int32_t> (tmp);
+    return found;
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadInt64 (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, int64_t* argValue)
+{
+    return _fromDecoderRef (messageDecoderRef)->readInteger (argKey, *argValue);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadSize (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, size_t* argValue)
+{
+    int64_t tmp;
+    const auto found { _fromDecoderRef (messageDecoderRef)->readInteger (argKey, tmp) };
+    *argValue = static_cast<size_t> (tmp);
+    return found;
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadFloat (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, float* argValue)
+{
+    return _fromDecoderRef (messageDecoderRef)->readFloat (argKey, *argValue);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadDouble (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, double* argValue)
+{
+    return _fromDecoderRef (messageDecoderRef)->readFloatingPoint (argKey, *argValue);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadString (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, const char** argValue)
+{
+    *argValue = _fromDecoderRef (messageDecoderRef)->readString (argKey);
+    return (*argValue != nullptr);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReadBytesSize (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, size_t* argSize)
+{
+    const auto value { _fromDecoderRef (messageDecoderRef)->findBytes (argKey) };
+    *argSize = (value) ? value->size : 0;
+    return (value != nullptr);
+}
+
+static void ARA_CALL ARAIPCUnixSocketReadBytes (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey, uint8_t* argValue)
+{
+    const auto value { _fromDecoderRef (messageDecoderRef)->findBytes (argKey) };
+    ARA_INTERNAL_ASSERT (value != nullptr);
+    if (value)
+        std::memcpy (argValue, value->data, value->size);
+}
+
+static ARAIPCMessageDecoderRef ARA_CALL ARAIPCUnixSocketReadSubMessage (ARAIPCMessageDecoderRef messageDecoderRef, ARAIPCMessageKey argKey)
+{
+    return _toDecoderRef (_fromDecoderRef (messageDecoderRef)->createSubMessageDecoder (argKey));
+}
+
+}   // extern "C"
+
+static ARAIPCMessageDecoder _createMessageDecoder (std::shared_ptr<const _ReceivedMessage> message)
+{
+    static const ARAIPCMessageDecoderInterface decoderMethods
+    {
+        ARAIPCUnixSocketDestroyDecoder,
+        ARAIPCUnixSocketIsEmpty,
+        ARAIPCUnixSocketReadInt32,
+        ARAIPCUnixSocketReadInt64,
+        ARAIPCUnixSocketReadSize,
+        ARAIPCUnixSocketReadFloat,
+        ARAIPCUnixSocketReadDouble,
+        ARAIPCUnixSocketReadString,
+        ARAIPCUnixSocketReadBytesSize,
+        ARAIPCUnixSocketReadBytes,
+        ARAIPCUnixSocketReadSubMessage
+    };
+
+    const auto payload { message->getPayload () };
+    const auto payloadSize { message->getPayloadSize () };
+    return { _toDecoderRef (new _MessageDecoder { std::move (message), payload, payloadSize }), &decoderMethods };
+}
+
+
+//------------------------------------------------------------------------------
+// socket I/O
+//------------------------------------------------------------------------------
+
+struct _ReceivedFrame
+{
+    ARAIPCMessageID messageID;
+    uint32_t flags;
+    uint32_t streamID;
+    uint32_t sequenceNumber;
+    std::shared_ptr<const _ReceivedMessage> message;
+};
+
+// send a message or reply, returns false if the connection is broken or the payload could not be sent
+static bool _sendFrame (int socketFD, uint32_t streamID, uint32_t sequenceNumber, ARAIPCMessageID messageID, const _MessageEncoder* encoder, uint32_t flags = 0)
+{
+    std::vector<uint8_t> payload;
+    std::vector<int> fileDescriptors;
+    if (encoder)
+        encoder->serialize (payload, fileDescriptors);
+
+    _FrameHeader header { kFrameMagic, messageID, flags, 0, streamID, sequenceNumber, payload.size () };
+    if (payload.size () > kMaxInlinePayloadSize)
+    {
+        // the receiver cannot read larger inline payloads, so the frame must not be sent without memfd
+        const auto fd { _createSealedMemFD (payload.data (), payload.size ()) };
+        if (fd < 0)
+        {
+            ARA_WARN ("failed to send IPC message with payload size %zu", payload.size ());
+            for (const auto fileDescriptor : fileDescriptors)
+                ::close (fileDescriptor);
+            return false;
+        }
+        fileDescriptors.push_back (fd);
+        header.flags |= kFrameFlagPayloadIsMapped;
+    }
+    header.fileDescriptorsCount = static_cast<uint32_t> (fileDescriptors.size ());
+
+    iovec iov[2] {};
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof (header);
+    iov[1].iov_base = payload.data ();
+    iov[1].iov_len = ((header.flags & kFrameFlagPayloadIsMapped) != 0) ? 0 : payload.size ();
+
+    msghdr message {};
+    message.msg_iov = iov;
+    message.msg_iovlen = (iov[1].iov_len > 0) ? 2 : 1;
+
+    std::vector<uint8_t> controlBuffer;
+    if (!fileDescriptors.empty ())
+    {
+        const auto fdsSize { fileDescriptors.size () * sizeof (int) };
+        controlBuffer.resize (CMSG_SPACE (fdsSize));
+        message.msg_control = controlBuffer.data ();
+        message.msg_controllen = controlBuffer.size ();
+        auto controlMessage { CMSG_FIRSTHDR (&message) };
+        controlMessage->cmsg_level = SOL_SOCKET;
+        controlMessage->cmsg_type = SCM_RIGHTS;
+        controlMessage->cmsg_len = CMSG_LEN (fdsSize);
+        std::memcpy (CMSG_DATA (controlMessage), fileDescriptors.data (), fdsSize);
+    }
+
+    ssize_t result;
+    do
+    {
+        result = sendmsg (socketFD, &message, MSG_NOSIGNAL);
+    } while ((result < 0) && (errno == EINTR));
+
+    // the descriptors have been duplicated into the receiving process (if sending succeeded)
+    for (const auto fd : fileDescriptors)
+        ::close (fd);
+
+    if (result < 0)
+    {
+        ARA_WARN ("sending IPC message failed with error %i", errno);
+        return false;
+    }
+    return true;
+}
+
+// blocking receive of the next message or reply, returns false if the connection is broken
+static bool _receiveFrame (int socketFD, std::vector<uint8_t>& receiveBuffer, _ReceivedFrame& frame)
+{
+    receiveBuffer.resize (sizeof (_FrameHeader) + kMaxInlinePayloadSize);
+    alignas (cmsghdr) uint8_t controlBuffer[CMSG_SPACE ((kMaxFileDescriptorsPerFrame + 1) * sizeof (int))];
+
+    iovec iov { receiveBuffer.data (), receiveBuffer.size () };
+    msghdr message {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = controlBuffer;
+    message.msg_controllen = sizeof (controlBuffer);
+
+    ssize_t result;
+    do
+    {
+        result = recvmsg (socketFD, &message, MSG_CMSG_CLOEXEC);
+    } while ((result < 0) && (errno == EINTR));
+    if (result <= 0)
+        return false;
+
+    // take ownership of all received file descriptors, mapping them into memory
+    std::vector<std::unique_ptr<_MappedFile>> mappedFiles;
+    for (auto controlMessage { CMSG_FIRSTHDR (&message) }; controlMessage != nullptr; controlMessage = CMSG_NXTHDR (&message, controlMessage))
+    {
+        if ((controlMessage->cmsg_level != SOL_SOCKET) || (controlMessage->cmsg_type != SCM_RIGHTS))
+            continue;
+        const auto fdsCount { (controlMessage->cmsg_len - CMSG_LEN (0)) / sizeof (int) };
+        for (auto i { 0U }; i < fdsCount; ++i)
+        {
+            int fd;
+            std::memcpy (&fd, CMSG_DATA (controlMessage) + i * sizeof (int), sizeof (int));
+            mappedFiles.emplace_back (new _MappedFile { fd });
+            ::close (fd);
+        }
+    }
+
+    const auto receivedSize { static_cast<size_t> (result) };
+    _FrameHeader header;
+    if ((receivedSize < sizeof (header)) || ((message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0))
+    {
+        ARA_INTERNAL_ASSERT (false && "received truncated IPC message");
+        return false;
+    }
+    std::memcpy (&header, receiveBuffer.data (), sizeof (header));
+    const auto payloadIsMapped { (header.flags & kFrameFlagPayloadIsMapped) != 0 };
+    if ((header.magic != kFrameMagic) ||
+        (header.fileDescriptorsCount != mappedFiles.size ()) ||
+        (!payloadIsMapped && (header.payloadSize != receivedSize - sizeof (header))))
+    {
+        ARA_INTERNAL_ASSERT (false && "received invalid IPC message");
+        return false;
+    }
+
+    std::vector<uint8_t> inlinePayload;
+    if (!payloadIsMapped)
+        inlinePayload.assign (receiveBuffer.begin () + sizeof (header), receiveBuffer.begin () + static_cast<std::ptrdiff_t> (receivedSize));
+
+    frame.messageID = header.messageID;
+    frame.flags = header.flags;
+    frame.streamID = header.streamID;
+    frame.sequenceNumber = header.sequenceNumber;
+    frame.message = std::make_shared<const _ReceivedMessage> (std::move (inlinePayload), std::move (mappedFiles), payloadIsMapped);
+    return true;
+}
+
+
+//------------------------------------------------------------------------------
+// channel
+//------------------------------------------------------------------------------
+
+// logical stream multiplexed over a channel, with its own message ordering and queues
+// All mutable state is guarded by the stateMutex of the channel.
+struct ARAIPCUnixSocketStreamImplementation
+{
+    ARAIPCUnixSocketStreamImplementation (ARAIPCUnixSocketChannelImplementation* owningChannel, uint32_t id)
+    : channel { owningChannel },
+      streamID { id }
+    {}
+
+    void handleMessage (const _ReceivedFrame& frame);
+    bool sendMessage (ARAIPCMessageID messageID, const _MessageEncoder* encoder, ARAIPCReplyHandler* const replyHandler, void* replyHandlerUserData,
+                      int32_t timeoutMilliseconds);
+    bool processReceivedMessages (int32_t timeoutMilliseconds);
+
+    // must be called with stateMutex locked after a send (or a wait for one-way credits) is done
+    void endPendingSend ();
+
+    // wait until predicate is met, or until deadline if timeoutMilliseconds > 0 - returns false upon timeout
+    template<typename PredicateT>
+    bool waitForState (std::unique_lock<std::mutex>& stateLock, int32_t timeoutMilliseconds,
+                       std::chrono::steady_clock::time_point deadline, PredicateT predicate);
+
+    ARAIPCUnixSocketChannelImplementation* const channel;
+    const uint32_t streamID;
+
+    std::condition_variable stateCondition {};
+    uint32_t nextSequenceNumber { 0 };
+    int pendingSendsCount { 0 };                // count of (stacked) sends awaiting their reply or one-way credits
+    int32_t unacknowledgedMessagesCount { 0 };  // count of one-way messages in flight
+    int32_t timedOutSendsCount { 0 };           // count of sends that gave up waiting for their reply
+    int32_t droppedRepliesCount { 0 };          // count of replies that arrived after their send timed out
+    std::vector<uint32_t> abandonedSequenceNumbers {};  // sends whose late reply must be dropped
+    std::deque<_ReceivedFrame> replies {};
+    std::deque<_ReceivedFrame> stackedMessages {};  // messages received while waiting for a reply
+    std::deque<_ReceivedFrame> queuedMessages {};   // messages received while no send is pending
+};
+
+struct ARAIPCUnixSocketChannelImplementation
+{
+    ARAIPCUnixSocketChannelImplementation (int fd, ARAIPCMessageReceiver messageReceiver)
+    : socketFD { fd },
+      receiver { messageReceiver }
+    {
+        streams.emplace (kDefaultStreamID, std::unique_ptr<ARAIPCUnixSocketStreamImplementation> { defaultStream });
+    }
+
+    void readMessages ();
+
+    // must be called with stateMutex locked
+    ARAIPCUnixSocketStreamImplementation* getOrCreateStream (uint32_t streamID);
+    void notifyAllStreams ();
+
+    const int socketFD;
+    const ARAIPCMessageReceiver receiver;
+    std::thread readerThread {};
+
+    std::mutex writeMutex {};                   // serializes writing to the socket
+    std::mutex stateMutex {};                   // guards all members below and the state of all streams
+    bool isConnected { true };
+    int32_t oneWayWindowSize { 0 };             // max. count of unacknowledged one-way messages per stream, 0 if disabled
+    ARAIPCUnixSocketStreamImplementation* const defaultStream { new ARAIPCUnixSocketStreamImplementation { this, kDefaultStreamID } };
+    std::map<uint32_t, std::unique_ptr<ARAIPCUnixSocketStreamImplementation>> streams {};
+};
+
+// stream whose message currently is being handled on this thread, if any
+static thread_local ARAIPCUnixSocketStreamImplementation* _currentHandlingStream { nullptr };
+
+ARAIPCUnixSocketStreamImplementation* ARAIPCUnixSocketChannelImplementation::getOrCreateStream (uint32_t streamID)
+{
+    // streams are created implicitly when receiving their first message, since the remote side
+    // may start sending before the local side has created its end of the stream
+    auto& stream { streams[streamID] };
+    if (!stream)
+        stream.reset (new ARAIPCUnixSocketStreamImplementation { this, streamID });
+    return stream.get ();
+}
+
+void ARAIPCUnixSocketChannelImplementation::notifyAllStreams ()
+{
+    for (const auto& stream : streams)
+        stream.second->stateCondition.notify_all ();
+}
+
+void ARAIPCUnixSocketChannelImplementation::readMessages ()
+{
+    std::vector<uint8_t> receiveBuffer;
+    _ReceivedFrame frame;
+    while (_receiveFrame (socketFD, receiveBuffer, frame))
+    {
+        std::lock_guard<std::mutex> lock { stateMutex };
+        auto stream { getOrCreateStream (frame.streamID) };
+        if ((frame.flags & kFrameFlagAcknowledge) != 0)
+        {
+            ARA_INTERNAL_ASSERT (stream->unacknowledgedMessagesCount > 0);
+            --stream->unacknowledgedMessagesCount;
+        }
+        else if (frame.messageID == kReplyMessageID)
+        {
+            const auto abandoned { std::find (stream->abandonedSequenceNumbers.begin (), stream->abandonedSequenceNumbers.end (), frame.sequenceNumber) };
+            if (abandoned != stream->abandonedSequenceNumbers.end ())
+            {
+                // the send has timed out already, discard the late reply (including any mapped payload)
+                stream->abandonedSequenceNumbers.erase (abandoned);
+                ++stream->droppedRepliesCount;
+                continue;
+            }
+            ARA_INTERNAL_ASSERT (stream->pendingSendsCount > 0);
+            stream->replies.emplace_back (std::move (frame));
+        }
+        else if (stream->pendingSendsCount > 0)
+        {
+            stream->stackedMessages.emplace_back (std::move (frame));
+        }
+        else
+        {
+            stream->queuedMessages.emplace_back (std::move (frame));
+        }
+        stream->stateCondition.notify_all ();
+    }
+
+    std::lock_guard<std::mutex> lock { stateMutex };
+    isConnected = false;
+    for (const auto& stream : streams)
+        stream.second->abandonedSequenceNumbers.clear ();   // no more replies will arrive
+    notifyAllStreams ();
+}
+
+void ARAIPCUnixSocketStreamImplementation::handleMessage (const _ReceivedFrame& frame)
+{
+    auto decoder { _createMessageDecoder (frame.message) };
+    auto replyEncoder { _createMessageEncoder () };
+    const auto previousHandlingStream { _currentHandlingStream };
+    _currentHandlingStream = this;
+    channel->receiver (frame.messageID, decoder, &replyEncoder);
+    _currentHandlingStream = previousHandlingStream;
+    {
+        // one-way messages are only acknowledged, any reply is discarded
+        std::lock_guard<std::mutex> lock { channel->writeMutex };
+        if ((frame.flags & kFrameFlagOneWay) != 0)
+            _sendFrame (channel->socketFD, streamID, frame.sequenceNumber, kReplyMessageID, nullptr, kFrameFlagAcknowledge);
+        else if (!_sendFrame (channel->socketFD, streamID, frame.sequenceNumber, kReplyMessageID, _fromEncoderRef (replyEncoder.ref)))
+            _sendFrame (channel->socketFD, streamID, frame.sequenceNumber, kReplyMessageID, nullptr, kFrameFlagReplyFailed);   // the sender must not wait forever
+    }
+    replyEncoder.methods->destroyEncoder (replyEncoder.ref);
+    decoder.methods->destroyDecoder (decoder.ref);
+}
+
+template<typename PredicateT>
+bool ARAIPCUnixSocketStreamImplementation::waitForState (std::unique_lock<std::mutex>& stateLock, int32_t timeoutMilliseconds,
+                                                         std::chrono::steady_clock::time_point deadline, PredicateT predicate)
+{
+    if (timeoutMilliseconds <= 0)
+    {
+        stateCondition.wait (stateLock, predicate);
+        return true;
+    }
+    return stateCondition.wait_until (stateLock, deadline, predicate);
+}
+
+bool ARAIPCUnixSocketStreamImplementation::sendMessage (ARAIPCMessageID messageID, const _MessageEncoder* encoder, ARAIPCReplyHandler* const replyHandler, void* replyHandlerUserData,
+                                                        int32_t timeoutMilliseconds)
+{
+    ARA_INTERNAL_ASSERT ((kARAIPCMessageIDRangeStart <= messageID) && (messageID < kARAIPCMessageIDRangeEnd));
+
+    const auto deadline { std::chrono::steady_clock::now () + std::chrono::milliseconds { std::max (timeoutMilliseconds, int32_t { 0 }) } };
+
+    std::unique_lock<std::mutex> stateLock { channel->stateMutex };
+    if (!channel->isConnected)
+        return false;
+
+    const auto sequenceNumber { nextSequenceNumber++ };
+
+    // if enabled, messages that do not expect a reply are sent without waiting for it,
+    // blocking only if the remote side falls behind by more than the flow control window
+    if ((replyHandler == nullptr) && (channel->oneWayWindowSize > 0))
+    {
+        // while the window is full, incoming messages are handled like when waiting for a reply:
+        // the remote side may not be able to return credits before they have been handled, e.g. if
+        // it is waiting for a reply, or if this is the thread processing the received messages
+        const auto hasCredit { [this] { return (unacknowledgedMessagesCount < channel->oneWayWindowSize) || !channel->isConnected; } };
+        if (!hasCredit ())
+        {
+            ++pendingSendsCount;
+            bool didTimeOut { false };
+            while (!hasCredit ())
+            {
+                if (!waitForState (stateLock, timeoutMilliseconds, deadline,
+                                   [this, &hasCredit] { return hasCredit () || !stackedMessages.empty () || !queuedMessages.empty (); }))
+                {
+                    didTimeOut = true;
+                    break;
+                }
+
+                auto& messages { (!stackedMessages.empty ()) ? stackedMessages : queuedMessages };
+                if (!messages.empty ())
+                {
+                    const auto frame { std::move (messages.front ()) };
+                    messages.pop_front ();
+                    stateLock.unlock ();
+                    handleMessage (frame);
+                    stateLock.lock ();
+                }
+            }
+            endPendingSend ();
+            if (didTimeOut)
+            {
+                ++timedOutSendsCount;
+                return false;
+            }
+        }
+        if (!channel->isConnected)
+            return false;
+        ++unacknowledgedMessagesCount;
+        stateLock.unlock ();
+
+        bool didSend;
+        {
+            std::lock_guard<std::mutex> writeLock { channel->writeMutex };
+            didSend = _sendFrame (channel->socketFD, streamID, sequenceNumber, messageID, encoder, kFrameFlagOneWay);
+        }
+        if (!didSend)
+        {
+            // no acknowledgement will arrive, return the credit
+            stateLock.lock ();
+            --unacknowledgedMessagesCount;
+        }
+        return didSend;
+    }
+
+    ++pendingSendsCount;
+    stateLock.unlock ();
+
+    bool didSend;
+    {
+        std::lock_guard<std::mutex> writeLock { channel->writeMutex };
+        didSend = _sendFrame (channel->socketFD, streamID, sequenceNumber, messageID, encoder);
+    }
+
+    stateLock.lock ();
+    const auto findReply { [this, sequenceNumber] ()
+        {
+            return std::find_if (replies.begin (), replies.end (), [sequenceNumber] (const _ReceivedFrame& frame) { return frame.sequenceNumber == sequenceNumber; });
+        } };
+    _ReceivedFrame reply {};
+    bool didReceiveReply { false };
+    while (didSend)
+    {
+        if (!waitForState (stateLock, timeoutMilliseconds, deadline,
+                           [this, &findReply] { return (findReply () != replies.end ()) || !stackedMessages.empty () || !channel->isConnected; }))
+        {
+            // give up waiting - the reply will be dropped by the reader thread when it arrives
+            abandonedSequenceNumbers.emplace_back (sequenceNumber);
+            ++timedOutSendsCount;
+            break;
+        }
+
+        // handle any messages that the remote side sends while processing our message
+        if (!stackedMessages.empty ())
+        {
+            const auto frame { std::move (stackedMessages.front ()) };
+            stackedMessages.pop_front ();
+            stateLock.unlock ();
+            handleMessage (frame);
+            stateLock.lock ();
+            continue;
+        }
+
+        const auto it { findReply () };
+        if (it != replies.end ())
+        {
+            reply = std::move (*it);
+            replies.erase (it);
+            didReceiveReply = ((reply.flags & kFrameFlagReplyFailed) == 0);
+        }
+        break;
+    }
+
+    endPendingSend ();
+    stateLock.unlock ();
+
+    if (didReceiveReply && reply.message && replyHandler)
+    {
+        auto decoder { _createMessageDecoder (reply.message) };
+        (*replyHandler) (decoder, replyHandlerUserData);
+        decoder.methods->destroyDecoder (decoder.ref);
+    }
+    return didReceiveReply;
+}
+
+void ARAIPCUnixSocketStreamImplementation::endPendingSend ()
+{
+    // any messages that arrive after the outermost reply are not stacked, but regular messages
+    if (--pendingSendsCount == 0)
+    {
+        queuedMessages.insert (queuedMessages.end (), stackedMessages.begin (), stackedMessages.end ());
+        stackedMessages.clear ();
+        if (!queuedMessages.empty ())
+            stateCondition.notify_all ();
+    }
+}
+
+bool ARAIPCUnixSocketStreamImplementation::processReceivedMessages (int32_t timeoutMilliseconds)
+{
+    std::unique_lock<std::mutex> stateLock { channel->stateMutex };
+    if (queuedMessages.empty () && (timeoutMilliseconds > 0))
+        stateCondition.wait_for (stateLock, std::chrono::milliseconds { timeoutMilliseconds },
+                                 [this] { return !queuedMessages.empty () || !channel->isConnected; });
+
+    while (!queuedMessages.empty ())
+    {
+        const auto frame { std::move (queuedMessages.front ()) };
+        queuedMessages.pop_front ();
+        stateLock.unlock ();
+        handleMessage (frame);
+        stateLock.lock ();
+    }
+    return channel->isConnected;
+}
+
+
+//------------------------------------------------------------------------------
+// C API
+//------------------------------------------------------------------------------
+
+extern "C" {
+
+inline ARAIPCMessageSenderRef _toSenderRef (ARAIPCUnixSocketStreamRef streamRef)
+{
+    return reinterpret_cast<ARAIPCMessageSenderRef> (streamRef);
+}
+
+inline ARAIPCUnixSocketStreamRef _fromSenderRef (ARAIPCMessageSenderRef messageSenderRef)
+{
+    return reinterpret_cast<ARAIPCUnixSocketStreamRef> (messageSenderRef);
+}
+
+static ARAIPCMessageEncoder ARA_CALL ARAIPCUnixSocketCreateEncoder (ARAIPCMessageSenderRef /*messageSenderRef*/)
+{
+    return _createMessageEncoder ();
+}
+
+static void ARA_CALL ARAIPCUnixSocketSendMessage (const bool /*stackable*/, ARAIPCMessageSenderRef messageSenderRef, ARAIPCMessageID messageID,
+                                                  const ARAIPCMessageEncoder* encoder, ARAIPCReplyHandler* const replyHandler, void* replyHandlerUserData)
+{
+    _fromSenderRef (messageSenderRef)->sendMessage (messageID, (encoder) ? _fromEncoderRef (encoder->ref) : nullptr, replyHandler, replyHandlerUserData, 0);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketSendMessageWithTimeout (const bool /*stackable*/, ARAIPCMessageSenderRef messageSenderRef, ARAIPCMessageID messageID,
+                                                             const ARAIPCMessageEncoder* encoder, ARAIPCReplyHandler* const replyHandler, void* replyHandlerUserData,
+                                                             int32_t timeoutMilliseconds)
+{
+    return _fromSenderRef (messageSenderRef)->sendMessage (messageID, (encoder) ? _fromEncoderRef (encoder->ref) : nullptr, replyHandler, replyHandlerUserData, timeoutMilliseconds);
+}
+
+static bool ARA_CALL ARAIPCUnixSocketReceiverEndianessMatches (ARAIPCMessageSenderRef /*messageSenderRef*/)
+{
+    // both ends of a Unix domain socket run on the same machine
+    return true;
+}
+
+static bool ARA_CALL ARAIPCUnixSocketIsReceiverConnected (ARAIPCMessageSenderRef messageSenderRef)
+{
+    return ARAIPCUnixSocketIsConnected (_fromSenderRef (messageSenderRef)->channel);
+}
+
+static void ARA_CALL ARAIPCUnixSocketGetStatistics (ARAIPCMessageSenderRef messageSenderRef, ARAIPCMessageSenderStatistics* statistics)
+{
+    const auto stream { _fromSenderRef (messageSenderRef) };
+    std::lock_guard<std::mutex> lock { stream->channel->stateMutex };
+    statistics->timedOutSendsCount = stream->timedOutSendsCount;
+    statistics->droppedRepliesCount = stream->droppedRepliesCount;
+}
+
+bool ARA_CALL ARAIPCUnixSocketCreateSocketPair (int socketFDs[2])
+{
+    return socketpair (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, socketFDs) == 0;
+}
+
+ARAIPCUnixSocketChannelRef ARA_CALL ARAIPCUnixSocketCreateChannel (int socketFD, ARAIPCMessageReceiver receiver)
+{
+    auto channel { new ARAIPCUnixSocketChannelImplementation { socketFD, receiver } };
+    channel->readerThread = std::thread { &ARAIPCUnixSocketChannelImplementation::readMessages, channel };
+    return channel;
+}
+
+void ARA_CALL ARAIPCUnixSocketDestroyChannel (ARAIPCUnixSocketChannelRef channelRef)
+{
+    // shutting down the socket wakes up the reader thread
+    shutdown (channelRef->socketFD, SHUT_RDWR);
+    channelRef->readerThread.join ();
+    ::close (channelRef->socketFD);
+    delete channelRef;
+}
+
+ARAIPCMessageSender ARA_CALL ARAIPCUnixSocketGetMessageSender (ARAIPCUnixSocketChannelRef channelRef)
+{
+    return ARAIPCUnixSocketGetStreamMessageSender (channelRef->defaultStream);
+}
+
+bool ARA_CALL ARAIPCUnixSocketProcessReceivedMessages (ARAIPCUnixSocketChannelRef channelRef, int32_t timeoutMilliseconds)
+{
+    return channelRef->defaultStream->processReceivedMessages (timeoutMilliseconds);
+}
+
+bool ARA_CALL ARAIPCUnixSocketIsConnected (ARAIPCUnixSocketChannelRef channelRef)
+{
+    std::lock_guard<std::mutex> lock { channelRef->stateMutex };
+    return channelRef->isConnected;
+}
+
+void ARA_CALL ARAIPCUnixSocketSetOneWayWindowSize (ARAIPCUnixSocketChannelRef channelRef, int32_t windowSize)
+{
+    ARA_INTERNAL_ASSERT (windowSize >= 0);
+    std::lock_guard<std::mutex> lock { channelRef->stateMutex };
+    channelRef->oneWayWindowSize = std::max (windowSize, int32_t { 0 });
+    channelRef->notifyAllStreams ();
+}
+
+void ARA_CALL ARAIPCUnixSocketGetQueueDepths (ARAIPCUnixSocketChannelRef channelRef, ARAIPCUnixSocketQueueDepths* queueDepths)
+{
+    std::lock_guard<std::mutex> lock { channelRef->stateMutex };
+    *queueDepths = {};
+    for (const auto& stream : channelRef->streams)
+    {
+        queueDepths->unacknowledgedMessagesCount += stream.second->unacknowledgedMessagesCount;
+        queueDepths->pendingSendsCount += stream.second->pendingSendsCount;
+        queueDepths->stackedMessagesCount += static_cast<int32_t> (stream.second->stackedMessages.size ());
+        queueDepths->queuedMessagesCount += static_cast<int32_t> (stream.second->queuedMessages.size ());
+        queueDepths->timedOutSendsCount += stream.second->timedOutSendsCount;
+        queueDepths->droppedRepliesCount += stream.second->droppedRepliesCount;
+    }
+}
+
+ARAIPCUnixSocketStreamRef ARA_CALL ARAIPCUnixSocketCreateStream (ARAIPCUnixSocketChannelRef channelRef, uint32_t streamID)
+{
+    ARA_INTERNAL_ASSERT (streamID != kDefaultStreamID);
+    std::lock_guard<std::mutex> lock { channelRef->stateMutex };
+    return channelRef->getOrCreateStream (streamID);
+}
+
+void ARA_CALL ARAIPCUnixSocketDestroyStream (ARAIPCUnixSocketStreamRef streamRef)
+{
+    ARA_INTERNAL_ASSERT (streamRef->streamID != kDefaultStreamID);
+    auto channel { streamRef->channel };
+    std::lock_guard<std::mutex> lock { channel->stateMutex };
+    ARA_INTERNAL_ASSERT (streamRef->pendingSendsCount == 0);
+    ARA_INTERNAL_ASSERT (streamRef->queuedMessages.empty ());
+    channel->streams.erase (streamRef->streamID);
+}
+
+ARAIPCMessageSender ARA_CALL ARAIPCUnixSocketGetStreamMessageSender (ARAIPCUnixSocketStreamRef streamRef)
+{
+    static const ARAIPCMessageSenderInterface senderMethods
+    {
+        ARAIPCUnixSocketCreateEncoder,
+        ARAIPCUnixSocketSendMessage,
+        ARAIPCUnixSocketReceiverEndianessMatches,
+        ARAIPCUnixSocketSendMessageWithTimeout,
+        ARAIPCUnixSocketIsReceiverConnected,
+        ARAIPCUnixSocketGetStatistics
+    };
+
+    return { _toSenderRef (streamRef), &senderMethods };
+}
+
+bool ARA_CALL ARAIPCUnixSocketProcessReceivedStreamMessages (ARAIPCUnixSocketStreamRef streamRef, int32_t timeoutMilliseconds)
+{
+    return streamRef->processReceivedMessages (timeoutMilliseconds);
+}
+
+ARAIPCUnixSocketStreamRef ARA_CALL ARAIPCUnixSocketGetHandlingStream (void)
+{
+    return _currentHandlingStream;
+}
+
+}   // extern "C"
+}   // namespace IPC
+}   // namespace ARA
+
+#endif // ARA_ENABLE_IPC && defined (__linux__)
@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+//! \file       ARAIPCUnixSocket.h
+//!             Implementation of ARAIPCMessageSender based on Unix domain sockets,
+//!             passing bulk data via memfd file descriptors
+//! \project    ARA SDK Examples
+//! \copyright  Copyright (c) 2021-2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARAIPCUnixSocket_h
+#define ARAIPCUnixSocket_h
+
+#include "ARA_Library/IPC/ARAIPC.h"
+
+
+#if ARA_ENABLE_IPC && defined(__linux__)
+
+
+#if defined(__cplusplus)
+namespace ARA {
+namespace IPC {
+extern "C" {
+#endif
+
+
+//! Unix Domain Socket Channel
+//! Messages are exchanged as datagrams over a connected SOCK_SEQPACKET Unix domain socket.
+//! Small messages are sent inline, whereas large raw byte arguments (such as audio samples,
+//! archive data or bulk content) are written into sealed memfd files whose descriptors are
+//! passed along with the message via SCM_RIGHTS, so that the receiver can map them instead of
+//! copying them through the socket buffers. Messages that still are too large to be sent
+//! inline after this are transferred through a memfd file as a whole.
+//! Since both ends of a Unix domain socket reside on the same machine, all values are encoded
+//! in native byte order.
+//! Each channel owns a reader thread that routes incoming replies to the thread waiting in
+//! ARAIPCMessageSenderInterface::sendMessage(). Incoming messages that arrive while a send is
+//! pending are considered to be stacked and are handled on the sending thread, all other
+//! messages are queued for ARAIPCUnixSocketProcessReceivedMessages().
+//! Several independent logical streams can be multiplexed over a channel, see below.
+//! @{
+
+//! opaque token representing an instance of a Unix domain socket channel
+typedef struct ARAIPCUnixSocketChannelImplementation * ARAIPCUnixSocketChannelRef;
+
+//! create a connected pair of sockets suitable for ARAIPCUnixSocketCreateChannel()
+//! One socket is typically passed to a child process, e.g. by inheriting it across fork ().
+//! Returns false if the sockets could not be created.
+bool ARA_CALL ARAIPCUnixSocketCreateSocketPair (int socketFDs[2]);
+
+//! creation and destruction of channels
+//! The channel takes ownership of the connected socket and will close it upon destruction.
+//! The receiver will be called for all incoming messages that are not replies.
+//@{
+ARAIPCUnixSocketChannelRef ARA_CALL ARAIPCUnixSocketCreateChannel (int socketFD, ARAIPCMessageReceiver receiver);
+void ARA_CALL ARAIPCUnixSocketDestroyChannel (ARAIPCUnixSocketChannelRef channelRef);
+//@}
+
+//! message sender to be used with the proxy host or proxy plug-in, valid until the channel is destroyed
+ARAIPCMessageSender ARA_CALL ARAIPCUnixSocketGetMessageSender (ARAIPCUnixSocketChannelRef channelRef);
+
+//! handle all queued incoming messages that have not been received as part of a pending send,
+//! waiting up to timeoutMilliseconds for a message to arrive if none is queued yet
+//! This is the equivalent of running the message loop on the receiving thread, and typically
+//! will be called from the main thread.
+//! Returns false if the connection has been closed by the remote side.
+bool ARA_CALL ARAIPCUnixSocketProcessReceivedMessages (ARAIPCUnixSocketChannelRef channelRef, int32_t timeoutMilliseconds);
+
+//! test whether the remote side is still connected
+//! After the connection has been lost, sending messages will no longer invoke the reply handler.
+bool ARA_CALL ARAIPCUnixSocketIsConnected (ARAIPCUnixSocketChannelRef channelRef);
+
+//! flow control for messages that do not expect a reply (i.e. sent without reply handler)
+//! By default (window size 0), all sends block until the remote side has handled the message.
+//! With a window size > 0, messages without reply handler are sent without waiting, which
+//! allows bursts of notifications to be pipelined. Each such message occupies a credit until the
+//! remote side has handled it - once windowSize messages are in flight, further sends block until
+//! credits are returned. This bounds the amount of one-way traffic queued ahead of subsequent
+//! synchronous calls, and thus their latency.
+//! While blocked, the sending thread handles incoming messages just like while waiting for a reply,
+//! including messages otherwise handled by ARAIPCUnixSocketProcessReceivedMessages (), since the
+//! remote side may depend on them being handled before it can return credits.
+//! Messages are never coalesced, since the transport cannot tell which messages supersede others.
+//! Note that the remote side still handles all messages in order, but since the sender no longer
+//! waits, this must only be enabled if the callers do not depend on a message being handled
+//! before the send returns.
+void ARA_CALL ARAIPCUnixSocketSetOneWayWindowSize (ARAIPCUnixSocketChannelRef channelRef, int32_t windowSize);
+
+//! snapshot of the current queue depths and the timeout statistics of a channel, for monitoring purposes
+typedef struct ARAIPCUnixSocketQueueDepths
+{
+    //! count of one-way messages sent but not yet handled by the remote side
+    int32_t unacknowledgedMessagesCount;
+    //! count of (stacked) sends waiting for their reply or for one-way flow control credits
+    int32_t pendingSendsCount;
+    //! count of received messages waiting to be handled by a pending send
+    int32_t stackedMessagesCount;
+    //! count of received messages waiting for ARAIPCUnixSocketProcessReceivedMessages ()
+    int32_t queuedMessagesCount;
+    //! total count of sends that gave up waiting because their timeout passed
+    //! (see ARAIPCMessageSenderInterface::sendMessageWithTimeout())
+    int32_t timedOutSendsCount;
+    //! total count of replies that arrived after their send had timed out, and thus were discarded
+    int32_t droppedRepliesCount;
+} ARAIPCUnixSocketQueueDepths;
+
+//! Since the queues are maintained per stream, the depths are summed up across all streams.
+void ARA_CALL ARAIPCUnixSocketGetQueueDepths (ARAIPCUnixSocketChannelRef channelRef, ARAIPCUnixSocketQueueDepths* queueDepths);
+
+//! Streams
+//! A channel can carry several logical streams, each of which provides the same message ordering,
+//! stacking and flow control semantics as a separate channel, independently of all other streams.
+//! This allows for using a dedicated stream per document controller (plus the plug-in extensions
+//! bound to it) over a single connection, so that a lengthy call in one document (e.g. restoring
+//! a large archive) does not delay the calls for any other document. To achieve this, each stream
+//! needs to be served by its own thread via ARAIPCUnixSocketProcessReceivedStreamMessages(), and
+//! should use its own ARAIPCLockingContext.
+//! Both sides must agree upon the stream IDs, e.g. by having the side that creates the document
+//! pass the ID along. Stream ID 0 is reserved for the default stream of the channel, which is used
+//! by ARAIPCUnixSocketGetMessageSender() and ARAIPCUnixSocketProcessReceivedMessages().
+//! Incoming messages for a stream that has not yet been created locally are retained until it is.
+//! @{
+
+//! opaque token representing a stream of a Unix domain socket channel
+typedef struct ARAIPCUnixSocketStreamImplementation * ARAIPCUnixSocketStreamRef;
+
+//! creation and destruction of streams
+//! Streams must be destroyed before their channel, after all their messages have been exchanged.
+//@{
+ARAIPCUnixSocketStreamRef ARA_CALL ARAIPCUnixSocketCreateStream (ARAIPCUnixSocketChannelRef channelRef, uint32_t streamID);
+void ARA_CALL ARAIPCUnixSocketDestroyStream (ARAIPCUnixSocketStreamRef streamRef);
+//@}
+
+//! message sender for the given stream, valid until the stream is destroyed
+ARAIPCMessageSender ARA_CALL ARAIPCUnixSocketGetStreamMessageSender (ARAIPCUnixSocketStreamRef streamRef);
+
+//! stream equivalent of ARAIPCUnixSocketProcessReceivedMessages()
+bool ARA_CALL ARAIPCUnixSocketProcessReceivedStreamMessages (ARAIPCUnixSocketStreamRef streamRef, int32_t timeoutMilliseconds);
+
+//! stream on which the message currently being handled on the calling thread has been received,
+//! or NULL if the thread is not handling any message
+//! This allows the receiver to route its replies and callbacks through the same stream, e.g. when
+//! creating a document controller via the proxy host (see ARAIPCProxyHostSetPlugInCallbacksSenderProvider()).
+ARAIPCUnixSocketStreamRef ARA_CALL ARAIPCUnixSocketGetHandlingStream (void);
+
+//! @}
+
+//! @}
+
+
+#if defined(__cplusplus)
+}   // extern "C"
+}   // namespace IPC
+}   // namespace ARA
+#endif
+
+
+#endif // ARA_ENABLE_IPC && defined(__linux__)
+
+#endif // ARAIPCUnixSocket_h
@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//! \file       ARANoteContent.cpp
+//!             structure-of-arrays storage for note content
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#include "ARANoteContent.h"
+
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ARA {
+namespace PlugIn {
+
+/*******************************************************************************/
+
+void NoteContent::reserve (size_t noteCount) noexcept
+{
+    _frequencies.reserve (noteCount);
+    _pitchNumbers.reserve (noteCount);
+    _volumes.reserve (noteCount);
+    _startPositions.reserve (noteCount);
+    _attackDurations.reserve (noteCount);
+    _noteDurations.reserve (noteCount);
+    _signalDurations.reserve (noteCount);
+    _maxEndPositions.reserve (noteCount);
+}
+
+void NoteContent::clear () noexcept
+{
+    _frequencies.clear ();
+    _pitchNumbers.clear ();
+    _volumes.clear ();
+    _startPositions.clear ();
+    _attackDurations.clear ();
+    _noteDurations.clear ();
+    _signalDurations.clear ();
+    _maxEndPositions.clear ();
+}
+
+void NoteContent::setNotes (const ARAContentNote* notes, size_t noteCount) noexcept
+{
+    // sort indices instead of the notes, then distribute the members in sorted order
+    std::vector<size_t> sortedIndices (noteCount);
+    for (size_t i { 0 }; i < noteCount; ++i)
+        sortedIndices[i] = i;
+    std::stable_sort (sortedIndices.begin (), sortedIndices.end (),
+                      [notes] (size_t a, size_t b) { return notes[a].startPosition < notes[b].startPosition; });
+
+    clear ();
+    reserve (noteCount);
+    for (const auto index : sortedIndices)
+    {
+        const auto& note { notes[index] };
+        _frequencies.push_back (note.frequency);
+        _pitchNumbers.push_back (note.pitchNumber);
+        _volumes.push_back (note.volume);
+        _startPositions.push_back (note.startPosition);
+        _attackDurations.push_back (note.attackDuration);
+        _noteDurations.push_back (note.noteDuration);
+        _signalDurations.push_back (note.signalDuration);
+    }
+    _maxEndPositions.resize (noteCount);
+    updateMaxEndPositions (0);
+}
+
+size_t NoteContent::addNote (const ARAContentNote& note) noexcept
+{
+    const auto index { static_cast<size_t> (std::upper_bound (_startPositions.begin (), _startPositions.end (), note.startPosition) - _startPositions.begin ()) };
+    const auto offset { static_cast<std::ptrdiff_t> (index) };
+    _frequencies.insert (_frequencies.begin () + offset, note.frequency);
+    _pitchNumbers.insert (_pitchNumbers.begin () + offset, note.pitchNumber);
+    _volumes.insert (_volumes.begin () + offset, note.volume);
+    _startPositions.insert (_startPositions.begin () + offset, note.startPosition);
+    _attackDurations.insert (_attackDurations.begin () + offset, note.attackDuration);
+    _noteDurations.insert (_noteDurations.begin () + offset, note.noteDuration);
+    _signalDurations.insert (_signalDurations.begin () + offset, note.signalDuration);
+    _maxEndPositions.insert (_maxEndPositions.begin () + offset, 0.0);
+    updateMaxEndPositions (index);
+    return index;
+}
+
+void NoteContent::removeNote (size_t index) noexcept
+{
+    ARA_INTERNAL_ASSERT (index < getNoteCount ());
+    const auto offset { static_cast<std::ptrdiff_t> (index) };
+    _frequencies.erase (_frequencies.begin () + offset);
+    _pitchNumbers.erase (_pitchNumbers.begin () + offset);
+    _volumes.erase (_volumes.begin () + offset);
+    _startPositions.erase (_startPositions.begin () + offset);
+    _attackDurations.erase (_attackDurations.begin () + offset);
+    _noteDurations.erase (_noteDurations.begin () + offset);
+    _signalDurations.erase (_signalDurations.begin () + offset);
+    _maxEndPositions.erase (_maxEndPositions.begin () + offset);
+    updateMaxEndPositions (index);
+}
+
+size_t NoteContent::updateNote (size_t index, const ARAContentNote& note) noexcept
+{
+    ARA_INTERNAL_ASSERT (index < getNoteCount ());
+
+    // update in place if the order is unchanged
+    if ((note.startPosition == _startPositions[index]) ||
+        (((index == 0) || (_startPositions[index - 1] <= note.startPosition)) &&
+         ((index + 1 == getNoteCount ()) || (note.startPosition < _startPositions[index + 1]))))
+    {
+        _frequencies[index] = note.frequency;
+        _pitchNumbers[index] = note.pitchNumber;
+        _volumes[index] = note.volume;
+        _startPositions[index] = note.startPosition;
+        _attackDurations[index] = note.attackDuration;
+        _noteDurations[index] = note.noteDuration;
+        _signalDurations[index] = note.signalDuration;
+        updateMaxEndPositions (index);
+        return index;
+    }
+
+    removeNote (index);
+    return addNote (note);
+}
+
+void NoteContent::updateMaxEndPositions (size_t firstIndex) noexcept
+{
+    auto maxEndPosition { (firstIndex > 0) ? _maxEndPositions[firstIndex - 1] : std::numeric_limits<ARATimePosition>::lowest () };
+    for (auto i { firstIndex }; i < _maxEndPositions.size (); ++i)
+    {
+        maxEndPosition = std::max (maxEndPosition, getEndPosition (i));
+        _maxEndPositions[i] = maxEndPosition;
+    }
+}
+
+/*******************************************************************************/
+
+NoteContent::IndexRange NoteContent::getIndexRange (const ARAContentTimeRange& range) const noexcept
+{
+    // all notes before the first note reaching the range start end before the range, and since the
+    // notes are sorted, all notes starting at or after the range end start after it
+    const auto first { std::lower_bound (_maxEndPositions.begin (), _maxEndPositions.end (), range.start) - _maxEndPositions.begin () };
+    const auto last { std::lower_bound (_startPositions.begin (), _startPositions.end (), range.start + range.duration) - _startPositions.begin () };
+    return { static_cast<size_t> (first), static_cast<size_t> (std::max (first, last)) };
+}
+
+void NoteContent::findNotesInRange (const ARAContentTimeRange& range, std::vector<size_t>& indices) const noexcept
+{
+    forEachNoteInRange (range, [&indices] (size_t index) { indices.push_back (index); });
+}
+
+/*******************************************************************************/
+
+NoteContentReader::NoteContentReader (std::shared_ptr<const NoteContent> noteContent, const ARAContentTimeRange* range) noexcept
+: _noteContent { std::move (noteContent) }
+{
+    ARA_INTERNAL_ASSERT (_noteContent != nullptr);
+
+    if (!range)
+    {
+        _eventCount = static_cast<ARAInt32> (_noteContent->getNoteCount ());
+        return;
+    }
+
+    // only store indices if some notes within the index range are not in the time range
+    const auto indexRange { _noteContent->getIndexRange (*range) };
+    _firstIndex = indexRange.first;
+    for (auto i { indexRange.first }; i < indexRange.last; ++i)
+    {
+        if (!_noteContent->isNoteInRange (i, *range))
+        {
+            _indices.reserve (indexRange.last - indexRange.first);
+            for (auto j { indexRange.first }; j < i; ++j)
+                _indices.push_back (j);
+            for (auto j { i + 1 }; j < indexRange.last; ++j)
+            {
+                if (_noteContent->isNoteInRange (j, *range))
+                    _indices.push_back (j);
+            }
+            _eventCount = static_cast<ARAInt32> (_indices.size ());
+            return;
+        }
+    }
+    _eventCount = static_cast<ARAInt32> (indexRange.last - indexRange.first);
+}
+
+const void* NoteContentReader::getDataForEvent (ARAInt32 eventIndex) noexcept
+{
+    ARA_INTERNAL_ASSERT ((0 <= eventIndex) && (eventIndex < _eventCount));
+
+    const auto index { static_cast<size_t> (eventIndex) };
+    _note = _noteContent->getNote ((_indices.empty ()) ? _firstIndex + index : _indices[index]);
+    return &_note;
+}
+
+}   // namespace PlugIn
+}   // namespace ARA
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//! \file       ARANoteContent.h
+//!             structure-of-arrays storage for note content
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARANoteContent_h
+#define ARANoteContent_h
+
+#include "ARA_Library/PlugIn/ARAPlug.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+
+namespace ARA
+{
+namespace PlugIn
+{
+
+//! @addtogroup ARA_Library_ARAPlug_Utility_Classes
+//! @{
+
+/*******************************************************************************/
+//! Storage for analyzed notes, with each member of ARAContentNote stored in a separate array.
+//! Plug-in algorithms typically process a single member across many notes (e.g. converting all
+//! frequencies to cents with TuningConverter::getCentsForFrequencies (), or searching positions),
+//! which touches only the relevant arrays and allows the compiler to vectorize the loops.
+//! The notes are always sorted by start position, notes with equal start positions remain in the
+//! order in which they were added. A running maximum of the note end positions allows for finding
+//! all notes that intersect a given time range with two binary searches.
+//! The content can be published to the host via NoteContentReader without copying the arrays.
+class NoteContent
+{
+public:
+    //! Range of note indices [first, last).
+    struct IndexRange
+    {
+        size_t first;
+        size_t last;
+    };
+
+public:
+    NoteContent () noexcept = default;
+
+    size_t getNoteCount () const noexcept { return _startPositions.size (); }
+    bool isEmpty () const noexcept { return _startPositions.empty (); }
+
+    void reserve (size_t noteCount) noexcept;
+    void clear () noexcept;
+
+    //! Replace all notes by the given notes, which need not be sorted.
+    void setNotes (const ARAContentNote* notes, size_t noteCount) noexcept;
+
+    //! Insert a note at the position determined by its start position and return its index.
+    //! Adding notes in ascending order is amortized constant time, otherwise linear.
+    size_t addNote (const ARAContentNote& note) noexcept;
+    //! Remove the note at the given index.
+    void removeNote (size_t index) noexcept;
+    //! Replace the note at the given index and return its new index.
+    size_t updateNote (size_t index, const ARAContentNote& note) noexcept;
+
+    //! Get the note at the given index as ARAContentNote struct.
+    ARAContentNote getNote (size_t index) const noexcept
+    {
+        ARA_INTERNAL_ASSERT (index < getNoteCount ());
+        return { _frequencies[index], _pitchNumbers[index], _volumes[index], _startPositions[index],
+                 _attackDurations[index], _noteDurations[index], _signalDurations[index] };
+    }
+
+    //! @name Member arrays
+    //! Each array provides getNoteCount () entries, in the same order as all other arrays.
+    //! Pointers are invalidated by any call that adds or removes notes.
+    //@{
+    const float* getFrequencies () const noexcept { return _frequencies.data (); }
+    const ARAPitchNumber* getPitchNumbers () const noexcept { return _pitchNumbers.data (); }
+    const float* getVolumes () const noexcept { return _volumes.data (); }
+    const ARATimePosition* getStartPositions () const noexcept { return _startPositions.data (); }
+    const ARATimeDuration* getAttackDurations () const noexcept { return _attackDurations.data (); }
+    const ARATimeDuration* getNoteDurations () const noexcept { return _noteDurations.data (); }
+    const ARATimeDuration* getSignalDurations () const noexcept { return _signalDurations.data (); }
+    //@}
+
+    //! @name Mutable member arrays
+    //! Frequencies, pitch numbers and volumes do not affect sorting or range search, so they can
+    //! be modified in place. Positions and durations must be changed via updateNote ().
+    //@{
+    float* getFrequencies () noexcept { return _frequencies.data (); }
+    ARAPitchNumber* getPitchNumbers () noexcept { return _pitchNumbers.data (); }
+    float* getVolumes () noexcept { return _volumes.data (); }
+    //@}
+
+    //! @name Range search
+    //! A note covers the time from its start position to the later of its note and signal end.
+    //! Notes of zero duration intersect a range if they start within it.
+    //@{
+    ARATimePosition getEndPosition (size_t index) const noexcept
+    {
+        ARA_INTERNAL_ASSERT (index < getNoteCount ());
+        return _startPositions[index] + ((_noteDurations[index] < _signalDurations[index]) ? _signalDurations[index] : _noteDurations[index]);
+    }
+
+    bool isNoteInRange (size_t index, const ARAContentTimeRange& range) const noexcept
+    {
+        const auto startPosition { _startPositions[index] };
+        return (startPosition < range.start + range.duration) &&
+               ((range.start < getEndPosition (index)) || (range.start <= startPosition));
+    }
+
+    //! Get the smallest index range that contains all notes intersecting the given range.
+    //! The range may also contain notes that end before the start of the given range, if these
+    //! are overlapped by longer notes that start earlier - use isNoteInRange () to filter these.
+    IndexRange getIndexRange (const ARAContentTimeRange& range) const noexcept;
+
+    //! Get the indices of all notes intersecting the given range, in ascending order.
+    void findNotesInRange (const ARAContentTimeRange& range, std::vector<size_t>& indices) const noexcept;
+
+    //! Call \p func with the index of each note intersecting the given range, in ascending order.
+    template <typename FuncT>
+    void forEachNoteInRange (const ARAContentTimeRange& range, FuncT&& func) const
+    {
+        const auto indexRange { getIndexRange (range) };
+        for (auto i { indexRange.first }; i < indexRange.last; ++i)
+        {
+            if (isNoteInRange (i, range))
+                func (i);
+        }
+    }
+    //@}
+
+private:
+    void updateMaxEndPositions (size_t firstIndex) noexcept;
+
+private:
+    std::vector<float> _frequencies;
+    std::vector<ARAPitchNumber> _pitchNumbers;
+    std::vector<float> _volumes;
+    std::vector<ARATimePosition> _startPositions;
+    std::vector<ARATimeDuration> _attackDurations;
+    std::vector<ARATimeDuration> _noteDurations;
+    std::vector<ARATimeDuration> _signalDurations;
+    std::vector<ARATimePosition> _maxEndPositions;  // maximum of getEndPosition () for all notes up to the given index
+};
+
+/*******************************************************************************/
+//! ContentReader implementation providing the notes of a NoteContent, e.g. to be returned from
+//! DocumentControllerDelegate::doCreateAudioSourceContentReader () or similar.
+//! The reader shares the immutable content instead of copying it, so the plug-in can replace
+//! its content at any time while readers created earlier remain valid.
+//! ARA requires that a pointer to an ARAContentNote is returned for each event - this reader
+//! assembles the requested note in an internal struct, which is valid until the next call to
+//! getDataForEvent (). This is sufficient for any host, including the IPC proxy which encodes
+//! batches of events by requesting them one after the other.
+class NoteContentReader : public ContentReader
+{
+public:
+    //! Create a reader for all notes, or only for the notes intersecting \p range if provided.
+    explicit NoteContentReader (std::shared_ptr<const NoteContent> noteContent, const ARAContentTimeRange* range = nullptr) noexcept;
+
+    ARAInt32 getEventCount () noexcept override { return _eventCount; }
+    const void* getDataForEvent (ARAInt32 eventIndex) noexcept override;
+
+private:
+    const std::shared_ptr<const NoteContent> _noteContent;
+    size_t _firstIndex { 0 };
+    ARAInt32 _eventCount { 0 };
+    std::vector<size_t> _indices;       // only used if the notes in range are not contiguous
+    ARAContentNote _note {};
+};
+
+//! @} ARA_Library_ARAPlug_Utility_Classes
+
+}   // namespace PlugIn
+}   // namespace ARA
+
+#endif // ARANoteContent_h
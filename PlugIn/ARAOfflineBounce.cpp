@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+//! \file       ARAOfflineBounce.cpp
+//!             parallel offline rendering of playback renderers
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#include "ARAOfflineBounce.h"
+
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+namespace ARA {
+namespace PlugIn {
+
+/*******************************************************************************/
+
+namespace {
+
+// Chunk k covers the output range [start + k * chunkSampleCount, start + (k + 1) * chunkSampleCount),
+// which it writes directly into the output buffers. All chunks but the first additionally render
+// the crossfade range preceding it into a separate lead-in buffer, and before that the tail range to
+// warm up the renderer. After all chunks have been rendered, the lead-ins are blended into the end
+// of the respective preceding chunk. Since each chunk writes to disjoint memory, no synchronization
+// is needed aside from distributing the chunks, and the result is independent of thread scheduling.
+class OfflineBounceJob
+{
+public:
+    OfflineBounceJob (const OfflineBounceSettings& settings, float* const* outputBuffers, ARASamplePosition samplePosition, ARASampleCount sampleCount, size_t renderersCount)
+    : _settings { settings },
+      _outputBuffers { outputBuffers },
+      _startPosition { samplePosition },
+      _endPosition { samplePosition + sampleCount }
+    {
+        ARA_INTERNAL_ASSERT (_settings.channelCount > 0);
+        ARA_INTERNAL_ASSERT (_settings.blockSampleCount > 0);
+        ARA_INTERNAL_ASSERT (_settings.latencySampleCount >= 0);
+        ARA_INTERNAL_ASSERT (_settings.tailSampleCount >= 0);
+        ARA_INTERNAL_ASSERT (_settings.crossfadeSampleCount >= 0);
+
+        if (_settings.chunkSampleCount <= 0)
+            _settings.chunkSampleCount = std::max<ARASampleCount> ((sampleCount + static_cast<ARASampleCount> (renderersCount) - 1) / static_cast<ARASampleCount> (renderersCount), 1);
+        ARA_INTERNAL_ASSERT (_settings.crossfadeSampleCount <= _settings.chunkSampleCount);
+        _settings.crossfadeSampleCount = std::min (_settings.crossfadeSampleCount, _settings.chunkSampleCount);
+
+        _chunksCount = static_cast<size_t> ((sampleCount + _settings.chunkSampleCount - 1) / _settings.chunkSampleCount);
+        _leadInBuffers.resize (_chunksCount * static_cast<size_t> (_settings.channelCount) * static_cast<size_t> (_settings.crossfadeSampleCount));
+    }
+
+    // render chunks until all have been claimed by some thread
+    void renderChunks (OfflineBounceRenderer* renderer) noexcept
+    {
+        const auto channelCount { static_cast<size_t> (_settings.channelCount) };
+        const auto blockSampleCount { static_cast<size_t> (_settings.blockSampleCount) };
+        std::vector<float> blockBuffer (channelCount * blockSampleCount);
+        std::vector<float*> blockChannels (channelCount);
+        for (size_t c { 0 }; c < channelCount; ++c)
+            blockChannels[c] = blockBuffer.data () + c * blockSampleCount;
+
+        for (auto chunkIndex { _nextChunkIndex++ }; chunkIndex < _chunksCount; chunkIndex = _nextChunkIndex++)
+            renderChunk (renderer, chunkIndex, blockChannels);
+    }
+
+    // blend the lead-ins into the preceding chunks
+    void crossfadeChunks () noexcept
+    {
+        const auto crossfadeSampleCount { _settings.crossfadeSampleCount };
+        for (size_t chunkIndex { 1 }; chunkIndex < _chunksCount; ++chunkIndex)
+        {
+            const auto chunkStart { getChunkStart (chunkIndex) };
+            for (auto c { 0 }; c < _settings.channelCount; ++c)
+            {
+                const auto leadIn { getLeadInBuffer (chunkIndex, c) };
+                const auto output { _outputBuffers[c] + (chunkStart - crossfadeSampleCount - _startPosition) };
+                for (auto i { 0 }; i < crossfadeSampleCount; ++i)
+                {
+                    const auto gain { static_cast<float> (i + 1) / static_cast<float> (crossfadeSampleCount + 1) };
+                    output[i] += gain * (leadIn[i] - output[i]);
+                }
+            }
+        }
+    }
+
+private:
+    ARASamplePosition getChunkStart (size_t chunkIndex) const noexcept
+    {
+        return _startPosition + static_cast<ARASampleCount> (chunkIndex) * _settings.chunkSampleCount;
+    }
+
+    float* getLeadInBuffer (size_t chunkIndex, ARAChannelCount channel) noexcept
+    {
+        return _leadInBuffers.data () + (chunkIndex * static_cast<size_t> (_settings.channelCount) + static_cast<size_t> (channel)) * static_cast<size_t> (_settings.crossfadeSampleCount);
+    }
+
+    void renderChunk (OfflineBounceRenderer* renderer, size_t chunkIndex, std::vector<float*> const& blockChannels) noexcept
+    {
+        // the first chunk starts like a sequential render, all others are preceded by crossfade and tail
+        const auto chunkStart { getChunkStart (chunkIndex) };
+        const auto chunkEnd { std::min (chunkStart + _settings.chunkSampleCount, _endPosition) };
+        const auto leadInStart { (chunkIndex == 0) ? chunkStart : chunkStart - _settings.crossfadeSampleCount };
+        const auto renderStart { (chunkIndex == 0) ? chunkStart : leadInStart - _settings.tailSampleCount };
+        const auto renderEnd { chunkEnd + _settings.latencySampleCount };
+
+        renderer->resetOfflineBounce ();
+        for (auto blockStart { renderStart }; blockStart < renderEnd; blockStart += _settings.blockSampleCount)
+        {
+            const auto blockSampleCount { std::min (_settings.blockSampleCount, renderEnd - blockStart) };
+            renderer->renderOfflineBounce (blockChannels.data (), blockStart, blockSampleCount);
+
+            // compensate latency, then copy the parts of the block that fall into the lead-in or the chunk
+            const auto outputStart { blockStart - _settings.latencySampleCount };
+            const auto outputEnd { outputStart + blockSampleCount };
+            for (auto c { 0 }; c < _settings.channelCount; ++c)
+            {
+                const auto leadInCopyStart { std::max (outputStart, leadInStart) };
+                const auto leadInCopyEnd { std::min (outputEnd, chunkStart) };
+                if (leadInCopyStart < leadInCopyEnd)
+                    std::memcpy (getLeadInBuffer (chunkIndex, c) + (leadInCopyStart - leadInStart),
+                                 blockChannels[static_cast<size_t> (c)] + (leadInCopyStart - outputStart),
+                                 static_cast<size_t> (leadInCopyEnd - leadInCopyStart) * sizeof (float));
+
+                const auto chunkCopyStart { std::max (outputStart, chunkStart) };
+                const auto chunkCopyEnd { std::min (outputEnd, chunkEnd) };
+                if (chunkCopyStart < chunkCopyEnd)
+                    std::memcpy (_outputBuffers[c] + (chunkCopyStart - _startPosition),
+                                 blockChannels[static_cast<size_t> (c)] + (chunkCopyStart - outputStart),
+                                 static_cast<size_t> (chunkCopyEnd - chunkCopyStart) * sizeof (float));
+            }
+        }
+    }
+
+private:
+    OfflineBounceSettings _settings;
+    float* const* const _outputBuffers;
+    const ARASamplePosition _startPosition;
+    const ARASamplePosition _endPosition;
+    size_t _chunksCount;
+    std::vector<float> _leadInBuffers;
+    std::atomic<size_t> _nextChunkIndex { 0 };
+};
+
+}   // namespace
+
+/*******************************************************************************/
+
+void renderOfflineBounce (const OfflineBounceSettings& settings, std::vector<OfflineBounceRenderer*> const& renderers,
+                          float* const* outputBuffers, ARASamplePosition samplePosition, ARASampleCount sampleCount) noexcept
+{
+    ARA_INTERNAL_ASSERT (!renderers.empty ());
+    if (renderers.empty () || (sampleCount <= 0))
+        return;
+
+    OfflineBounceJob job { settings, outputBuffers, samplePosition, sampleCount, renderers.size () };
+
+    std::vector<std::thread> threads;
+    threads.reserve (renderers.size () - 1);
+    for (auto it { renderers.begin () + 1 }; it != renderers.end (); ++it)
+    {
+        try
+        {
+            const auto renderer { *it };
+            threads.emplace_back ([&job, renderer] () { job.renderChunks (renderer); });
+        }
+        catch (const std::system_error&)
+        {
+            ARA_WARN ("could not start offline bounce thread, rendering with %i threads only", static_cast<int> (threads.size () + 1));
+            break;
+        }
+    }
+
+    job.renderChunks (renderers.front ());
+    for (auto& thread : threads)
+        thread.join ();
+
+    job.crossfadeChunks ();
+}
+
+}   // namespace PlugIn
+}   // namespace ARA
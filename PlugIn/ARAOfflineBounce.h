@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//! \file       ARAOfflineBounce.h
+//!             parallel offline rendering of playback renderers
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARAOfflineBounce_h
+#define ARAOfflineBounce_h
+
+#include "ARA_API/ARAInterface.h"
+
+#include <vector>
+
+
+namespace ARA
+{
+namespace PlugIn
+{
+
+//! @addtogroup ARA_Library_ARAPlug_Utility_Classes
+//! @{
+
+/*******************************************************************************/
+//! Interface for a renderer instance used by renderOfflineBounce ().
+//! Plug-ins typically implement this by wrapping an instance of their Companion API render code
+//! that is bound to a PlaybackRenderer with the regions to bounce.
+//! All instances passed to renderOfflineBounce () must produce the same output for the same input,
+//! and each instance must only depend on the samples rendered since its last reset.
+class OfflineBounceRenderer
+{
+public:
+    virtual ~OfflineBounceRenderer () = default;
+
+    //! Clear all internal state (delay lines, reverb tails, etc.) before rendering a new range.
+    virtual void resetOfflineBounce () noexcept = 0;
+
+    //! Render the given range into the non-interleaved channel buffers.
+    //! Consecutive calls after a reset render consecutive ranges. The output is expected to be
+    //! delayed by OfflineBounceSettings::latencySampleCount.
+    virtual void renderOfflineBounce (float* const* channelBuffers, ARASamplePosition samplePosition, ARASampleCount samplesToRender) noexcept = 0;
+};
+
+/*******************************************************************************/
+//! Configuration of renderOfflineBounce ().
+struct OfflineBounceSettings
+{
+    //! Count of channels to render.
+    ARAChannelCount channelCount { 2 };
+
+    //! Maximum count of samples per call to OfflineBounceRenderer::renderOfflineBounce ().
+    ARASampleCount blockSampleCount { 1024 };
+
+    //! Latency of the renderers, i.e. the delay of their output in samples.
+    ARASampleCount latencySampleCount { 0 };
+
+    //! Count of samples after which input no longer affects the output of the renderers, such as
+    //! the length of a reverb tail or an analysis window. Each chunk is preceded by rendering this
+    //! amount of samples so that the renderer reaches the same state as when rendering sequentially.
+    ARASampleCount tailSampleCount { 0 };
+
+    //! Length of the chunks rendered independently, 0 to evenly divide the range among the renderers.
+    ARASampleCount chunkSampleCount { 0 };
+
+    //! Length of the linear crossfade applied between consecutive chunks.
+    //! If tailSampleCount fully covers the memory of the renderers, the chunks can be stitched without
+    //! crossfade (and the result will be identical to sequential rendering), otherwise a short
+    //! crossfade hides the remaining discontinuities. Must not exceed the chunk length.
+    ARASampleCount crossfadeSampleCount { 0 };
+};
+
+//! Render the given range into the non-interleaved output buffers, which must provide
+//! settings.channelCount channels of sampleCount samples each.
+//! The range is partitioned into chunks which are distributed across the given renderer instances,
+//! each on its own thread (the first one being the calling thread). The result does not depend on
+//! the order in which the chunks are rendered, or on which renderer renders which chunk.
+//! If a thread cannot be started, its chunks are rendered by the remaining threads.
+void renderOfflineBounce (const OfflineBounceSettings& settings, std::vector<OfflineBounceRenderer*> const& renderers,
+                          float* const* outputBuffers, ARASamplePosition samplePosition, ARASampleCount sampleCount) noexcept;
+
+//! @} ARA_Library_ARAPlug_Utility_Classes
+
+}   // namespace PlugIn
+}   // namespace ARA
+
+#endif // ARAOfflineBounce_h
@@ -19,8 +19,15 @@
 #include "ARAPlug.h"
 
 #include "ARA_Library/Utilities/ARAChannelArrangement.h"
+#include "ARA_Library/Utilities/ARATimelineConversion.h"
 
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <new>
 #include <sstream>
+#include <unordered_map>
+#include <stdlib.h>     // workaround, see OptionalPropertyPool::createData ()
 
 namespace ARA {
 namespace PlugIn {
@@ -280,6 +287,169 @@ void logDocumentChange (std::string change, const T object, const DocumentContro
 
 /*******************************************************************************/
 
+// shared state of a pool, which remains alive until the pool and all of its blocks are destroyed
+struct OptionalPropertyPool::Core
+{
+    std::atomic<uint32_t> refCount { 1 };
+    std::mutex mutex;
+    std::unordered_multimap<size_t, Block*> blocks;
+
+    void release () noexcept
+    {
+        if (refCount.fetch_sub (1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+};
+
+// header preceding the property data
+struct alignas (std::max_align_t) OptionalPropertyPool::Block
+{
+    std::atomic<uint32_t> refCount;
+    Core* core;     // nullptr if not shared
+    size_t hash;
+    size_t size;
+
+    void* getData () noexcept { return this + 1; }
+    const void* getData () const noexcept { return this + 1; }
+    static Block* fromData (const void* data) noexcept { return const_cast<Block*> (static_cast<const Block*> (data) - 1); }
+};
+
+// FNV-1a
+static size_t hashPropertyValue (const void* value, size_t size) noexcept
+{
+    uint64_t hash { 14695981039346656037ULL };
+    for (auto byte { static_cast<const uint8_t*> (value) }, end { byte + size }; byte < end; ++byte)
+        hash = (hash ^ *byte) * 1099511628211ULL;
+    return static_cast<size_t> (hash);
+}
+
+OptionalPropertyPool::OptionalPropertyPool () noexcept
+: _core { new Core }
+{}
+
+OptionalPropertyPool::~OptionalPropertyPool () noexcept
+{
+    _core->release ();
+}
+
+const void* OptionalPropertyPool::createData (OptionalPropertyPool* pool, const void* value, size_t size) noexcept
+{
+    const auto hash { (pool) ? hashPropertyValue (value, size) : 0 };
+    std::unique_lock<std::mutex> lock;
+    if (pool)
+    {
+        lock = std::unique_lock<std::mutex> { pool->_core->mutex };
+        const auto range { pool->_core->blocks.equal_range (hash) };
+        for (auto it { range.first }; it != range.second; ++it)
+        {
+            const auto block { it->second };
+            if ((block->size != size) || (std::memcmp (block->getData (), value, size) != 0))
+                continue;
+
+            // blocks that are being released must not be resurrected - if found, just add a new block
+            auto refCount { block->refCount.load (std::memory_order_relaxed) };
+            while ((refCount > 0) && !block->refCount.compare_exchange_weak (refCount, refCount + 1, std::memory_order_relaxed))
+            {}
+            if (refCount > 0)
+                return block->getData ();
+        }
+    }
+
+    // Xcode 8 has namespace issues with std::malloc()/std::free(), so we use the C version for now
+    auto memory { /*std::*/malloc (sizeof (Block) + size) };
+    ARA_INTERNAL_ASSERT (memory);
+    auto block { new (memory) Block };
+    block->refCount.store (1, std::memory_order_relaxed);
+    block->core = nullptr;
+    block->hash = hash;
+    block->size = size;
+    std::memcpy (block->getData (), value, size);
+
+    if (pool)
+    {
+        block->core = pool->_core;
+        block->core->refCount.fetch_add (1, std::memory_order_relaxed);
+        block->core->blocks.emplace (hash, block);
+    }
+    return block->getData ();
+}
+
+void OptionalPropertyPool::retainData (const void* data) noexcept
+{
+    Block::fromData (data)->refCount.fetch_add (1, std::memory_order_relaxed);
+}
+
+void OptionalPropertyPool::releaseData (const void* data) noexcept
+{
+    auto block { Block::fromData (data) };
+    if (block->refCount.fetch_sub (1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if (auto core { block->core })
+    {
+        {
+            std::lock_guard<std::mutex> lock { core->mutex };
+            const auto range { core->blocks.equal_range (block->hash) };
+            for (auto it { range.first }; it != range.second; ++it)
+            {
+                if (it->second == block)
+                {
+                    core->blocks.erase (it);
+                    break;
+                }
+            }
+        }
+        core->release ();
+    }
+
+    block->~Block ();
+    /*std::*/free (block);
+}
+
+size_t OptionalPropertyPool::getDataSize (const void* data) noexcept
+{
+    return Block::fromData (data)->size;
+}
+
+bool OptionalPropertyPool::isDataShared (const void* data, const void* otherData) noexcept
+{
+    const auto core { Block::fromData (data)->core };
+    return (core != nullptr) && (core == Block::fromData (otherData)->core);
+}
+
+/*******************************************************************************/
+
+// generations are drawn from a single counter so that they are unique across all objects
+static std::atomic<uint64_t> _nextContentGeneration { 1 };
+
+ContentGenerations::ContentGenerations () noexcept
+{
+    const auto generation { _nextContentGeneration++ };
+    for (auto& scopeGeneration : _scopeGenerations)
+        scopeGeneration.store (generation, std::memory_order_relaxed);
+    _generation.store (generation, std::memory_order_release);
+}
+
+void ContentGenerations::update (ContentUpdateScopes scopeFlags) noexcept
+{
+    const bool affectedScopes[kScopesCount] { scopeFlags.affectSamples (), scopeFlags.affectNotes (), scopeFlags.affectTimeline (),
+                                              scopeFlags.affectTuning (), scopeFlags.affectHarmonies () };
+    bool anyScopeAffected { false };
+    const auto generation { _nextContentGeneration++ };
+    for (size_t i { 0 }; i < kScopesCount; ++i)
+    {
+        if (affectedScopes[i])
+        {
+            _scopeGenerations[i].store (generation, std::memory_order_release);
+            anyScopeAffected = true;
+        }
+    }
+    if (anyScopeAffected)
+        _generation.store (generation, std::memory_order_release);
+}
+
+/*******************************************************************************/
+
 float AnalysisProgressTracker::decodeProgress (float encodedProgress) noexcept
 {
     if (encodedProgress >= 6.0f)
@@ -396,9 +566,17 @@ void AnalysisProgressTracker::notifyProgress (HostModelUpdateController* control
 
 /*******************************************************************************/
 
+PropertyChanges Document::getPropertyChanges (PropertiesPtr<ARADocumentProperties> newProperties) const noexcept
+{
+    PropertyChanges changes { 0 };
+    if (_name != newProperties->name)
+        changes |= kNameChanged;
+    return changes;
+}
+
 void Document::updateProperties (PropertiesPtr<ARADocumentProperties> properties) noexcept
 {
-    _name = properties->name;
+    _name.assign (properties->name, &_propertyPool);
 }
 
 void Document::sortMusicalContextsByOrderIndex ()
@@ -413,6 +591,75 @@ void Document::sortRegionSequencesByOrderIndex ()
 
 /*******************************************************************************/
 
+// helpers for storing content events read from content readers
+inline ARATimePosition getContentEventPosition (const ARAContentNote& note) noexcept { return note.startPosition; }
+inline ARATimePosition getContentEventPosition (const ARAContentTempoEntry& tempoEntry) noexcept { return tempoEntry.timePosition; }
+inline ARAQuarterPosition getContentEventPosition (const ARAContentBarSignature& barSignature) noexcept { return barSignature.position; }
+inline ARAQuarterPosition getContentEventPosition (const ARAContentTuning& /*tuning*/) noexcept { return 0.0; }    // static, always read as a whole
+inline ARAQuarterPosition getContentEventPosition (const ARAContentKeySignature& keySignature) noexcept { return keySignature.position; }
+inline ARAQuarterPosition getContentEventPosition (const ARAContentChord& chord) noexcept { return chord.position; }
+
+// the strings of the events are only valid while the content reader exists, so they must be copied
+inline void retainContentEventStrings (ARAContentNote& /*note*/, std::deque<std::string>& /*strings*/) noexcept {}
+inline void retainContentEventStrings (ARAContentTempoEntry& /*tempoEntry*/, std::deque<std::string>& /*strings*/) noexcept {}
+inline void retainContentEventStrings (ARAContentBarSignature& /*barSignature*/, std::deque<std::string>& /*strings*/) noexcept {}
+template <typename DataType>
+inline void retainContentEventStrings (DataType& event, std::deque<std::string>& strings) noexcept
+{
+    if (event.name)
+    {
+        strings.emplace_back (event.name);
+        event.name = strings.back ().c_str ();
+    }
+}
+
+template <ARAContentType contentType>
+inline void appendContentEvent (MusicalContextContent::Events<contentType>& target, const typename ContentTypeMapper<contentType>::DataType& event) noexcept
+{
+    target.events.push_back (event);
+    retainContentEventStrings (target.events.back (), target.strings);
+}
+
+// Read the given content type from the host. If previous content is provided, only the events
+// in the given range are replaced, with positionRange being the range expressed in the units
+// of the positions of the events.
+template <ARAContentType contentType>
+std::shared_ptr<const MusicalContextContent::Events<contentType>> readMusicalContextContent (const MusicalContext* musicalContext,
+                            const MusicalContextContent::Events<contentType>* previous, const ARAContentTimeRange* range, const double positionRange[2]) noexcept
+{
+    const bool isPartialUpdate { previous && previous->isAvailable && range && positionRange };
+    const HostContentReader<contentType> contentReader { musicalContext, (isPartialUpdate) ? range : nullptr };
+
+    auto content { std::make_shared<MusicalContextContent::Events<contentType>> () };
+    content->isAvailable = contentReader;
+    content->grade = contentReader.getGrade ();
+    if (!content->isAvailable)
+        return content;
+
+    if (!isPartialUpdate)
+    {
+        content->events.reserve (static_cast<size_t> (contentReader.getEventCount ()));
+        for (const auto& event : contentReader)
+            appendContentEvent<contentType> (*content, event);
+        return content;
+    }
+
+    // the host may deliver events outside of the range (such as surrounding tempo entries for interpolation),
+    // these are ignored in favor of the previous events
+    for (const auto& event : previous->events)
+        if (getContentEventPosition (event) < positionRange[0])
+            appendContentEvent<contentType> (*content, event);
+    for (const auto& event : contentReader)
+        if ((positionRange[0] <= getContentEventPosition (event)) && (getContentEventPosition (event) <= positionRange[1]))
+            appendContentEvent<contentType> (*content, event);
+    for (const auto& event : previous->events)
+        if (positionRange[1] < getContentEventPosition (event))
+            appendContentEvent<contentType> (*content, event);
+    return content;
+}
+
+/*******************************************************************************/
+
 MusicalContext::MusicalContext (Document* document, ARAMusicalContextHostRef hostRef) noexcept
 : _document { document },
   _hostRef { hostRef }
@@ -433,10 +680,25 @@ const OptionalProperty<ARAUtf8String>& MusicalContext::getEffectiveName () const
     return _document->getName ();
 }
 
+PropertyChanges MusicalContext::getPropertyChanges (PropertiesPtr<ARAMusicalContextProperties> newProperties) const noexcept
+{
+    PropertyChanges changes { 0 };
+    const auto name { (newProperties.implements<ARA_STRUCT_MEMBER (ARAMusicalContextProperties, name)> ()) ? newProperties->name : nullptr };
+    if (_name != name)
+        changes |= kNameChanged;
+    const auto orderIndex { (newProperties.implements<ARA_STRUCT_MEMBER (ARAMusicalContextProperties, orderIndex)> ()) ? newProperties->orderIndex : 0 };
+    if (_orderIndex != orderIndex)
+        changes |= kOrderIndexChanged;
+    const auto color { (newProperties.implements<ARA_STRUCT_MEMBER (ARAMusicalContextProperties, color)> ()) ? newProperties->color : nullptr };
+    if (_color != color)
+        changes |= kColorChanged;
+    return changes;
+}
+
 void MusicalContext::updateProperties (PropertiesPtr<ARAMusicalContextProperties> properties) noexcept
 {
     if (properties.implements<ARA_STRUCT_MEMBER (ARAMusicalContextProperties, name)> ())
-        _name = properties->name;
+        _name.assign (properties->name, _document->getPropertyPool ());
     else
         _name = nullptr;
 
@@ -446,7 +708,7 @@ void MusicalContext::updateProperties (PropertiesPtr<ARAMusicalContextProperties
         _orderIndex = 0;        // for position, we have no markup for "unknown" position - we'll just remain unsorted
 
     if (properties.implements<ARA_STRUCT_MEMBER (ARAMusicalContextProperties, color)> ())
-        _color = properties->color;
+        _color.assign (properties->color, _document->getPropertyPool ());
     else
         _color = nullptr;
 }
@@ -456,6 +718,84 @@ void MusicalContext::sortRegionSequencesByOrderIndex () noexcept
     std::sort (_regionSequences.begin (), _regionSequences.end (), sortByOrderIndex);
 }
 
+void MusicalContext::enableContentStore () noexcept
+{
+    _isContentStoreEnabled = true;
+    addPendingContentUpdate (nullptr, ContentUpdateScopes::everythingIsAffected ());
+}
+
+void MusicalContext::addPendingContentUpdate (const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept
+{
+    if (!_isContentStoreEnabled)
+        return;
+
+    if (!_hasPendingContentUpdate)
+    {
+        _pendingContentUpdateScopes = scopeFlags;
+        _pendingContentUpdateHasRange = (range != nullptr);
+        if (range)
+            _pendingContentUpdateRange = *range;
+        _hasPendingContentUpdate = true;
+    }
+    else
+    {
+        _pendingContentUpdateScopes += scopeFlags;
+        if (!range)
+        {
+            _pendingContentUpdateHasRange = false;
+        }
+        else if (_pendingContentUpdateHasRange)
+        {
+            const auto start { std::min (_pendingContentUpdateRange.start, range->start) };
+            const auto end { std::max (_pendingContentUpdateRange.start + _pendingContentUpdateRange.duration, range->start + range->duration) };
+            _pendingContentUpdateRange = { start, end - start };
+        }
+    }
+}
+
+void MusicalContext::applyPendingContentUpdate () noexcept
+{
+    if (!_hasPendingContentUpdate)
+        return;
+    _hasPendingContentUpdate = false;
+
+    const auto previous { std::atomic_load (&_content) };
+    const auto range { (previous && _pendingContentUpdateHasRange) ? &_pendingContentUpdateRange : nullptr };
+    const auto scopeFlags { (previous) ? _pendingContentUpdateScopes : ContentUpdateScopes::everythingIsAffected () };
+
+    auto content { std::make_shared<MusicalContextContent> () };
+    if (previous)
+        *content = *previous;
+    ++content->_version;
+
+    const double timeRange[2] { (range) ? range->start : 0.0, (range) ? range->start + range->duration : 0.0 };
+    if (scopeFlags.affectTimeline ())
+        content->_tempoEntries = readMusicalContextContent<kARAContentTypeTempoEntries> (this, content->_tempoEntries.get (), range, timeRange);
+
+    // the remaining types are positioned in quarters, so the range must be converted using the (updated) tempo map
+    double quarterRange[2] { 0.0, 0.0 };
+    const bool canConvertRange { range && content->_tempoEntries->isAvailable && (content->_tempoEntries->events.size () >= 2) };
+    if (canConvertRange)
+    {
+        const TempoConverter<std::vector<ARAContentTempoEntry>> tempoConverter { content->_tempoEntries->events };
+        quarterRange[0] = tempoConverter.getQuarterForTime (timeRange[0]);
+        quarterRange[1] = tempoConverter.getQuarterForTime (timeRange[1]);
+    }
+    const auto quarterRangePtr { (canConvertRange) ? quarterRange : nullptr };
+
+    if (scopeFlags.affectTimeline ())
+        content->_barSignatures = readMusicalContextContent<kARAContentTypeBarSignatures> (this, content->_barSignatures.get (), range, quarterRangePtr);
+    if (scopeFlags.affectTuning ())
+        content->_tuning = readMusicalContextContent<kARAContentTypeStaticTuning> (this, nullptr, nullptr, nullptr);
+    if (scopeFlags.affectHarmonies ())
+    {
+        content->_keySignatures = readMusicalContextContent<kARAContentTypeKeySignatures> (this, content->_keySignatures.get (), range, quarterRangePtr);
+        content->_sheetChords = readMusicalContextContent<kARAContentTypeSheetChords> (this, content->_sheetChords.get (), range, quarterRangePtr);
+    }
+
+    std::atomic_store (&_content, std::shared_ptr<const MusicalContextContent> { std::move (content) });
+}
+
 /*******************************************************************************/
 
 RegionSequence::RegionSequence (Document* document, ARARegionSequenceHostRef hostRef) noexcept
@@ -471,13 +811,28 @@ RegionSequence::~RegionSequence () noexcept
     _document->removeRegionSequence (this);
 }
 
+PropertyChanges RegionSequence::getPropertyChanges (PropertiesPtr<ARARegionSequenceProperties> newProperties) const noexcept
+{
+    PropertyChanges changes { 0 };
+    if (_name != newProperties->name)
+        changes |= kNameChanged;
+    if (_orderIndex != newProperties->orderIndex)
+        changes |= kOrderIndexChanged;
+    const auto color { (newProperties.implements<ARA_STRUCT_MEMBER (ARARegionSequenceProperties, color)> ()) ? newProperties->color : nullptr };
+    if (_color != color)
+        changes |= kColorChanged;
+    if (_musicalContext != fromRef (newProperties->musicalContextRef))
+        changes |= kMusicalContextChanged;
+    return changes;
+}
+
 void RegionSequence::updateProperties (PropertiesPtr<ARARegionSequenceProperties> properties) noexcept
 {
-    _name = properties->name;
+    _name.assign (properties->name, _document->getPropertyPool ());
     _orderIndex = properties->orderIndex;
 
     if (properties.implements<ARA_STRUCT_MEMBER (ARARegionSequenceProperties, color)> ())
-        _color = properties->color;
+        _color.assign (properties->color, _document->getPropertyPool ());
     else
         _color = nullptr;
 
@@ -512,9 +867,83 @@ AudioSource::~AudioSource () noexcept
     _document->removeAudioSource (this);
 }
 
+void AudioSource::purgeAudioReaderPool () noexcept
+{
+    purgeAudioReaderPool (false);
+}
+
+void AudioSource::purgeAudioReaderPool (bool willBeDestroyed) noexcept
+{
+    // destroy the readers outside the lock since this calls into the host
+    std::vector<std::unique_ptr<HostAudioReader>> purgedReaders[2];
+    {
+        std::lock_guard<std::mutex> lock { _audioReaderPoolMutex };
+        // checked out readers are returned to this object, so they must not outlive it
+        ARA_INTERNAL_ASSERT (!willBeDestroyed || (_checkedOutAudioReadersCount == 0));
+        ++_audioReaderPoolGeneration;
+        purgedReaders[0].swap (_audioReaderPool[0]);
+        purgedReaders[1].swap (_audioReaderPool[1]);
+    }
+}
+
+std::unique_ptr<HostAudioReader> AudioSource::checkOutAudioReader (bool use64BitSamples, uint64_t& poolGeneration) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock { _audioReaderPoolMutex };
+        ++_checkedOutAudioReadersCount;
+        poolGeneration = _audioReaderPoolGeneration;
+        auto& pool { _audioReaderPool[use64BitSamples ? 1 : 0] };
+        if (!pool.empty ())
+        {
+            auto audioReader { std::move (pool.back ()) };
+            pool.pop_back ();
+            return audioReader;
+        }
+    }
+    return std::unique_ptr<HostAudioReader> { new HostAudioReader { this, use64BitSamples } };
+}
+
+void AudioSource::checkInAudioReader (std::unique_ptr<HostAudioReader> audioReader, bool use64BitSamples, uint64_t poolGeneration) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock { _audioReaderPoolMutex };
+        ARA_INTERNAL_ASSERT (_checkedOutAudioReadersCount > 0);
+        --_checkedOutAudioReadersCount;
+        if (poolGeneration == _audioReaderPoolGeneration)
+        {
+            _audioReaderPool[use64BitSamples ? 1 : 0].push_back (std::move (audioReader));
+            return;
+        }
+    }
+    // if the pool has been purged meanwhile, the reader is destroyed here (outside the lock)
+}
+
+PropertyChanges AudioSource::getPropertyChanges (PropertiesPtr<ARAAudioSourceProperties> newProperties) const noexcept
+{
+    PropertyChanges changes { 0 };
+    if (_name != newProperties->name)
+        changes |= kNameChanged;
+    if ((newProperties->persistentID == nullptr) || (_persistentID != newProperties->persistentID))
+        changes |= kPersistentIDChanged;
+    if (_sampleCount != newProperties->sampleCount)
+        changes |= kSampleCountChanged;
+    if (_sampleRate != newProperties->sampleRate)
+        changes |= kSampleRateChanged;
+    if (_channelCount != newProperties->channelCount)
+        changes |= kChannelCountChanged;
+    if (_merits64BitSamples != (newProperties->merits64BitSamples != kARAFalse))
+        changes |= kMerits64BitSamplesChanged;
+
+    const auto channelArrangement { (newProperties.implements<ARA_STRUCT_MEMBER (ARAAudioSourceProperties, channelArrangement)> ()) ?
+                                    ChannelArrangement { newProperties->channelArrangementDataType, newProperties->channelArrangement } : ChannelArrangement {} };
+    if (ChannelArrangement { _channelArrangementDataType, (_channelArrangementData.empty ()) ? nullptr : _channelArrangementData.data () } != channelArrangement)
+        changes |= kChannelArrangementChanged;
+    return changes;
+}
+
 void AudioSource::updateProperties (PropertiesPtr<ARAAudioSourceProperties> properties) noexcept
 {
-    _name = properties->name;
+    _name.assign (properties->name, _document->getPropertyPool ());
 
     ARA_VALIDATE_API_ARGUMENT (properties->persistentID, properties->persistentID != nullptr);
     ARA_VALIDATE_API_ARGUMENT (properties->persistentID, std::strlen (properties->persistentID) > 0);
@@ -525,10 +954,15 @@ void AudioSource::updateProperties (PropertiesPtr<ARAAudioSourceProperties> prop
     _channelCount = properties->channelCount;
     _merits64BitSamples = (properties->merits64BitSamples != kARAFalse);
 
-    if (properties.implements<ARA_STRUCT_MEMBER (ARAAudioSourceProperties, channelArrangement)> ())
-        doUpdateChannelArrangement (ChannelArrangement { properties->channelArrangementDataType, properties->channelArrangement });
+    const auto channelArrangement { (properties.implements<ARA_STRUCT_MEMBER (ARAAudioSourceProperties, channelArrangement)> ()) ?
+                                    ChannelArrangement { properties->channelArrangementDataType, properties->channelArrangement } : ChannelArrangement {} };
+    _channelArrangementDataType = channelArrangement.getChannelArrangementDataType ();
+    const auto channelArrangementData { static_cast<const ARAByte*> (channelArrangement.getChannelArrangement ()) };
+    if (channelArrangementData)
+        _channelArrangementData.assign (channelArrangementData, channelArrangementData + channelArrangement.getDataSize ());
     else
-        doUpdateChannelArrangement (ChannelArrangement {});
+        _channelArrangementData.clear ();
+    doUpdateChannelArrangement (channelArrangement);
 }
 
 /*******************************************************************************/
@@ -553,9 +987,19 @@ const OptionalProperty<ARAUtf8String>& AudioModification::getEffectiveName () co
     return _audioSource->getName ();
 }
 
+PropertyChanges AudioModification::getPropertyChanges (PropertiesPtr<ARAAudioModificationProperties> newProperties) const noexcept
+{
+    PropertyChanges changes { 0 };
+    if (_name != newProperties->name)
+        changes |= kNameChanged;
+    if ((newProperties->persistentID == nullptr) || (_persistentID != newProperties->persistentID))
+        changes |= kPersistentIDChanged;
+    return changes;
+}
+
 void AudioModification::updateProperties (PropertiesPtr<ARAAudioModificationProperties> properties) noexcept
 {
-    _name = properties->name;
+    _name.assign (properties->name, _audioSource->getDocument ()->getPropertyPool ());
 
     ARA_VALIDATE_API_ARGUMENT (properties->persistentID, properties->persistentID != nullptr);
     ARA_VALIDATE_API_ARGUMENT (properties->persistentID, std::strlen (properties->persistentID) > 0);
@@ -593,6 +1037,50 @@ const OptionalProperty<ARAColor*>& PlaybackRegion::getEffectiveColor () const no
     return _regionSequence->getColor ();
 }
 
+PropertyChanges PlaybackRegion::getPropertyChanges (PropertiesPtr<ARAPlaybackRegionProperties> newProperties) const noexcept
+{
+    PropertyChanges changes { 0 };
+    if (_startInAudioModificationTime != newProperties->startInModificationTime)
+        changes |= kStartInAudioModificationTimeChanged;
+    if (_durationInAudioModificationTime != newProperties->durationInModificationTime)
+        changes |= kDurationInAudioModificationTimeChanged;
+    if (_startInPlaybackTime != newProperties->startInPlaybackTime)
+        changes |= kStartInPlaybackTimeChanged;
+    if (_durationInPlaybackTime != newProperties->durationInPlaybackTime)
+        changes |= kDurationInPlaybackTimeChanged;
+
+    const auto transformationFlags { newProperties->transformationFlags };
+    if ((_timestretchEnabled != ((transformationFlags & kARAPlaybackTransformationTimestretch) != 0)) ||
+        (_timestretchReflectingTempo != ((transformationFlags & kARAPlaybackTransformationTimestretchReflectingTempo) != 0)) ||
+        (_contentBasedFadeAtHead != ((transformationFlags & kARAPlaybackTransformationContentBasedFadeAtHead) != 0)) ||
+        (_contentBasedFadeAtTail != ((transformationFlags & kARAPlaybackTransformationContentBasedFadeAtTail) != 0)))
+        changes |= kTransformationFlagsChanged;
+
+    const auto name { (newProperties.implements<ARA_STRUCT_MEMBER (ARAPlaybackRegionProperties, name)> ()) ? newProperties->name : nullptr };
+    if (_name != name)
+        changes |= kNameChanged;
+    const auto color { (newProperties.implements<ARA_STRUCT_MEMBER (ARAPlaybackRegionProperties, color)> ()) ? newProperties->color : nullptr };
+    if (_color != color)
+        changes |= kColorChanged;
+
+#if ARA_SUPPORT_VERSION_1
+    if (newProperties.implements<ARA_STRUCT_MEMBER (ARAPlaybackRegionProperties, regionSequenceRef)> ())
+    {
+        if (_regionSequence != fromRef (newProperties->regionSequenceRef))
+            changes |= kRegionSequenceChanged;
+    }
+    else
+    {
+        if (_musicalContext != fromRef (newProperties->musicalContextRef))
+            changes |= kMusicalContextChanged;
+    }
+#else
+    if (_regionSequence != fromRef (newProperties->regionSequenceRef))
+        changes |= kRegionSequenceChanged;
+#endif
+    return changes;
+}
+
 void PlaybackRegion::updateProperties (PropertiesPtr<ARAPlaybackRegionProperties> properties) noexcept
 {
     ARA_VALIDATE_API_ARGUMENT (properties, properties->durationInModificationTime >= 0.0);
@@ -617,13 +1105,14 @@ void PlaybackRegion::updateProperties (PropertiesPtr<ARAPlaybackRegionProperties
     _contentBasedFadeAtHead = ((properties->transformationFlags & kARAPlaybackTransformationContentBasedFadeAtHead) != 0);
     _contentBasedFadeAtTail = ((properties->transformationFlags & kARAPlaybackTransformationContentBasedFadeAtTail) != 0);
 
+    auto propertyPool { _audioModification->getAudioSource ()->getDocument ()->getPropertyPool () };
     if (properties.implements<ARA_STRUCT_MEMBER (ARAPlaybackRegionProperties, name)> ())
-        _name = properties->name;
+        _name.assign (properties->name, propertyPool);
     else
         _name = nullptr;
 
     if (properties.implements<ARA_STRUCT_MEMBER (ARAPlaybackRegionProperties, color)> ())
-        _color = properties->color;
+        _color.assign (properties->color, propertyPool);
     else
         _color = nullptr;
 
@@ -694,6 +1183,65 @@ ARASamplePosition PlaybackRegion::getEndInPlaybackSamples (ARASampleRate playbac
     return samplePositionAtTime (getEndInPlaybackTime (), playbackSampleRate);
 }
 
+double PlaybackRegion::getTimeStretchFactor () const noexcept
+{
+    if (!_timestretchEnabled || (_durationInAudioModificationTime <= 0.0) || (_durationInPlaybackTime <= 0.0))
+        return 1.0;
+    return _durationInPlaybackTime / _durationInAudioModificationTime;
+}
+
+// the mapping kernels, shared by the single position and batch variants to ensure identical results
+struct PlaybackRegionTimeMapping
+{
+    ARATimePosition fromStart;
+    ARATimePosition toStart;
+    double factor;
+
+    inline ARATimePosition map (ARATimePosition position) const noexcept { return toStart + (position - fromStart) * factor; }
+};
+
+ARATimePosition PlaybackRegion::mapAudioModificationTimeToPlaybackTime (ARATimePosition modificationTime) const noexcept
+{
+    const PlaybackRegionTimeMapping mapping { _startInAudioModificationTime, _startInPlaybackTime, getTimeStretchFactor () };
+    return mapping.map (modificationTime);
+}
+
+ARATimePosition PlaybackRegion::mapPlaybackTimeToAudioModificationTime (ARATimePosition playbackTime) const noexcept
+{
+    const PlaybackRegionTimeMapping mapping { _startInPlaybackTime, _startInAudioModificationTime, 1.0 / getTimeStretchFactor () };
+    return mapping.map (playbackTime);
+}
+
+void PlaybackRegion::mapAudioModificationTimesToPlaybackTimes (const ARATimePosition* modificationTimes, ARATimePosition* playbackTimes, size_t count) const noexcept
+{
+    const PlaybackRegionTimeMapping mapping { _startInAudioModificationTime, _startInPlaybackTime, getTimeStretchFactor () };
+    for (size_t i { 0 }; i < count; ++i)
+        playbackTimes[i] = mapping.map (modificationTimes[i]);
+}
+
+void PlaybackRegion::mapPlaybackTimesToAudioModificationTimes (const ARATimePosition* playbackTimes, ARATimePosition* modificationTimes, size_t count) const noexcept
+{
+    const PlaybackRegionTimeMapping mapping { _startInPlaybackTime, _startInAudioModificationTime, 1.0 / getTimeStretchFactor () };
+    for (size_t i { 0 }; i < count; ++i)
+        modificationTimes[i] = mapping.map (playbackTimes[i]);
+}
+
+void PlaybackRegion::mapAudioModificationSamplesToPlaybackSamples (const ARASamplePosition* modificationSamples, ARASamplePosition* playbackSamples, size_t count, ARASampleRate playbackSampleRate) const noexcept
+{
+    const PlaybackRegionTimeMapping mapping { _startInAudioModificationTime, _startInPlaybackTime, getTimeStretchFactor () };
+    const auto modificationSampleRate { _audioModification->getAudioSource ()->getSampleRate () };
+    for (size_t i { 0 }; i < count; ++i)
+        playbackSamples[i] = samplePositionAtTime (mapping.map (timeAtSamplePosition (modificationSamples[i], modificationSampleRate)), playbackSampleRate);
+}
+
+void PlaybackRegion::mapPlaybackSamplesToAudioModificationSamples (const ARASamplePosition* playbackSamples, ARASamplePosition* modificationSamples, size_t count, ARASampleRate playbackSampleRate) const noexcept
+{
+    const PlaybackRegionTimeMapping mapping { _startInPlaybackTime, _startInAudioModificationTime, 1.0 / getTimeStretchFactor () };
+    const auto modificationSampleRate { _audioModification->getAudioSource ()->getSampleRate () };
+    for (size_t i { 0 }; i < count; ++i)
+        modificationSamples[i] = samplePositionAtTime (mapping.map (timeAtSamplePosition (playbackSamples[i], playbackSampleRate)), modificationSampleRate);
+}
+
 void PlaybackRegion::setRegionSequence (RegionSequence* regionSequence) noexcept
 {
     if (_regionSequence != regionSequence)
@@ -930,9 +1478,9 @@ void DocumentController::initializeDocument (const ARADocumentProperties* proper
     ARA_INTERNAL_ASSERT (_document != nullptr);
     ARA_LOG_MODELOBJECT_LIFETIME ("did create document", getDocument ());
 
-    willUpdateDocumentProperties (_document, properties);
+    willUpdateDocumentPropertiesWithChanges (_document, properties, kAllPropertiesChanged);
     _document->updateProperties (properties);
-    didUpdateDocumentProperties (_document);
+    didUpdateDocumentPropertiesWithChanges (_document, kAllPropertiesChanged);
 }
 
 void DocumentController::destroyDocumentController () noexcept
@@ -1063,6 +1611,11 @@ void DocumentController::endEditing () noexcept
 
     _isHostEditingDocument = false;
 
+    for (auto musicalContext : _document->getMusicalContexts ())
+        musicalContext->applyPendingContentUpdate ();
+
+    _updateRenderLayouts ();
+
     didEndEditing ();
 
     ARA_LOG_EDITED_DOCUMENT ("finished editing document", _document);
@@ -1083,6 +1636,9 @@ void DocumentController::notifyModelUpdates () noexcept
     ARA_VALIDATE_API_ARGUMENT (this, isValidDocumentController (this));
     ARA_VALIDATE_API_STATE (_contentReaders.empty ());
 
+    if (_renderLayoutsNeedUpdate && !isHostEditingDocument ())
+        _updateRenderLayouts ();
+
     auto hostModelUpdateController { getHostModelUpdateController () };
     if (!hostModelUpdateController)
         return;
@@ -1210,9 +1766,10 @@ void DocumentController::updateDocumentProperties (PropertiesPtr<ARADocumentProp
     ARA_VALIDATE_API_STATE (_contentReaders.empty ());
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARADocumentProperties);
 
-    willUpdateDocumentProperties (_document, properties);
+    const auto changes { _document->getPropertyChanges (properties) };
+    willUpdateDocumentPropertiesWithChanges (_document, properties, changes);
     _document->updateProperties (properties);
-    didUpdateDocumentProperties (_document);
+    didUpdateDocumentPropertiesWithChanges (_document, changes);
 
     ARA_LOG_PROPERTY_CHANGES ("did update properties of document", _document);
 }
@@ -1241,9 +1798,9 @@ ARAMusicalContextRef DocumentController::createMusicalContext (ARAMusicalContext
 
     _willChangeMusicalContextOrder ();
 
-    willUpdateMusicalContextProperties (musicalContext, properties);
+    willUpdateMusicalContextPropertiesWithChanges (musicalContext, properties, kAllPropertiesChanged);
     musicalContext->updateProperties (properties);
-    didUpdateMusicalContextProperties (musicalContext);
+    didUpdateMusicalContextPropertiesWithChanges (musicalContext, kAllPropertiesChanged);
 
     didAddMusicalContextToDocument (_document, musicalContext);
 
@@ -1271,9 +1828,10 @@ void DocumentController::updateMusicalContextProperties (ARAMusicalContextRef mu
         }
     }
 
-    willUpdateMusicalContextProperties (musicalContext, properties);
+    const auto changes { musicalContext->getPropertyChanges (properties) };
+    willUpdateMusicalContextPropertiesWithChanges (musicalContext, properties, changes);
     musicalContext->updateProperties (properties);
-    didUpdateMusicalContextProperties (musicalContext);
+    didUpdateMusicalContextPropertiesWithChanges (musicalContext, changes);
 
     ARA_LOG_PROPERTY_CHANGES ("did update properties of musical context", musicalContext);
 }
@@ -1287,6 +1845,13 @@ void DocumentController::updateMusicalContextContent (ARAMusicalContextRef music
 
     auto musicalContext { fromRef (musicalContextRef) };
     ARA_VALIDATE_API_ARGUMENT (musicalContextRef, isValidMusicalContext (musicalContext));
+
+    musicalContext->_contentGenerations.update (flags);
+    for (const auto& regionSequence : musicalContext->getRegionSequences ())
+        _invalidateMusicalContextDependentContent (regionSequence, range, flags);
+
+    musicalContext->addPendingContentUpdate (range, flags);
+
     doUpdateMusicalContextContent (musicalContext, range, flags);
 }
 
@@ -1345,9 +1910,9 @@ ARARegionSequenceRef DocumentController::createRegionSequence (ARARegionSequence
 
     _willChangeRegionSequenceOrder (musicalContext);
 
-    willUpdateRegionSequenceProperties (regionSequence, properties);
+    willUpdateRegionSequencePropertiesWithChanges (regionSequence, properties, kAllPropertiesChanged);
     regionSequence->updateProperties (properties);
-    didUpdateRegionSequenceProperties (regionSequence);
+    didUpdateRegionSequencePropertiesWithChanges (regionSequence, kAllPropertiesChanged);
 
     didAddRegionSequenceToDocument (_document, regionSequence);
 
@@ -1383,9 +1948,13 @@ void DocumentController::updateRegionSequenceProperties (ARARegionSequenceRef re
     if (musicalContextChange)
         willRemoveRegionSequenceFromMusicalContext (currentMusicalContext, regionSequence);
 
-    willUpdateRegionSequenceProperties (regionSequence, properties);
+    const auto changes { regionSequence->getPropertyChanges (properties) };
+    willUpdateRegionSequencePropertiesWithChanges (regionSequence, properties, changes);
     regionSequence->updateProperties (properties);
-    didUpdateRegionSequenceProperties (regionSequence);
+    didUpdateRegionSequencePropertiesWithChanges (regionSequence, changes);
+
+    if (musicalContextChange)
+        _invalidateMusicalContextDependentContent (regionSequence, nullptr, ContentUpdateScopes::everythingIsAffected ());
 
     if (musicalContextChange)
         didAddRegionSequenceToMusicalContext (newMusicalContext, regionSequence);
@@ -1451,9 +2020,9 @@ ARAAudioSourceRef DocumentController::createAudioSource (ARAAudioSourceHostRef h
 
     _validateAudioSourceChannelArrangement (properties);
     
-    willUpdateAudioSourceProperties (audioSource, properties);
+    willUpdateAudioSourcePropertiesWithChanges (audioSource, properties, kAllPropertiesChanged);
     audioSource->updateProperties (properties);
-    didUpdateAudioSourceProperties (audioSource);
+    didUpdateAudioSourcePropertiesWithChanges (audioSource, kAllPropertiesChanged);
 
     didAddAudioSourceToDocument (_document, audioSource);
 
@@ -1482,9 +2051,13 @@ void DocumentController::updateAudioSourceProperties (ARAAudioSourceRef audioSou
 
     _validateAudioSourceChannelArrangement (properties);
 
-    willUpdateAudioSourceProperties (audioSource, properties);
+    const auto changes { audioSource->getPropertyChanges (properties) };
+    willUpdateAudioSourcePropertiesWithChanges (audioSource, properties, changes);
     audioSource->updateProperties (properties);
-    didUpdateAudioSourceProperties (audioSource);
+    didUpdateAudioSourcePropertiesWithChanges (audioSource, changes);
+
+    if ((changes & (AudioSource::kSampleCountChanged | AudioSource::kSampleRateChanged | AudioSource::kChannelCountChanged | AudioSource::kChannelArrangementChanged)) != 0)
+        _invalidateContent (audioSource, ContentUpdateScopes::everythingIsAffected ());
 
     ARA_LOG_PROPERTY_CHANGES ("did update properties of audio source", audioSource);
 }
@@ -1498,6 +2071,9 @@ void DocumentController::updateAudioSourceContent (ARAAudioSourceRef audioSource
 
     auto audioSource { fromRef (audioSourceRef) };
     ARA_VALIDATE_API_ARGUMENT (audioSourceRef, isValidAudioSource (audioSource));
+
+    _invalidateContent (audioSource, flags);
+
     doUpdateAudioSourceContent (audioSource, range, flags);
 }
 
@@ -1511,6 +2087,8 @@ void DocumentController::enableAudioSourceSamplesAccess (ARAAudioSourceRef audio
     if (enable != audioSource->isSampleAccessEnabled ())
     {
         willEnableAudioSourceSamplesAccess (audioSource, enable);
+        if (!enable)
+            audioSource->purgeAudioReaderPool ();
         audioSource->setSampleAccessEnabled (enable);
         didEnableAudioSourceSamplesAccess (audioSource, enable);
     }
@@ -1548,6 +2126,7 @@ void DocumentController::destroyAudioSource (ARAAudioSourceRef audioSourceRef) n
 
     ARA_LOG_MODELOBJECT_LIFETIME ("will destroy audio source", audioSource);
     willDestroyAudioSource (audioSource);
+    audioSource->purgeAudioReaderPool (true);
 
     _audioSourceContentUpdates.erase (audioSource);
 
@@ -1570,9 +2149,9 @@ ARAAudioModificationRef DocumentController::createAudioModification (ARAAudioSou
     auto audioModification { doCreateAudioModification (audioSource, hostRef, nullptr) };
     ARA_INTERNAL_ASSERT (audioModification != nullptr);
 
-    willUpdateAudioModificationProperties (audioModification, properties);
+    willUpdateAudioModificationPropertiesWithChanges (audioModification, properties, kAllPropertiesChanged);
     audioModification->updateProperties (properties);
-    didUpdateAudioModificationProperties (audioModification);
+    didUpdateAudioModificationPropertiesWithChanges (audioModification, kAllPropertiesChanged);
 
     didAddAudioModificationToAudioSource (audioSource, audioModification);
 
@@ -1592,9 +2171,9 @@ ARAAudioModificationRef DocumentController::cloneAudioModification (ARAAudioModi
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioModificationProperties);
 
     auto clonedAudioModification { doCreateAudioModification (srcAudioModification->getAudioSource (), hostRef, srcAudioModification) };
-    willUpdateAudioModificationProperties (clonedAudioModification, properties);
+    willUpdateAudioModificationPropertiesWithChanges (clonedAudioModification, properties, kAllPropertiesChanged);
     clonedAudioModification->updateProperties (properties);
-    didUpdateAudioModificationProperties (clonedAudioModification);
+    didUpdateAudioModificationPropertiesWithChanges (clonedAudioModification, kAllPropertiesChanged);
 
     ARA_LOG_MODELOBJECT_LIFETIME ("did create cloned audio modification", clonedAudioModification);
     return toRef (clonedAudioModification);
@@ -1611,9 +2190,10 @@ void DocumentController::updateAudioModificationProperties (ARAAudioModification
     ARA_VALIDATE_API_ARGUMENT (audioModificationRef, isValidAudioModification (audioModification));
     ARA_VALIDATE_API_STRUCT_PTR (properties, ARAAudioModificationProperties);
 
-    willUpdateAudioModificationProperties (audioModification, properties);
+    const auto changes { audioModification->getPropertyChanges (properties) };
+    willUpdateAudioModificationPropertiesWithChanges (audioModification, properties, changes);
     audioModification->updateProperties (properties);
-    didUpdateAudioModificationProperties (audioModification);
+    didUpdateAudioModificationPropertiesWithChanges (audioModification, changes);
 
     ARA_LOG_PROPERTY_CHANGES ("did update properties of audio modification", audioModification);
 }
@@ -1682,12 +2262,14 @@ ARAPlaybackRegionRef DocumentController::createPlaybackRegion (ARAAudioModificat
     auto playbackRegion { doCreatePlaybackRegion (audioModification, hostRef) };
     ARA_INTERNAL_ASSERT (playbackRegion != nullptr);
 
-    willUpdatePlaybackRegionProperties (playbackRegion, properties);
+    willUpdatePlaybackRegionPropertiesWithChanges (playbackRegion, properties, kAllPropertiesChanged);
     playbackRegion->updateProperties (properties);
-    didUpdatePlaybackRegionProperties (playbackRegion);
+    didUpdatePlaybackRegionPropertiesWithChanges (playbackRegion, kAllPropertiesChanged);
 
     didAddPlaybackRegionToAudioModification (audioModification, playbackRegion);
 
+    _invalidateContent (playbackRegion, ContentUpdateScopes::everythingIsAffected ());
+
     auto regionSequence { playbackRegion->getRegionSequence () };
 #if ARA_SUPPORT_VERSION_1
     if (regionSequence)
@@ -1717,9 +2299,18 @@ void DocumentController::updatePlaybackRegionProperties (ARAPlaybackRegionRef pl
     if (currentSequence && (currentSequence != newSequence))
         willRemovePlaybackRegionFromRegionSequence (currentSequence, playbackRegion);
 
-    willUpdatePlaybackRegionProperties (playbackRegion, properties);
+    // the content is affected by all but cosmetic changes, both at the old and the new position
+    const auto changes { playbackRegion->getPropertyChanges (properties) };
+    const bool contentChange { (changes & ~(PlaybackRegion::kNameChanged | PlaybackRegion::kColorChanged)) != 0 };
+    if (contentChange)
+        _invalidateContent (playbackRegion, ContentUpdateScopes::everythingIsAffected ());
+
+    willUpdatePlaybackRegionPropertiesWithChanges (playbackRegion, properties, changes);
     playbackRegion->updateProperties (properties);
-    didUpdatePlaybackRegionProperties (playbackRegion);
+    didUpdatePlaybackRegionPropertiesWithChanges (playbackRegion, changes);
+
+    if (contentChange)
+        _invalidateContent (playbackRegion, ContentUpdateScopes::everythingIsAffected ());
 
 #if ARA_SUPPORT_VERSION_1
     if (newSequence)
@@ -1763,6 +2354,8 @@ void DocumentController::destroyPlaybackRegion (ARAPlaybackRegionRef playbackReg
         ARA_VALIDATE_API_STATE (!contains (playbackRenderer->getPlaybackRegions (), playbackRegion));
 #endif
 
+    _invalidateContent (playbackRegion, ContentUpdateScopes::everythingIsAffected ());
+
 #if ARA_SUPPORT_VERSION_1
     if (playbackRegion->getRegionSequence ())
 #endif
@@ -2256,24 +2849,214 @@ void DocumentController::notifyAudioSourceContentChanged (AudioSource* audioSour
 {
     ARA_INTERNAL_ASSERT (scopeFlags.affectEverything () || !scopeFlags.affectSamples ());
 
+    _invalidateContent (audioSource, scopeFlags);
+
+    if (scopeFlags.affectSamples ())
+        _renderLayoutsNeedUpdate = true;
+
     if (getHostModelUpdateController ())
         _audioSourceContentUpdates[audioSource] += scopeFlags;
 }
 
 void DocumentController::notifyAudioModificationContentChanged (AudioModification* audioModification, ContentUpdateScopes scopeFlags) noexcept
 {
+    _invalidateContent (audioModification, scopeFlags);
+
+    // the render layouts are updated in endEditing () or notifyModelUpdates (), so that they are
+    // only rebuilt once for all changes since the last update
+    if (scopeFlags.affectSamples ())
+        _renderLayoutsNeedUpdate = true;
+
     if (getHostModelUpdateController ())
         _audioModificationContentUpdates[audioModification] += scopeFlags;
 }
 
 void DocumentController::notifyPlaybackRegionContentChanged (PlaybackRegion* playbackRegion, ContentUpdateScopes scopeFlags) noexcept
 {
+    _invalidateContent (playbackRegion, scopeFlags);
+
+    if (scopeFlags.affectSamples ())
+        _renderLayoutsNeedUpdate = true;
+
     if (getHostModelUpdateController ())
         _playbackRegionContentUpdates[playbackRegion] += scopeFlags;
 }
 
 /*******************************************************************************/
 
+template <ARAContentType contentType>
+class RegionSequenceContentImplementation : public RegionSequenceContent
+{
+    using DataType = typename ContentTypeMapper<contentType>::DataType;
+
+public:
+    RegionSequenceContentImplementation () noexcept = default;
+
+    ARAContentType getContentType () const noexcept override { return contentType; }
+    ARAInt32 getEventCount () const noexcept override { return static_cast<ARAInt32> (_events.size ()); }
+    const void* getDataForEvent (ARAInt32 eventIndex) const noexcept override { return &_events[static_cast<size_t> (eventIndex)]; }
+
+protected:
+    void appendEvents (ContentReader* contentReader) noexcept override
+    {
+        const auto eventCount { contentReader->getEventCount () };
+        _events.reserve (_events.size () + static_cast<size_t> (eventCount));
+        for (auto i { 0 }; i < eventCount; ++i)
+        {
+            _events.push_back (*static_cast<const DataType*> (contentReader->getDataForEvent (i)));
+            retainContentEventStrings (_events.back (), _strings);
+        }
+    }
+
+    void sortEvents () noexcept override
+    {
+        std::stable_sort (_events.begin (), _events.end (),
+                          [] (const DataType& a, const DataType& b) { return getContentEventPosition (a) < getContentEventPosition (b); });
+    }
+
+private:
+    std::vector<DataType> _events;
+    std::deque<std::string> _strings;
+};
+
+// the types affected by the given scopes - note that pitch numbers depend on the tuning, and
+// that the positions of harmonic content are expressed in quarters and thus depend on the timeline
+static bool isRegionSequenceContentAffected (ARAContentType type, ContentUpdateScopes scopeFlags) noexcept
+{
+    switch (type)
+    {
+        case kARAContentTypeNotes: return scopeFlags.affectNotes () || scopeFlags.affectTuning ();
+        case kARAContentTypeKeySignatures:
+        case kARAContentTypeSheetChords: return scopeFlags.affectHarmonies () || scopeFlags.affectTimeline ();
+        default: return true;
+    }
+}
+
+// bounds the memory used if many different ranges are requested, e.g. while scrolling
+constexpr size_t kMaxCachedRegionSequenceContents { 16 };
+
+std::shared_ptr<const RegionSequenceContent> DocumentController::getRegionSequenceContent (RegionSequence* regionSequence, ARAContentType type, const ARAContentTimeRange* range) noexcept
+{
+    ARA_INTERNAL_ASSERT (regionSequence->getDocumentController () == this);
+
+    auto& contentCache { regionSequence->_contentCache };
+    for (const auto& entry : contentCache)
+    {
+        if ((entry.type == type) && (entry.hasRange == (range != nullptr)) &&
+            (!range || ((entry.range.start == range->start) && (entry.range.duration == range->duration))))
+            return entry.content;
+    }
+
+    std::unique_ptr<RegionSequenceContent> content;
+    switch (type)
+    {
+        case kARAContentTypeNotes: content.reset (new RegionSequenceContentImplementation<kARAContentTypeNotes>); break;
+        case kARAContentTypeKeySignatures: content.reset (new RegionSequenceContentImplementation<kARAContentTypeKeySignatures>); break;
+        case kARAContentTypeSheetChords: content.reset (new RegionSequenceContentImplementation<kARAContentTypeSheetChords>); break;
+        default: return nullptr;
+    }
+
+    for (const auto& playbackRegion : regionSequence->getPlaybackRegions ())
+    {
+        if (range && !playbackRegion->intersectsWithPlaybackTimeRange (*range))
+            continue;
+
+        if (!doIsPlaybackRegionContentAvailable (playbackRegion, type))
+            continue;
+
+        if (auto contentReader { doCreatePlaybackRegionContentReader (playbackRegion, type, range) })
+        {
+            content->appendEvents (contentReader);
+            doDestroyContentReader (contentReader);
+        }
+    }
+    content->sortEvents ();
+
+    std::shared_ptr<const RegionSequenceContent> result { std::move (content) };
+    if (contentCache.size () >= kMaxCachedRegionSequenceContents)
+        contentCache.erase (contentCache.begin ());
+    contentCache.push_back ({ type, range != nullptr, (range) ? *range : ARAContentTimeRange { 0.0, 0.0 }, result });
+    return result;
+}
+
+void DocumentController::invalidateRegionSequenceContent (RegionSequence* regionSequence, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept
+{
+    regionSequence->_contentGenerations.update (scopeFlags);
+
+    auto& contentCache { regionSequence->_contentCache };
+    contentCache.erase (std::remove_if (contentCache.begin (), contentCache.end (),
+                        [range, scopeFlags] (const RegionSequence::ContentCacheEntry& entry)
+                        {
+                            if (!isRegionSequenceContentAffected (entry.type, scopeFlags))
+                                return false;
+                            if (!range || !entry.hasRange)
+                                return true;
+                            return (entry.range.start <= range->start + range->duration) && (range->start <= entry.range.start + entry.range.duration);
+                        }), contentCache.end ());
+}
+
+void DocumentController::_invalidateContent (PlaybackRegion* playbackRegion, ContentUpdateScopes scopeFlags) noexcept
+{
+    playbackRegion->_contentGenerations.update (scopeFlags);
+
+    auto regionSequence { playbackRegion->getRegionSequence () };
+#if ARA_SUPPORT_VERSION_1
+    if (!regionSequence)
+        return;
+#endif
+
+    const ARAContentTimeRange range { playbackRegion->getStartInPlaybackTime (), playbackRegion->getDurationInPlaybackTime () };
+    invalidateRegionSequenceContent (regionSequence, &range, scopeFlags);
+}
+
+void DocumentController::_invalidateContent (AudioModification* audioModification, ContentUpdateScopes scopeFlags) noexcept
+{
+    audioModification->_contentGenerations.update (scopeFlags);
+
+    for (const auto& playbackRegion : audioModification->getPlaybackRegions ())
+        _invalidateContent (playbackRegion, scopeFlags);
+}
+
+void DocumentController::_invalidateContent (AudioSource* audioSource, ContentUpdateScopes scopeFlags) noexcept
+{
+    audioSource->_contentGenerations.update (scopeFlags);
+
+    for (const auto& audioModification : audioSource->getAudioModifications ())
+        _invalidateContent (audioModification, scopeFlags);
+}
+
+void DocumentController::_invalidateMusicalContextDependentContent (RegionSequence* regionSequence, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept
+{
+    // the content of the playback regions is mapped to the musical context, and the samples of
+    // regions that reflect the tempo also depend on its timeline
+    auto sequenceScopeFlags { scopeFlags };
+    for (const auto& playbackRegion : regionSequence->getPlaybackRegions ())
+    {
+        auto regionScopeFlags { scopeFlags };
+        if (scopeFlags.affectTimeline () && playbackRegion->isTimeStretchReflectingTempo ())
+            regionScopeFlags += ContentUpdateScopes::samplesAreAffected ();
+        playbackRegion->_contentGenerations.update (regionScopeFlags);
+        sequenceScopeFlags += regionScopeFlags;
+    }
+
+    invalidateRegionSequenceContent (regionSequence, range, sequenceScopeFlags);
+}
+
+/*******************************************************************************/
+
+void DocumentController::_updateRenderLayouts () noexcept
+{
+    _renderLayoutsNeedUpdate = false;
+
+    for (auto playbackRenderer : _playbackRenderers)
+    {
+        if (playbackRenderer->isRenderLayoutEnabled ())
+            playbackRenderer->updateRenderLayout ();
+    }
+}
+
+/*******************************************************************************/
+
 HostAudioReader::HostAudioReader (const AudioSource* audioSource, bool use64BitSamples) noexcept
 : HostAudioReader { audioSource->getDocumentController ()->getHostAudioAccessController (), audioSource->getHostRef (), use64BitSamples }
 {}
@@ -2310,6 +3093,44 @@ bool HostAudioReader::readAudioSamples (ARASamplePosition samplePosition, ARASam
 
 /*******************************************************************************/
 
+PooledHostAudioReader::PooledHostAudioReader (AudioSource* audioSource, bool use64BitSamples) noexcept
+: _audioSource { audioSource },
+  _use64BitSamples { use64BitSamples }
+{
+    _audioReader = _audioSource->checkOutAudioReader (_use64BitSamples, _poolGeneration);
+}
+
+PooledHostAudioReader::~PooledHostAudioReader () noexcept
+{
+    if (_audioReader)               // can only be a null_ptr after move c'tor/assigment
+        _audioSource->checkInAudioReader (std::move (_audioReader), _use64BitSamples, _poolGeneration);
+}
+
+PooledHostAudioReader::PooledHostAudioReader (PooledHostAudioReader&& other) noexcept
+: _audioSource { nullptr },
+  _use64BitSamples { false },
+  _poolGeneration { 0 }
+{
+    *this = std::move (other);
+}
+
+PooledHostAudioReader& PooledHostAudioReader::operator= (PooledHostAudioReader&& other) noexcept
+{
+    std::swap (_audioSource, other._audioSource);
+    std::swap (_audioReader, other._audioReader);
+    std::swap (_use64BitSamples, other._use64BitSamples);
+    std::swap (_poolGeneration, other._poolGeneration);
+    return *this;
+}
+
+bool PooledHostAudioReader::readAudioSamples (ARASamplePosition samplePosition, ARASampleCount samplesPerChannel, void* const buffers[]) const noexcept
+{
+    ARA_INTERNAL_ASSERT (_audioReader != nullptr);      // must not be called after moving from this instance
+    return _audioReader->readAudioSamples (samplePosition, samplesPerChannel, buffers);
+}
+
+/*******************************************************************************/
+
 HostArchiveReader::HostArchiveReader (DocumentController* documentController, ARAArchiveReaderHostRef archiveReaderHostRef) noexcept
 : _hostArchivingController { documentController->getHostArchivingController () },
   _hostRef { archiveReaderHostRef }
@@ -2464,6 +3285,36 @@ ARAContentTimeRange ViewSelection::getEffectiveTimeRange () const noexcept
 
 /*******************************************************************************/
 
+// The layout is stored in the time domain so that it does not depend on the playback sample rate.
+// Its entries are sorted by the start of the region including its head, and additionally store the
+// maximum end (including tail) of all entries up to and including themselves. This allows for
+// finding the first entry that may intersect a given block via the cursor (or a binary search), and
+// stopping at the first entry that starts after the block.
+struct PlaybackRenderer::RenderLayout
+{
+    struct Entry
+    {
+        PlaybackRegion* playbackRegion;
+        ARATimePosition startInPlaybackTime;
+        ARATimePosition endInPlaybackTime;
+        ARATimeDuration headTime;
+        ARATimeDuration tailTime;
+        ARATimePosition startInAudioModificationTime;
+        double timeStretchFactor;
+        ARASampleRate audioModificationSampleRate;
+        uint64_t playbackRegionRenderGeneration;
+        uint64_t audioModificationRenderGeneration;
+        ARATimePosition maxEndIncludingTail;
+
+        ARATimePosition getStartIncludingHead () const noexcept { return startInPlaybackTime - headTime; }
+        ARATimePosition getEndIncludingTail () const noexcept { return endInPlaybackTime + tailTime; }
+    };
+
+    std::vector<Entry> entries;
+    std::vector<RenderSegment> segments;    // pre-allocated storage for getRenderSegments ()
+    size_t cursor { 0 };                    // first entry that may intersect the last rendered block
+};
+
 PlaybackRenderer::PlaybackRenderer (DocumentController* documentController) noexcept
 : _documentController { documentController }
 {
@@ -2474,6 +3325,10 @@ PlaybackRenderer::~PlaybackRenderer () noexcept
 {
     if (_documentController)
         _documentController->removePlaybackRenderer (this);
+
+    delete _pendingRenderLayout.load (std::memory_order_acquire);
+    delete _retiredRenderLayout.load (std::memory_order_acquire);
+    delete _renderLayout;
 }
 
 void PlaybackRenderer::addPlaybackRegion (ARAPlaybackRegionRef playbackRegionRef) noexcept
@@ -2488,6 +3343,9 @@ void PlaybackRenderer::addPlaybackRegion (ARAPlaybackRegionRef playbackRegionRef
     willAddPlaybackRegion (playbackRegion);
     _playbackRegions.push_back (playbackRegion);
     didAddPlaybackRegion (playbackRegion);
+
+    if (_isRenderLayoutEnabled)
+        updateRenderLayout ();
 }
 
 void PlaybackRenderer::removePlaybackRegion (ARAPlaybackRegionRef playbackRegionRef) noexcept
@@ -2502,6 +3360,120 @@ void PlaybackRenderer::removePlaybackRegion (ARAPlaybackRegionRef playbackRegion
     willRemovePlaybackRegion (playbackRegion);
     find_erase (_playbackRegions, playbackRegion);
     didRemovePlaybackRegion (playbackRegion);
+
+    if (_isRenderLayoutEnabled)
+        updateRenderLayout ();
+}
+
+void PlaybackRenderer::enableRenderLayout () noexcept
+{
+    _isRenderLayoutEnabled = true;
+    updateRenderLayout ();
+}
+
+void PlaybackRenderer::updateRenderLayout () noexcept
+{
+    ARA_INTERNAL_ASSERT (_isRenderLayoutEnabled);
+    if (!_documentController)
+        return;
+
+    auto layout { new RenderLayout };
+    layout->entries.reserve (_playbackRegions.size ());
+    for (auto playbackRegion : _playbackRegions)
+    {
+        ARATimeDuration headTime { 0.0 };
+        ARATimeDuration tailTime { 0.0 };
+        _documentController->doGetPlaybackRegionHeadAndTailTime (playbackRegion, &headTime, &tailTime);
+        layout->entries.push_back ({ playbackRegion, playbackRegion->getStartInPlaybackTime (), playbackRegion->getEndInPlaybackTime (),
+                                     headTime, tailTime, playbackRegion->getStartInAudioModificationTime (), playbackRegion->getTimeStretchFactor (),
+                                     playbackRegion->getAudioModification ()->getAudioSource ()->getSampleRate (),
+                                     playbackRegion->getRenderGeneration (), playbackRegion->getAudioModification ()->getRenderGeneration (), 0.0 });
+    }
+    std::sort (layout->entries.begin (), layout->entries.end (),
+               [] (const RenderLayout::Entry& a, const RenderLayout::Entry& b) { return a.getStartIncludingHead () < b.getStartIncludingHead (); });
+    auto maxEndIncludingTail { -std::numeric_limits<ARATimePosition>::infinity () };
+    for (auto& entry : layout->entries)
+        entry.maxEndIncludingTail = maxEndIncludingTail = std::max (maxEndIncludingTail, entry.getEndIncludingTail ());
+    layout->segments.resize (layout->entries.size ());
+
+    // publish the new layout, replacing any pending layout the render thread has not yet picked up,
+    // and dispose of the layout the render thread has last handed back
+    delete _pendingRenderLayout.exchange (layout, std::memory_order_acq_rel);
+    delete _retiredRenderLayout.exchange (nullptr, std::memory_order_acq_rel);
+}
+
+void PlaybackRenderer::adoptPendingRenderLayout () noexcept
+{
+    // the current layout can only be handed back once the model thread has disposed of the previous one
+    if (_retiredRenderLayout.load (std::memory_order_acquire) != nullptr)
+        return;
+
+    if (auto pendingLayout { _pendingRenderLayout.exchange (nullptr, std::memory_order_acq_rel) })
+    {
+        _retiredRenderLayout.store (_renderLayout, std::memory_order_release);
+        _renderLayout = pendingLayout;
+    }
+}
+
+PlaybackRenderer::RenderSegments PlaybackRenderer::getRenderSegments (ARASamplePosition blockStartInPlaybackSamples, ARASampleCount blockSampleCount, ARASampleRate playbackSampleRate) noexcept
+{
+    adoptPendingRenderLayout ();
+
+    const auto layout { _renderLayout };
+    if (!layout || (blockSampleCount <= 0))
+        return { nullptr, 0 };
+
+    // the time range is padded by a sample to account for rounding, the segments are clipped exactly below
+    const auto blockEndInPlaybackSamples { blockStartInPlaybackSamples + blockSampleCount };
+    const auto blockStartTime { timeAtSamplePosition (blockStartInPlaybackSamples - 1, playbackSampleRate) };
+    const auto blockEndTime { timeAtSamplePosition (blockEndInPlaybackSamples + 1, playbackSampleRate) };
+
+    // when playing forward, the cursor only needs to be advanced past the regions that have ended,
+    // upon jumping backwards (e.g. when looping) it is re-located via binary search
+    const auto& entries { layout->entries };
+    auto cursor { layout->cursor };
+    if ((cursor > 0) && (entries[cursor - 1].maxEndIncludingTail > blockStartTime))
+        cursor = static_cast<size_t> (std::partition_point (entries.begin (), entries.begin () + static_cast<std::ptrdiff_t> (cursor),
+                                                            [blockStartTime] (const RenderLayout::Entry& entry) { return entry.maxEndIncludingTail <= blockStartTime; })
+                                      - entries.begin ());
+    while ((cursor < entries.size ()) && (entries[cursor].maxEndIncludingTail <= blockStartTime))
+        ++cursor;
+    layout->cursor = cursor;
+
+    size_t count { 0 };
+    for (auto i { cursor }; (i < entries.size ()) && (entries[i].getStartIncludingHead () < blockEndTime); ++i)
+    {
+        const auto& entry { entries[i] };
+        if (entry.getEndIncludingTail () <= blockStartTime)
+            continue;
+
+        const auto regionStart { samplePositionAtTime (entry.startInPlaybackTime, playbackSampleRate) };
+        const auto regionEnd { samplePositionAtTime (entry.endInPlaybackTime, playbackSampleRate) };
+        const auto headSampleCount { regionStart - samplePositionAtTime (entry.getStartIncludingHead (), playbackSampleRate) };
+        const auto tailSampleCount { samplePositionAtTime (entry.getEndIncludingTail (), playbackSampleRate) - regionEnd };
+        const auto segmentStart { std::max (blockStartInPlaybackSamples, regionStart - headSampleCount) };
+        const auto segmentEnd { std::min (blockEndInPlaybackSamples, regionEnd + tailSampleCount) };
+        if (segmentEnd <= segmentStart)
+            continue;
+
+        const PlaybackRegionTimeMapping mapping { entry.startInPlaybackTime, entry.startInAudioModificationTime, 1.0 / entry.timeStretchFactor };
+        const auto startInAudioModificationTime { mapping.map (timeAtSamplePosition (segmentStart, playbackSampleRate)) };
+
+        auto& segment { layout->segments[count++] };
+        segment.playbackRegion = entry.playbackRegion;
+        segment.blockOffset = segmentStart - blockStartInPlaybackSamples;
+        segment.sampleCount = segmentEnd - segmentStart;
+        segment.startInAudioModificationSamples = samplePositionAtTime (startInAudioModificationTime, entry.audioModificationSampleRate);
+        segment.timeStretchFactor = entry.timeStretchFactor;
+        segment.regionStartInPlaybackSamples = regionStart;
+        segment.regionEndInPlaybackSamples = regionEnd;
+        segment.headSampleCount = headSampleCount;
+        segment.tailSampleCount = tailSampleCount;
+        segment.playbackRegionRenderGeneration = entry.playbackRegionRenderGeneration;
+        segment.audioModificationRenderGeneration = entry.audioModificationRenderGeneration;
+    }
+
+    return { layout->segments.data (), count };
 }
 
 
@@ -30,12 +30,14 @@
     #include "ARA_Library/Debug/ARAContentValidator.h"
 #endif
 
+#include <deque>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <cstring>
 #include <atomic>
-#include <stdlib.h>     // workaround, see OptionalProperty::operator=
+#include <mutex>
 
 
 namespace ARA
@@ -77,6 +79,7 @@ class AudioSource;
 class AudioModification;
 class PlaybackRegion;
 class ContentReader;
+class RegionSequenceContent;
 class RestoreObjectsFilter;
 class StoreObjectsFilter;
 class DocumentController;
@@ -96,10 +99,44 @@ class PlugInEntry;
 //! @addtogroup ARA_Library_ARAPlug_Utility_Classes
 //! @{
 
+/*******************************************************************************/
+//! Pool for sharing the data of OptionalProperty instances.
+//! Property data is stored in immutable, reference counted blocks. Per pool, there is only a
+//! single block for any given value, so assigning a value that is already in use elsewhere (such
+//! as the same name or color used by many regions) only costs a hash lookup plus incrementing the
+//! reference count, and properties that share a pool are equal exactly if they share their block.
+//! Each Document maintains a pool for the properties of its objects. Blocks may outlive their pool,
+//! e.g. if the plug-in keeps copies of properties after the document has been destroyed.
+class OptionalPropertyPool
+{
+public:
+    OptionalPropertyPool () noexcept;
+    ~OptionalPropertyPool () noexcept;
+
+    //! Implementation helpers for OptionalProperty - do not use directly.
+    //! Data is passed as pointer to the payload of its block, the pool may be nullptr in which case
+    //! the data is not shared.
+    //@{
+    static const void* createData (OptionalPropertyPool* pool, const void* value, size_t size) noexcept;
+    static void retainData (const void* data) noexcept;
+    static void releaseData (const void* data) noexcept;
+    static size_t getDataSize (const void* data) noexcept;
+    static bool isDataShared (const void* data, const void* otherData) noexcept;
+    //@}
+
+private:
+    struct Core;
+    struct Block;
+    Core* const _core;
+
+    ARA_DISABLE_COPY_AND_MOVE (OptionalPropertyPool)
+};
+
 /*******************************************************************************/
 //! Template container class managing optional property data sent from the host.
 //! If the host passes nullptr for the property, this is stored, otherwise the property data is
-//! copied to newly allocated memory.
+//! copied to an immutable, reference counted block of memory, see OptionalPropertyPool.
+//! Copying properties thus only increments the reference count.
 template <typename T>
 class OptionalProperty;
 
@@ -115,7 +152,7 @@ public:
     : OptionalProperty () { *this = value; }
 
     inline OptionalProperty (const OptionalProperty& other) noexcept
-    : OptionalProperty () { *this = other._data; }
+    : OptionalProperty () { *this = other; }
 
     inline OptionalProperty (OptionalProperty&& other) noexcept
     : OptionalProperty () { *this = std::move (other); }
@@ -126,30 +163,34 @@ public:
 
     inline const T* operator-> () const noexcept { return this->_data; }
 
-    inline OptionalProperty& operator= (const T* value) noexcept
+    //! Copy the given value, sharing the copy through the pool if provided.
+    inline void assign (const T* value, OptionalPropertyPool* pool) noexcept
     {
         if (this->_data != value)
         {
-            // Xcode 8 has namespace issues with std::malloc()/std::free(), so we use the C version for now
-            /*std::*/free (const_cast<void *> (static_cast<const void *> (this->_data)));
-            this->_data = nullptr;
-
-            if (value)
-            {
-                const auto dataSize { getAllocSize (value) };
-                auto data { /*std::*/malloc (dataSize) };
-                ARA_INTERNAL_ASSERT (data);
-                std::memcpy (data, value, dataSize);
-                this->_data = static_cast<const T*> (data);
-            }
+            const auto oldData { this->_data };
+            this->_data = (value) ? static_cast<const T*> (OptionalPropertyPool::createData (pool, value, getValueSize (value))) : nullptr;
+            if (oldData)
+                OptionalPropertyPool::releaseData (oldData);
         }
+    }
 
+    inline OptionalProperty& operator= (const T* value) noexcept
+    {
+        assign (value, nullptr);
         return *this;
     }
 
     inline OptionalProperty& operator= (const OptionalProperty& other) noexcept
     {
-        *this = other._data;
+        if (this->_data != other._data)
+        {
+            if (other._data)
+                OptionalPropertyPool::retainData (other._data);
+            if (this->_data)
+                OptionalPropertyPool::releaseData (this->_data);
+            this->_data = other._data;
+        }
         return *this;
     }
 
@@ -167,8 +208,8 @@ public:
         if ((this->_data == nullptr) || (value == nullptr))
             return false;
 
-        const auto dataSize { getAllocSize (this->_data) };
-        if (dataSize != getAllocSize (value))
+        const auto dataSize { OptionalPropertyPool::getDataSize (this->_data) };
+        if (dataSize != getValueSize (value))
             return false;
 
         return (0 == std::memcmp (this->_data, value, dataSize));
@@ -176,21 +217,39 @@ public:
 
     inline bool operator!= (const T* value) const noexcept { return !(*this == value); }
 
-    inline bool operator== (const OptionalProperty& other) const noexcept { return (*this == other._data); }
+    inline bool operator== (const OptionalProperty& other) const noexcept
+    {
+        if (this->_data == other._data)
+            return true;
+
+        if ((this->_data == nullptr) || (other._data == nullptr) || OptionalPropertyPool::isDataShared (this->_data, other._data))
+            return false;
+
+        return (*this == other._data);
+    }
 
-    inline bool operator!= (const OptionalProperty& other) const noexcept { return !(*this == other._data); }
+    inline bool operator!= (const OptionalProperty& other) const noexcept { return !(*this == other); }
 
 private:
     template<typename Q = T*, typename std::enable_if<!std::is_same<Q, ARAUtf8String>::value, bool>::type = true>
-    static constexpr inline size_t getAllocSize (const T* /*value*/) noexcept { return sizeof (T); }
+    static constexpr inline size_t getValueSize (const T* /*value*/) noexcept { return sizeof (T); }
     template<typename Q = T*, typename std::enable_if<std::is_same<Q, ARAUtf8String>::value, bool>::type = true>
-    static inline size_t getAllocSize (const ARAUtf8String value) noexcept { return std::strlen (value) + 1; }
+    static inline size_t getValueSize (const ARAUtf8String value) noexcept { return std::strlen (value) + 1; }
 
 private:
     const T* _data { nullptr };
 };
 
 
+/*******************************************************************************/
+//! Bit set of the properties of a model object that actually change in an update*Properties() call,
+//! passed to the matching will/didUpdate*Properties() hooks of DocumentControllerDelegate.
+//! The individual flags are defined by each model object class, e.g. PlaybackRegion::kColorChanged.
+//! When the object is being created, all flags are set.
+using PropertyChanges = uint32_t;
+constexpr PropertyChanges kAllPropertiesChanged { ~PropertyChanges { 0 } };
+
+
 /*******************************************************************************/
 // Implementation helper for concurrent audio source analysis progress tracking - do not use directly.
 class AnalysisProgressTracker
@@ -216,6 +275,55 @@ private:
     // 6..7 -> started progress must be sent to host, and completion event for previous progress is pending too
 };
 
+/*******************************************************************************/
+//! Monotonic generation counters for the content of a model object, one per content update scope.
+//! The DocumentController assigns a new generation to all affected scopes whenever the content of
+//! the object may change, be it via the host updating content or properties, or via the plug-in
+//! calling the DocumentController::notify*ContentChanged () functions. Changes propagate like the
+//! content dependencies: audio source changes also update the generations of its audio
+//! modifications, which in turn update their playback regions, which in turn update their region
+//! sequence. Musical context content updates also update the region sequences of the context and
+//! their playback regions - if the timeline is affected, this includes the samples of all regions
+//! that reflect the tempo (see PlaybackRegion::isTimeStretchReflectingTempo ()).
+//! Caches derived from the content (analysis results, peaks, rendered audio etc.) can thus store
+//! the generations they were built from, and validate themselves with a single comparison instead
+//! of tracking the transient update notifications.
+//! Generations are drawn from a single counter, so they are unique across all objects and can be
+//! used as keys even if the memory of a destroyed object is reused for a new one.
+//! Reading the generations is lock-free and thread safe.
+class ContentGenerations
+{
+public:
+    //! Content update scopes, see ContentUpdateScopes.
+    enum Scope : size_t
+    {
+        kSamplesScope = 0,
+        kNotesScope,
+        kTimelineScope,
+        kTuningScope,
+        kHarmoniesScope,
+        kScopesCount
+    };
+
+    ContentGenerations () noexcept;
+
+    //! Generation of the given scope.
+    uint64_t get (Scope scope) const noexcept { return _scopeGenerations[scope].load (std::memory_order_acquire); }
+
+    //! Generation that changes whenever any of the scopes changes.
+    uint64_t get () const noexcept { return _generation.load (std::memory_order_acquire); }
+
+private:
+    friend class DocumentController;
+    void update (ContentUpdateScopes scopeFlags) noexcept;
+
+private:
+    std::atomic<uint64_t> _scopeGenerations[kScopesCount];
+    std::atomic<uint64_t> _generation;
+
+    ARA_DISABLE_COPY_AND_MOVE (ContentGenerations)
+};
+
 //! @} ARA_Library_ARAPlug_Utility_Classes
 
 
@@ -244,6 +352,18 @@ public:
     const OptionalProperty<ARAUtf8String>& getName () const noexcept { return _name; } //!< See ARADocumentProperties::name.
 //@}
 
+//! @name Property Changes
+//! Flags for the PropertyChanges passed to DocumentControllerDelegate::willUpdateDocumentPropertiesWithChanges () and didUpdateDocumentPropertiesWithChanges ().
+//@{
+    enum : PropertyChanges
+    {
+        kNameChanged = 1 << 0
+    };
+
+    //! Determine which properties differ between this object and \p newProperties.
+    PropertyChanges getPropertyChanges (PropertiesPtr<ARADocumentProperties> newProperties) const noexcept;
+//@}
+
 //! @name Document Relationships
 //! Where applicable, use the optional template parameter to cast the returned instances to your custom subclass.
 //@{
@@ -266,6 +386,7 @@ public:
 
 private:
     DocumentController* const _documentController;
+    OptionalPropertyPool _propertyPool;
     OptionalProperty<ARAUtf8String> _name;
     std::vector<AudioSource*> _audioSources;
     std::vector<MusicalContext*> _musicalContexts;
@@ -274,6 +395,11 @@ private:
     friend class DocumentController;
     void updateProperties (PropertiesPtr<ARADocumentProperties> properties) noexcept;
 
+    // pool shared by the optional properties of all objects in the document
+    friend class AudioModification;
+    friend class PlaybackRegion;
+    OptionalPropertyPool* getPropertyPool () noexcept { return &_propertyPool; }
+
     friend class AudioSource;
     void addAudioSource (AudioSource* audioSource) noexcept { _audioSources.push_back (audioSource); }
     void removeAudioSource (AudioSource* audioSource) noexcept { find_erase (_audioSources, audioSource); }
@@ -292,6 +418,44 @@ private:
 };
 
 
+/*******************************************************************************/
+//! Immutable snapshot of the content of a MusicalContext as provided by the host,
+//! see MusicalContext::getContent ().
+class MusicalContextContent
+{
+public:
+    //! Events of a given content type.
+    //! Strings referenced by the events (such as chord names) are owned by this object.
+    template <ARAContentType contentType>
+    struct Events
+    {
+        bool isAvailable { false };
+        ARAContentGrade grade { kARAContentGradeInitial };
+        std::vector<typename ContentTypeMapper<contentType>::DataType> events;
+        std::deque<std::string> strings;
+    };
+
+    //! Version of the content, incremented whenever the host updates any content of the musical context.
+    uint64_t getVersion () const noexcept { return _version; }
+
+    const Events<kARAContentTypeTempoEntries>& getTempoEntries () const noexcept { return *_tempoEntries; }
+    const Events<kARAContentTypeBarSignatures>& getBarSignatures () const noexcept { return *_barSignatures; }
+    const Events<kARAContentTypeStaticTuning>& getTuning () const noexcept { return *_tuning; }
+    const Events<kARAContentTypeKeySignatures>& getKeySignatures () const noexcept { return *_keySignatures; }
+    const Events<kARAContentTypeSheetChords>& getSheetChords () const noexcept { return *_sheetChords; }
+
+private:
+    friend class MusicalContext;
+    uint64_t _version { 0 };
+    // content types not affected by an update are shared with the previous version
+    std::shared_ptr<const Events<kARAContentTypeTempoEntries>> _tempoEntries;
+    std::shared_ptr<const Events<kARAContentTypeBarSignatures>> _barSignatures;
+    std::shared_ptr<const Events<kARAContentTypeStaticTuning>> _tuning;
+    std::shared_ptr<const Events<kARAContentTypeKeySignatures>> _keySignatures;
+    std::shared_ptr<const Events<kARAContentTypeSheetChords>> _sheetChords;
+};
+
+
 /*******************************************************************************/
 //! Extensible model object class representing an ARA \ref Model_Musical_Context.
 class MusicalContext
@@ -318,6 +482,20 @@ public:
     const OptionalProperty<ARAUtf8String>& getEffectiveName () const noexcept;
 //@}
 
+//! @name Property Changes
+//! Flags for the PropertyChanges passed to DocumentControllerDelegate::willUpdateMusicalContextPropertiesWithChanges () and didUpdateMusicalContextPropertiesWithChanges ().
+//@{
+    enum : PropertyChanges
+    {
+        kNameChanged = 1 << 0,
+        kOrderIndexChanged = 1 << 1,
+        kColorChanged = 1 << 2
+    };
+
+    //! Determine which properties differ between this object and \p newProperties.
+    PropertyChanges getPropertyChanges (PropertiesPtr<ARAMusicalContextProperties> newProperties) const noexcept;
+//@}
+
 //! @name Musical Context Relationships
 //! Where applicable, use the optional template parameter to cast the returned instances to your custom subclass.
 //@{
@@ -337,6 +515,30 @@ public:
     std::vector<RegionSequence_t*> const& getRegionSequences () const noexcept { return vector_cast<RegionSequence_t*> (this->_regionSequences); }
 //@}
 
+//! @name Content Generations
+//@{
+    //! Generations of the content of this musical context, see ContentGenerations.
+    const ContentGenerations& getContentGenerations () const noexcept { return _contentGenerations; }
+//@}
+
+//! @name Musical Context Content
+//! Optional store of the content provided by the host for this musical context, to be enabled
+//! via enableContentStore (). The content is read from the host once when the host finishes
+//! editing the document after creating the musical context. Subsequent updates only re-read the
+//! content types flagged in DocumentController::updateMusicalContextContent (), and if the host
+//! specifies a time range only the events within that range, keeping all other content.
+//! Each update yields a new immutable snapshot which can be accessed from any thread, so that e.g.
+//! analysis or render threads do not need to read and parse the host content themselves.
+//! Note that obtaining the snapshot may briefly lock, depending on the standard library.
+//@{
+    //! Retrieve the current content snapshot, or nullptr if the store is not enabled.
+    std::shared_ptr<const MusicalContextContent> getContent () const noexcept { return std::atomic_load (&_content); }
+
+protected:
+    //! Call from the constructor of subclasses that use getContent ().
+    void enableContentStore () noexcept;
+//@}
+
 private:
     Document* const _document;
     ARAMusicalContextHostRef const _hostRef;
@@ -345,10 +547,21 @@ private:
     OptionalProperty<ARAColor*> _color;
     std::vector<RegionSequence*> _regionSequences;
 
+    // content updates are accumulated while the host is editing and applied in endEditing ()
+    bool _isContentStoreEnabled { false };
+    bool _hasPendingContentUpdate { false };
+    ContentUpdateScopes _pendingContentUpdateScopes;
+    bool _pendingContentUpdateHasRange { false };
+    ARAContentTimeRange _pendingContentUpdateRange { 0.0, 0.0 };
+    std::shared_ptr<const MusicalContextContent> _content;
+    ContentGenerations _contentGenerations;
+
 private:
     friend class DocumentController;
     void updateProperties (PropertiesPtr<ARAMusicalContextProperties> properties) noexcept;
     void sortRegionSequencesByOrderIndex () noexcept;
+    void addPendingContentUpdate (const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept;
+    void applyPendingContentUpdate () noexcept;
 
     friend class RegionSequence;
     void addRegionSequence (RegionSequence* sequence) noexcept { _regionSequences.push_back (sequence); }
@@ -381,6 +594,21 @@ public:
     const OptionalProperty<ARAColor*>& getColor () const noexcept { return _color; }   //!< See ARARegionSequenceProperties::color.
 //@}
 
+//! @name Property Changes
+//! Flags for the PropertyChanges passed to DocumentControllerDelegate::willUpdateRegionSequencePropertiesWithChanges () and didUpdateRegionSequencePropertiesWithChanges ().
+//@{
+    enum : PropertyChanges
+    {
+        kNameChanged = 1 << 0,
+        kOrderIndexChanged = 1 << 1,
+        kColorChanged = 1 << 2,
+        kMusicalContextChanged = 1 << 3
+    };
+
+    //! Determine which properties differ between this object and \p newProperties.
+    PropertyChanges getPropertyChanges (PropertiesPtr<ARARegionSequenceProperties> newProperties) const noexcept;
+//@}
+
 //! @name Region Sequence Relationships
 //! Where applicable, use the optional template parameter to cast the returned instances to your custom subclass.
 //@{
@@ -404,6 +632,13 @@ public:
     std::vector<PlaybackRegion_t*> const& getPlaybackRegions () const noexcept { return vector_cast<PlaybackRegion_t*> (this->_playbackRegions); }
 //@}
 
+//! @name Content Generations
+//@{
+    //! Generations of the content of this region sequence, i.e. of the content merged from its
+    //! playback regions, see ContentGenerations.
+    const ContentGenerations& getContentGenerations () const noexcept { return _contentGenerations; }
+//@}
+
 private:
     void setMusicalContext (MusicalContext* musicalContext) noexcept;
 
@@ -414,6 +649,15 @@ private:
     void addPlaybackRegion (PlaybackRegion* region) noexcept { _playbackRegions.push_back (region); }
     void removePlaybackRegion (PlaybackRegion* region) noexcept { find_erase (_playbackRegions, region); }
 
+    // cache maintained by DocumentController::getRegionSequenceContent ()
+    struct ContentCacheEntry
+    {
+        ARAContentType type;
+        bool hasRange;
+        ARAContentTimeRange range;
+        std::shared_ptr<const RegionSequenceContent> content;
+    };
+
 private:
     Document* const _document;
     ARARegionSequenceHostRef const _hostRef;
@@ -422,6 +666,8 @@ private:
     ARAInt32 _orderIndex { 0 };
     OptionalProperty<ARAColor*> _color;
     std::vector<PlaybackRegion*> _playbackRegions;
+    std::vector<ContentCacheEntry> _contentCache;
+    ContentGenerations _contentGenerations;
 
     ARA_HOST_MANAGED_OBJECT (RegionSequence)
 };
@@ -455,6 +701,24 @@ public:
     bool merits64BitSamples () const noexcept { return _merits64BitSamples; }                  //!< See ARAAudioSourceProperties::merits64BitSamples.
 //@}
 
+//! @name Property Changes
+//! Flags for the PropertyChanges passed to DocumentControllerDelegate::willUpdateAudioSourcePropertiesWithChanges () and didUpdateAudioSourcePropertiesWithChanges ().
+//@{
+    enum : PropertyChanges
+    {
+        kNameChanged = 1 << 0,
+        kPersistentIDChanged = 1 << 1,
+        kSampleCountChanged = 1 << 2,
+        kSampleRateChanged = 1 << 3,
+        kChannelCountChanged = 1 << 4,
+        kMerits64BitSamplesChanged = 1 << 5,
+        kChannelArrangementChanged = 1 << 6
+    };
+
+    //! Determine which properties differ between this object and \p newProperties.
+    PropertyChanges getPropertyChanges (PropertiesPtr<ARAAudioSourceProperties> newProperties) const noexcept;
+//@}
+
 //! @name Host-controlled Audio Source State
 //@{
     bool isSampleAccessEnabled () const noexcept { return _sampleAccessEnabled; }              //!< See DocumentController::enableAudioSourceSamplesAccess.
@@ -488,10 +752,41 @@ public:
     std::vector<AudioModification_t*> const& getAudioModifications () const noexcept { return vector_cast<AudioModification_t*> (this->_modifications); }
 //@}
 
+//! @name Content Generations
+//@{
+    //! Generations of the content of this audio source, see ContentGenerations.
+    const ContentGenerations& getContentGenerations () const noexcept { return _contentGenerations; }
+//@}
+
+//! @name Audio Reader Pool
+//! Each audio source maintains a pool of HostAudioReader instances, separately for 32 and 64 bit
+//! samples, which is used by PooledHostAudioReader. Since creating readers can be expensive for
+//! the host (e.g. when opening files or decoders, or when communicating via IPC), analysis code
+//! that reads the samples in many jobs or chunks should use PooledHostAudioReader instead of
+//! creating a HostAudioReader each time - after warming up, readers are then only created if more
+//! of them are used concurrently than before.
+//! The pool is emptied when the host disables sample access (after willEnableAudioSourceSamplesAccess ()
+//! has returned) and when destroying the audio source (after willDestroyAudioSource () has returned).
+//! Readers that are checked out when sample access is disabled are destroyed instead of being
+//! returned to the pool. Since each PooledHostAudioReader returns its reader to the audio source,
+//! all of them must have been released before willDestroyAudioSource () returns.
+//! Pool access is thread safe.
+//@{
+    //! Destroy all readers currently in the pool, and prevent readers that are currently
+    //! checked out from being returned to it.
+    void purgeAudioReaderPool () noexcept;
+//@}
+
+private:
+    friend class PooledHostAudioReader;
+    std::unique_ptr<HostAudioReader> checkOutAudioReader (bool use64BitSamples, uint64_t& poolGeneration) noexcept;
+    void checkInAudioReader (std::unique_ptr<HostAudioReader> audioReader, bool use64BitSamples, uint64_t poolGeneration) noexcept;
+
 private:
     friend class DocumentController;
     void updateProperties (PropertiesPtr<ARAAudioSourceProperties> properties) noexcept;
     void setSampleAccessEnabled (bool enable) noexcept { _sampleAccessEnabled = enable; }
+    void purgeAudioReaderPool (bool willBeDestroyed) noexcept;
     void setDeactivatedForUndoHistory (bool deactivate) noexcept { _deactivatedForUndoHistory = deactivate; }
     AnalysisProgressTracker& getAnalysisProgressTracker () noexcept { return _analysisProgressTracker; }
 
@@ -508,11 +803,20 @@ private:
     ARASampleRate _sampleRate { 44.100 };
     ARAChannelCount _channelCount { 1 };
     bool _merits64BitSamples { false };
+    ARAChannelArrangementDataType _channelArrangementDataType { kARAChannelArrangementUndefined };
+    std::vector<ARAByte> _channelArrangementData;
     bool _sampleAccessEnabled { false };
     bool _deactivatedForUndoHistory { false };
     std::vector<AudioModification*> _modifications;
     AnalysisProgressTracker _analysisProgressTracker;
 
+    std::mutex _audioReaderPoolMutex;
+    std::vector<std::unique_ptr<HostAudioReader>> _audioReaderPool[2];    // indexed by use64BitSamples
+    uint64_t _audioReaderPoolGeneration { 0 };                          // incremented when purging
+    size_t _checkedOutAudioReadersCount { 0 };
+
+    ContentGenerations _contentGenerations;
+
     ARA_HOST_MANAGED_OBJECT (AudioSource)
 };
 ARA_MAP_REF (AudioSource, ARAAudioSourceRef)
@@ -546,6 +850,19 @@ public:
     const OptionalProperty<ARAUtf8String>& getEffectiveName () const noexcept;
 //@}
 
+//! @name Property Changes
+//! Flags for the PropertyChanges passed to DocumentControllerDelegate::willUpdateAudioModificationPropertiesWithChanges () and didUpdateAudioModificationPropertiesWithChanges ().
+//@{
+    enum : PropertyChanges
+    {
+        kNameChanged = 1 << 0,
+        kPersistentIDChanged = 1 << 1
+    };
+
+    //! Determine which properties differ between this object and \p newProperties.
+    PropertyChanges getPropertyChanges (PropertiesPtr<ARAAudioModificationProperties> newProperties) const noexcept;
+//@}
+
 //! @name Host-controlled Audio Modification State
 //@{
     bool isDeactivatedForUndoHistory () const noexcept { return _deactivatedForUndoHistory; }  //!< See DocumentController::deactivateAudioModificationForUndoHistory.
@@ -570,6 +887,19 @@ public:
     std::vector<PlaybackRegion_t*> const& getPlaybackRegions () const noexcept { return vector_cast<PlaybackRegion_t*> (this->_playbackRegions); }
 //@}
 
+//! @name Content Generations
+//@{
+    //! Generations of the content of this audio modification, see ContentGenerations.
+    const ContentGenerations& getContentGenerations () const noexcept { return _contentGenerations; }
+
+    //! Identifies the current state of the audio rendered for this modification, e.g. for caching
+    //! rendered audio (see RenderCache). This is the generation of the samples scope, which changes
+    //! whenever the samples of the underlying audio source change, and whenever the plug-in calls
+    //! DocumentController::notifyAudioModificationContentChanged () with a scope that affects samples -
+    //! plug-ins must do so upon any edit that changes the rendered audio.
+    uint64_t getRenderGeneration () const noexcept { return _contentGenerations.get (ContentGenerations::kSamplesScope); }
+//@}
+
 private:
     friend class DocumentController;
     void updateProperties (PropertiesPtr<ARAAudioModificationProperties> properties) noexcept;
@@ -586,6 +916,7 @@ private:
     std::string _persistentID;
     bool _deactivatedForUndoHistory { false };
     std::vector<PlaybackRegion*> _playbackRegions;
+    ContentGenerations _contentGenerations;
 
     ARA_HOST_MANAGED_OBJECT (AudioModification)
 };
@@ -648,6 +979,56 @@ public:
     const OptionalProperty<ARAColor*>& getEffectiveColor () const noexcept;
 //@}
 
+//! @name Mapping Between Audio Modification Time And Playback Time
+//! Positions are mapped linearly relative to the region start, applying getTimeStretchFactor ().
+//! Positions outside the region are extrapolated. Sample positions are derived from the time
+//! positions using samplePositionAtTime (), using the underlying AudioSource sample rate for the
+//! modification and the given sample rate for playback, so the results match the scalar accessors
+//! such as getStartInPlaybackSamples ().
+//! The batch variants yield the same results as the single position variants and are designed
+//! to be vectorized by the compiler - input and output may be the same array.
+//! Note that the linear mapping is only correct for regions that are not stretched, or stretched
+//! uniformly. If isTimeStretchReflectingTempo (), the plug-in stretches according to the tempo of
+//! the audio source versus the musical context, so the actual mapping is non-linear and depends on
+//! the plug-in's analysis and the tempo map - these functions then only are exact at the region
+//! borders, and plug-ins must implement the mapping for positions inside the region themselves.
+//@{
+    //! Ratio between playback and modification duration if isTimestretchEnabled (), otherwise 1.0.
+    //! If isTimeStretchReflectingTempo (), this is only the average ratio across the region.
+    double getTimeStretchFactor () const noexcept;
+
+    ARATimePosition mapAudioModificationTimeToPlaybackTime (ARATimePosition modificationTime) const noexcept;
+    ARATimePosition mapPlaybackTimeToAudioModificationTime (ARATimePosition playbackTime) const noexcept;
+
+    void mapAudioModificationTimesToPlaybackTimes (const ARATimePosition* modificationTimes, ARATimePosition* playbackTimes, size_t count) const noexcept;
+    void mapPlaybackTimesToAudioModificationTimes (const ARATimePosition* playbackTimes, ARATimePosition* modificationTimes, size_t count) const noexcept;
+
+    void mapAudioModificationSamplesToPlaybackSamples (const ARASamplePosition* modificationSamples, ARASamplePosition* playbackSamples, size_t count, ARASampleRate playbackSampleRate) const noexcept;
+    void mapPlaybackSamplesToAudioModificationSamples (const ARASamplePosition* playbackSamples, ARASamplePosition* modificationSamples, size_t count, ARASampleRate playbackSampleRate) const noexcept;
+//@}
+
+//! @name Property Changes
+//! Flags for the PropertyChanges passed to DocumentControllerDelegate::willUpdatePlaybackRegionPropertiesWithChanges () and didUpdatePlaybackRegionPropertiesWithChanges ().
+//@{
+    enum : PropertyChanges
+    {
+        kStartInAudioModificationTimeChanged = 1 << 0,
+        kDurationInAudioModificationTimeChanged = 1 << 1,
+        kStartInPlaybackTimeChanged = 1 << 2,
+        kDurationInPlaybackTimeChanged = 1 << 3,
+        kTransformationFlagsChanged = 1 << 4,
+        kNameChanged = 1 << 5,
+        kColorChanged = 1 << 6,
+        kRegionSequenceChanged = 1 << 7,
+#if ARA_SUPPORT_VERSION_1
+        kMusicalContextChanged = 1 << 8,
+#endif
+    };
+
+    //! Determine which properties differ between this object and \p newProperties.
+    PropertyChanges getPropertyChanges (PropertiesPtr<ARAPlaybackRegionProperties> newProperties) const noexcept;
+//@}
+
 //! @name Playback Region Relationships
 //! Where applicable, use the optional template parameter to cast the returned instances to your custom subclass.
 //@{
@@ -671,6 +1052,19 @@ public:
     RegionSequence_t* getRegionSequence () const noexcept { return static_cast<RegionSequence_t*> (this->_regionSequence); }
 //@}
 
+//! @name Content Generations
+//@{
+    //! Generations of the content of this playback region, see ContentGenerations.
+    const ContentGenerations& getContentGenerations () const noexcept { return _contentGenerations; }
+
+    //! Identifies the current state of the audio rendered for this region, see
+    //! AudioModification::getRenderGeneration (). In addition to changes of the audio modification,
+    //! this changes whenever any but the cosmetic properties of the region change, and whenever the
+    //! plug-in calls DocumentController::notifyPlaybackRegionContentChanged () with a scope that
+    //! affects samples.
+    uint64_t getRenderGeneration () const noexcept { return _contentGenerations.get (ContentGenerations::kSamplesScope); }
+//@}
+
 private:
     void setRegionSequence (RegionSequence* regionSequence) noexcept;
 
@@ -694,6 +1088,7 @@ private:
     bool _contentBasedFadeAtTail { false };
     OptionalProperty<ARAUtf8String> _name;
     OptionalProperty<ARAColor*> _color;
+    ContentGenerations _contentGenerations;
 
     ARA_HOST_MANAGED_OBJECT (PlaybackRegion)
 };
@@ -731,6 +1126,45 @@ public:
 ARA_MAP_REF (ContentReader, ARAContentReaderRef)
 
 
+/*******************************************************************************/
+//! Content of a region sequence, merged from the content of all its playback regions.
+//! Provided by DocumentController::getRegionSequenceContent (), see there.
+//! The events are stored as array of the ARA content struct associated with the content type,
+//! sorted by position. Strings referenced by the events (such as chord names) are owned by this object.
+class RegionSequenceContent
+{
+protected:
+    RegionSequenceContent () noexcept = default;
+
+public:
+    virtual ~RegionSequenceContent () noexcept = default;
+
+    //! Get the type of the content.
+    virtual ARAContentType getContentType () const noexcept = 0;
+    //! Get the count of content events.
+    virtual ARAInt32 getEventCount () const noexcept = 0;
+    //! Get a pointer to the content for event \p eventIndex.
+    virtual const void* getDataForEvent (ARAInt32 eventIndex) const noexcept = 0;
+
+    //! Typed access to all events, the content type must match.
+    template <ARAContentType contentType>
+    const typename ContentTypeMapper<contentType>::DataType* getEvents () const noexcept
+    {
+        ARA_INTERNAL_ASSERT (contentType == getContentType ());
+        return (getEventCount () > 0) ? static_cast<const typename ContentTypeMapper<contentType>::DataType*> (getDataForEvent (0)) : nullptr;
+    }
+
+protected:
+    friend class DocumentController;
+    //! Append the events of the given playback region content reader.
+    virtual void appendEvents (ContentReader* contentReader) noexcept = 0;
+    //! Sort all events by position after appending.
+    virtual void sortEvents () noexcept = 0;
+
+    ARA_DISABLE_COPY_AND_MOVE (RegionSequenceContent)
+};
+
+
 /*******************************************************************************/
 //! Utility class that wraps an ARARestoreObjectsFilter instance.
 class RestoreObjectsFilter
@@ -850,8 +1284,14 @@ protected:
     virtual void doDestroyDocument (Document* document) noexcept = 0;
     //! Override to customize pre-update behavior of updateDocumentProperties().
     virtual void willUpdateDocumentProperties (Document* document, PropertiesPtr<ARADocumentProperties> newProperties) noexcept {}
+    //! Override to customize pre-update behavior of updateDocumentProperties() - \p changes indicates which properties will actually change.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void willUpdateDocumentPropertiesWithChanges (Document* document, PropertiesPtr<ARADocumentProperties> newProperties, PropertyChanges changes) noexcept { willUpdateDocumentProperties (document, newProperties); }
     //! Override to customize post-update behavior of updateDocumentProperties().
     virtual void didUpdateDocumentProperties (Document* document) noexcept {}
+    //! Override to customize post-update behavior of updateDocumentProperties() - \p changes indicates which properties actually changed.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void didUpdateDocumentPropertiesWithChanges (Document* document, PropertyChanges changes) noexcept { didUpdateDocumentProperties (document); }
     //! Override to customize behavior after createMusicalContext() adds \p musicalContext to \p document.
     virtual void didAddMusicalContextToDocument (Document* document, MusicalContext* musicalContext) noexcept {}
     //! Override to customize behavior before destroyMusicalContext() removes \p musicalContext from \p document.
@@ -884,8 +1324,14 @@ protected:
     virtual void doDestroyMusicalContext (MusicalContext* musicalContext) noexcept = 0;
     //! Override to customize pre-update behavior of updateMusicalContextProperties().
     virtual void willUpdateMusicalContextProperties (MusicalContext* musicalContext, PropertiesPtr<ARAMusicalContextProperties> newProperties) noexcept {}
+    //! Override to customize pre-update behavior of updateMusicalContextProperties() - \p changes indicates which properties will actually change.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void willUpdateMusicalContextPropertiesWithChanges (MusicalContext* musicalContext, PropertiesPtr<ARAMusicalContextProperties> newProperties, PropertyChanges changes) noexcept { willUpdateMusicalContextProperties (musicalContext, newProperties); }
     //! Override to customize post-update behavior of updateMusicalContextProperties().
     virtual void didUpdateMusicalContextProperties (MusicalContext* musicalContext) noexcept {}
+    //! Override to customize post-update behavior of updateMusicalContextProperties() - \p changes indicates which properties actually changed.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void didUpdateMusicalContextPropertiesWithChanges (MusicalContext* musicalContext, PropertyChanges changes) noexcept { didUpdateMusicalContextProperties (musicalContext); }
     //! Override to implement updateMusicalContextContent().
     virtual void doUpdateMusicalContextContent (MusicalContext* musicalContext, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept = 0;
     //! Override to customize behavior after createRegionSequence() or updateRegionSequenceProperties() adds \p regionSequence to \p musicalContext.
@@ -908,8 +1354,14 @@ protected:
     virtual void doDestroyRegionSequence (RegionSequence* regionSequence) noexcept = 0;
     //! Override to customize pre-update behavior of updateRegionSequenceProperties().
     virtual void willUpdateRegionSequenceProperties (RegionSequence* regionSequence, PropertiesPtr<ARARegionSequenceProperties> newProperties) noexcept {}
-    //! Override to customize pre-update behavior of updateRegionSequenceProperties().
+    //! Override to customize pre-update behavior of updateRegionSequenceProperties() - \p changes indicates which properties will actually change.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void willUpdateRegionSequencePropertiesWithChanges (RegionSequence* regionSequence, PropertiesPtr<ARARegionSequenceProperties> newProperties, PropertyChanges changes) noexcept { willUpdateRegionSequenceProperties (regionSequence, newProperties); }
+    //! Override to customize post-update behavior of updateRegionSequenceProperties().
     virtual void didUpdateRegionSequenceProperties (RegionSequence* regionSequence) noexcept {}
+    //! Override to customize post-update behavior of updateRegionSequenceProperties() - \p changes indicates which properties actually changed.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void didUpdateRegionSequencePropertiesWithChanges (RegionSequence* regionSequence, PropertyChanges changes) noexcept { didUpdateRegionSequenceProperties (regionSequence); }
     //! Override to customize behavior after createPlaybackRegion() or updatePlaybackRegionProperties() adds \p playbackRegion to \p regionSequence.
     virtual void didAddPlaybackRegionToRegionSequence (RegionSequence* regionSequence, PlaybackRegion* playbackRegion) noexcept {}
     //! Override to customize behavior before destroyPlaybackRegion() or updatePlaybackRegionProperties() removes \p playbackRegion from \p regionSequence.
@@ -926,8 +1378,14 @@ protected:
     virtual void doDestroyAudioSource (AudioSource* audioSource) noexcept = 0;
     //! Override to customize pre-update behavior of updateAudioSourceProperties().
     virtual void willUpdateAudioSourceProperties (AudioSource* audioSource, PropertiesPtr<ARAAudioSourceProperties> newProperties) noexcept {}
-    //! Override to customize pre-update behavior of updateAudioSourceProperties().
+    //! Override to customize pre-update behavior of updateAudioSourceProperties() - \p changes indicates which properties will actually change.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void willUpdateAudioSourcePropertiesWithChanges (AudioSource* audioSource, PropertiesPtr<ARAAudioSourceProperties> newProperties, PropertyChanges changes) noexcept { willUpdateAudioSourceProperties (audioSource, newProperties); }
+    //! Override to customize post-update behavior of updateAudioSourceProperties().
     virtual void didUpdateAudioSourceProperties (AudioSource* audioSource) noexcept {}
+    //! Override to customize post-update behavior of updateAudioSourceProperties() - \p changes indicates which properties actually changed.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void didUpdateAudioSourcePropertiesWithChanges (AudioSource* audioSource, PropertyChanges changes) noexcept { didUpdateAudioSourceProperties (audioSource); }
     //! Override to implement updateAudioSourceContent().
     virtual void doUpdateAudioSourceContent (AudioSource* audioSource, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept = 0;
     //! Override to customize behavior before enableAudioSourceSamplesAccess() changes \p audioSource's sample access state.
@@ -956,8 +1414,14 @@ protected:
     virtual void doDestroyAudioModification (AudioModification* audioModification) noexcept = 0;
     //! Override to customize pre-update behavior of updateAudioModificationProperties().
     virtual void willUpdateAudioModificationProperties (AudioModification* audioModification, PropertiesPtr<ARAAudioModificationProperties> newProperties) noexcept {}
+    //! Override to customize pre-update behavior of updateAudioModificationProperties() - \p changes indicates which properties will actually change.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void willUpdateAudioModificationPropertiesWithChanges (AudioModification* audioModification, PropertiesPtr<ARAAudioModificationProperties> newProperties, PropertyChanges changes) noexcept { willUpdateAudioModificationProperties (audioModification, newProperties); }
     //! Override to customize post-update behavior of updateAudioModificationProperties().
     virtual void didUpdateAudioModificationProperties (AudioModification* audioModification) noexcept {}
+    //! Override to customize post-update behavior of updateAudioModificationProperties() - \p changes indicates which properties actually changed.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void didUpdateAudioModificationPropertiesWithChanges (AudioModification* audioModification, PropertyChanges changes) noexcept { didUpdateAudioModificationProperties (audioModification); }
     //! Override to implement isAudioModificationPreservingAudioSourceSignal().
     ARA_DRAFT virtual bool doIsAudioModificationPreservingAudioSourceSignal (AudioModification* audioModification) noexcept { return false; }
     //! Override to customize behavior before deactivateAudioModificationForUndoHistory() changes \p audioModification's activated state.
@@ -980,8 +1444,14 @@ protected:
     virtual void doDestroyPlaybackRegion (PlaybackRegion* playbackRegion) noexcept = 0;
     //! Override to customize pre-update behavior of updatePlaybackRegionProperties().
     virtual void willUpdatePlaybackRegionProperties (PlaybackRegion* playbackRegion, PropertiesPtr<ARAPlaybackRegionProperties> newProperties) noexcept {}
+    //! Override to customize pre-update behavior of updatePlaybackRegionProperties() - \p changes indicates which properties will actually change.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void willUpdatePlaybackRegionPropertiesWithChanges (PlaybackRegion* playbackRegion, PropertiesPtr<ARAPlaybackRegionProperties> newProperties, PropertyChanges changes) noexcept { willUpdatePlaybackRegionProperties (playbackRegion, newProperties); }
     //! Override to customize post-update behavior of updatePlaybackRegionProperties().
     virtual void didUpdatePlaybackRegionProperties (PlaybackRegion* playbackRegion) noexcept {}
+    //! Override to customize post-update behavior of updatePlaybackRegionProperties() - \p changes indicates which properties actually changed.
+    //! The default implementation calls the above variant without \p changes, which remains available for existing code.
+    virtual void didUpdatePlaybackRegionPropertiesWithChanges (PlaybackRegion* playbackRegion, PropertyChanges changes) noexcept { didUpdatePlaybackRegionProperties (playbackRegion); }
     //! Override to define a content based fade for \p playbackRegion by assigning positive values to \p headTime and/or \p tailTime - see getPlaybackRegionHeadAndTailTime().
     virtual void doGetPlaybackRegionHeadAndTailTime (const PlaybackRegion* playbackRegion, ARATimeDuration* headTime, ARATimeDuration* tailTime) noexcept { *headTime = 0.0; *tailTime = 0.0; }
     //! Override to customize behavior before \p playbackRegion is destroyed during destroyPlaybackRegion().
@@ -1119,6 +1589,20 @@ protected:
     EditorView* doCreateEditorView () noexcept override;
     void doDestroyEditorView (EditorView* editorView) noexcept override;
 
+    //! Optionally called from the constructor of the final DocumentController subclass to let the host
+    //! call into that class through a statically bound DocumentControllerDispatcher instead of through
+    //! the virtual functions of DocumentControllerInterface.
+    //! For the calls to be resolved statically, the subclass must be declared final (enforced when
+    //! compiling as C++14 or later, see DocumentControllerDispatcher), and any overrides of the
+    //! DocumentControllerInterface functions must remain public.
+    template <typename DocumentControllerClass>
+    void enableStaticDispatch () noexcept
+    {
+        static_assert (std::is_base_of<DocumentController, DocumentControllerClass>::value, "DocumentControllerClass must derive from DocumentController");
+        ARA_INTERNAL_ASSERT (!_document);
+        _instance.documentControllerInterface = DocumentControllerDispatcher<DocumentControllerClass>::getInterface ();
+    }
+
 #if !ARA_DOXYGEN_BUILD
 public:
     // Inherited public interface used by the C++ dispatcher.
@@ -1283,6 +1767,26 @@ public:
     void notifyPlaybackRegionContentChanged (PlaybackRegion* playbackRegion, ContentUpdateScopes scopeFlags) noexcept;
 //@}
 
+//! @name Region sequence content
+//! Many plug-ins display or export the content of a region sequence by merging the content of all
+//! of its playback regions. To avoid repeating this merge for each request, this is provided here
+//! based on doCreatePlaybackRegionContentReader (), and cached per region sequence, content type
+//! and time range. The cache is invalidated incrementally, only dropping entries that overlap with
+//! the affected regions when their properties change or when their content changes, be it via
+//! the host updating musical context or audio source content or via the notify*ContentChanged ()
+//! calls above. If the content of the regions changes in other ways, the plug-in must call
+//! invalidateRegionSequenceContent ().
+//! Merging is supported for notes, key signatures and sheet chords - for the timeline and tuning,
+//! the content of the musical context of the region sequence applies. These calls must be made
+//! from the document controller thread, returned content remains valid after being invalidated.
+//@{
+    //! Get the merged content of the given type for the given region sequence, or nullptr if the
+    //! type is not supported. Like for content readers, \p range may be nullptr to query all content.
+    std::shared_ptr<const RegionSequenceContent> getRegionSequenceContent (RegionSequence* regionSequence, ARAContentType type, const ARAContentTimeRange* range = nullptr) noexcept;
+    //! Drop the cached content that overlaps with \p range (or all content if nullptr) and is affected by \p scopeFlags.
+    void invalidateRegionSequenceContent (RegionSequence* regionSequence, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept;
+//@}
+
     // Helper for analysis requests.
     bool canContentTypeBeAnalyzed (ARAContentType type) noexcept;
 
@@ -1328,6 +1832,15 @@ private:
 
     std::vector<ARAContentType> const _getValidatedAnalyzableContentTypes (ARASize contentTypesCount, const ARAContentType contentTypes[], bool mayBeEmpty) noexcept;
 
+    // update the content generations of the given object and all objects depending on its content,
+    // and invalidate the cached content of the affected region sequences
+    void _invalidateContent (PlaybackRegion* playbackRegion, ContentUpdateScopes scopeFlags) noexcept;
+    void _invalidateContent (AudioModification* audioModification, ContentUpdateScopes scopeFlags) noexcept;
+    void _invalidateContent (AudioSource* audioSource, ContentUpdateScopes scopeFlags) noexcept;
+    void _invalidateMusicalContextDependentContent (RegionSequence* regionSequence, const ARAContentTimeRange* range, ContentUpdateScopes scopeFlags) noexcept;
+
+    void _updateRenderLayouts () noexcept;
+
     friend class PlaybackRenderer;
     void addPlaybackRenderer (PlaybackRenderer* playbackRenderer) noexcept { _playbackRenderers.push_back (playbackRenderer); }
     void removePlaybackRenderer (PlaybackRenderer* playbackRenderer) noexcept { find_erase (_playbackRenderers, playbackRenderer); if (_playbackRenderers.empty ()) _destroyIfUnreferenced (); }
@@ -1356,6 +1869,7 @@ private:
     std::map<AudioModification*, ContentUpdateScopes> _audioModificationContentUpdates;
     std::map<PlaybackRegion*, ContentUpdateScopes> _playbackRegionContentUpdates;
     std::atomic_flag _analysisProgressIsSynced/* { true } C++ standard only allows for default-init to false */;
+    bool _renderLayoutsNeedUpdate { false };
 
     bool _isHostEditingDocument { false };
 
@@ -1433,6 +1947,33 @@ private:
 };
 
 
+/*******************************************************************************/
+//! Utility class that checks out a HostAudioReader from the pool of an AudioSource upon
+//! construction (creating a new one if the pool is empty) and returns it upon destruction.
+//! Instances must not outlive the willDestroyAudioSource () call for their audio source.
+//! See AudioSource::purgeAudioReaderPool () for details.
+class PooledHostAudioReader
+{
+public:
+    explicit PooledHostAudioReader (AudioSource* audioSource, bool use64BitSamples = false) noexcept;
+    ~PooledHostAudioReader () noexcept;
+
+    PooledHostAudioReader (const PooledHostAudioReader& other) = delete;
+    PooledHostAudioReader& operator= (const PooledHostAudioReader& other) = delete;
+
+    PooledHostAudioReader (PooledHostAudioReader&& other) noexcept;
+    PooledHostAudioReader& operator= (PooledHostAudioReader&& other) noexcept;
+
+    bool readAudioSamples (ARASamplePosition samplePosition, ARASampleCount samplesPerChannel, void* const buffers[]) const noexcept; //!< \copydoc ARAAudioAccessControllerInterface::readAudioSamples
+
+private:
+    AudioSource* _audioSource;
+    std::unique_ptr<HostAudioReader> _audioReader;
+    bool _use64BitSamples;
+    uint64_t _poolGeneration;
+};
+
+
 /*******************************************************************************/
 //! Utility class that wraps the host ARAArchivingControllerInterface archive reading functions.
 class HostArchiveReader
@@ -1550,6 +2091,67 @@ public:
     std::vector<PlaybackRegion_t*> const& getPlaybackRegions () const noexcept { return vector_cast<PlaybackRegion_t*> (this->_playbackRegions); }
 //@}
 
+//! @name Render Scaffold
+//! Optional support for realtime-safe block rendering, to be enabled via enableRenderLayout ().
+//! The renderer then maintains a layout of its playback regions sorted by playback time. The layout
+//! is rebuilt on the model thread whenever regions are added or removed and at the end of each edit
+//! cycle, and handed over to the render thread without locking. Plug-ins must call updateRenderLayout ()
+//! if the head or tail times of the regions change outside of an edit cycle.
+//! For each block, getRenderSegments () yields the parts of all regions (including their head and tail)
+//! that intersect the block, without locking or allocating. Consecutive blocks only advance a cursor
+//! through the layout instead of searching all regions.
+//! getRenderSegments () must not be called concurrently, typically it is only called from the render thread.
+//! If the plug-in changes the render generation of any of the regions outside of an edit cycle, the
+//! layout is rebuilt in the next DocumentController::notifyModelUpdates (), once for all changes made
+//! since the last update. Until then, the segments still provide the previous render generations, so
+//! a RenderCache may still return blocks rendered before the change - plug-ins that need the change to
+//! take effect immediately can call updateRenderLayout () directly.
+//@{
+    //! Part of a playback region that needs to be rendered within a given block.
+    //! Since the host may be editing the model concurrently, all data needed for rendering is provided
+    //! here as of the last layout update - the region itself should only be used for identification
+    //! (or for accessing state that the plug-in synchronizes with rendering).
+    struct RenderSegment
+    {
+        PlaybackRegion* playbackRegion;                     //!< The region to render.
+        ARASamplePosition blockOffset;                      //!< Offset of the segment within the block.
+        ARASampleCount sampleCount;                         //!< Duration of the segment within the block.
+        ARASamplePosition startInAudioModificationSamples;  //!< Position in the audio modification that maps to the start of the segment, see PlaybackRegion::mapPlaybackSamplesToAudioModificationSamples ().
+        double timeStretchFactor;                           //!< See PlaybackRegion::getTimeStretchFactor ().
+        ARASamplePosition regionStartInPlaybackSamples;     //!< Start of the region proper, preceded by its head.
+        ARASamplePosition regionEndInPlaybackSamples;       //!< End of the region proper, followed by its tail.
+        ARASampleCount headSampleCount;                     //!< Duration of the head, see DocumentControllerDelegate::doGetPlaybackRegionHeadAndTailTime ().
+        ARASampleCount tailSampleCount;                     //!< Duration of the tail, see DocumentControllerDelegate::doGetPlaybackRegionHeadAndTailTime ().
+        uint64_t playbackRegionRenderGeneration;            //!< See PlaybackRegion::getRenderGeneration ().
+        uint64_t audioModificationRenderGeneration;         //!< See AudioModification::getRenderGeneration ().
+    };
+
+    //! Segments returned by getRenderSegments (), valid until its next call.
+    class RenderSegments
+    {
+    public:
+        RenderSegments (const RenderSegment* segments, size_t count) noexcept : _segments { segments }, _count { count } {}
+        const RenderSegment* begin () const noexcept { return _segments; }
+        const RenderSegment* end () const noexcept { return _segments + _count; }
+        size_t size () const noexcept { return _count; }
+        bool empty () const noexcept { return _count == 0; }
+    private:
+        const RenderSegment* _segments;
+        size_t _count;
+    };
+
+    //! Determine the segments to render for the given block (realtime safe).
+    //! Returns no segments if the render layout has not been enabled.
+    RenderSegments getRenderSegments (ARASamplePosition blockStartInPlaybackSamples, ARASampleCount blockSampleCount, ARASampleRate playbackSampleRate) noexcept;
+
+    //! Rebuild the render layout from the current state of the regions (not realtime safe).
+    void updateRenderLayout () noexcept;
+
+protected:
+    //! Call from the constructor of subclasses that use getRenderSegments ().
+    void enableRenderLayout () noexcept;
+//@}
+
 protected:
 //! @name PlaybackRenderer Region Assignment Customization
 //! To be overridden by subclasses if needed.
@@ -1574,9 +2176,23 @@ public:
 #endif
 
 private:
+    friend class DocumentController;
+    bool isRenderLayoutEnabled () const noexcept { return _isRenderLayoutEnabled; }
+    void adoptPendingRenderLayout () noexcept;
+
+private:
+    struct RenderLayout;
+
     DocumentController* _documentController;
     std::vector<PlaybackRegion*> _playbackRegions;
 
+    // the pending layout is handed from the model thread to the render thread, which hands the
+    // previously used layout back via the retired slot for deletion on the model thread
+    bool _isRenderLayoutEnabled { false };
+    std::atomic<RenderLayout*> _pendingRenderLayout { nullptr };
+    std::atomic<RenderLayout*> _retiredRenderLayout { nullptr };
+    RenderLayout* _renderLayout { nullptr };    // accessed by the render thread only
+
     ARA_HOST_MANAGED_OBJECT (PlaybackRenderer)
 };
 
@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+//! \file       ARARenderCache.cpp
+//!             memory-bounded cache of rendered playback region audio
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#include "ARARenderCache.h"
+
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ARA {
+namespace PlugIn {
+
+/*******************************************************************************/
+
+RenderCacheKey RenderCacheKey::fromPlaybackRegion (const PlaybackRegion* playbackRegion, ARATimeDuration headTime, ARATimeDuration tailTime, ARASampleRate playbackSampleRate) noexcept
+{
+    // same rounding as in PlaybackRenderer::getRenderSegments ()
+    const auto regionStart { samplePositionAtTime (playbackRegion->getStartInPlaybackTime (), playbackSampleRate) };
+    const auto regionEnd { samplePositionAtTime (playbackRegion->getEndInPlaybackTime (), playbackSampleRate) };
+    const auto headSampleCount { regionStart - samplePositionAtTime (playbackRegion->getStartInPlaybackTime () - headTime, playbackSampleRate) };
+    const auto tailSampleCount { samplePositionAtTime (playbackRegion->getEndInPlaybackTime () + tailTime, playbackSampleRate) - regionEnd };
+    return { playbackRegion, playbackRegion->getRenderGeneration (), playbackRegion->getAudioModification ()->getRenderGeneration (),
+             headSampleCount, tailSampleCount, playbackSampleRate };
+}
+
+/*******************************************************************************/
+
+static constexpr size_t kEmptyBucket { std::numeric_limits<size_t>::max () };
+
+RenderCache::RenderCache (ARAChannelCount channelCount, ARASampleCount blockSampleCount, size_t maxMemorySize) noexcept
+: _channelCount { channelCount },
+  _blockSampleCount { blockSampleCount }
+{
+    ARA_INTERNAL_ASSERT (channelCount > 0);
+    ARA_INTERNAL_ASSERT (blockSampleCount > 0);
+
+    const auto blockSize { static_cast<size_t> (_channelCount) * static_cast<size_t> (_blockSampleCount) };
+    const auto blockCount { std::max<size_t> (maxMemorySize / (blockSize * sizeof (float)), 1) };
+    _samples.resize (blockCount * blockSize);
+    _slots.resize (blockCount, { { { nullptr, 0, 0, 0, 0, 0.0 }, 0 }, false, false });
+
+    // keep the load factor at or below 50% to keep the probe sequences short
+    size_t bucketCount { 1 };
+    while (bucketCount < 2 * blockCount)
+        bucketCount *= 2;
+    _buckets.resize (bucketCount, kEmptyBucket);
+    _bucketsMask = bucketCount - 1;
+}
+
+bool RenderCache::readSamples (const RenderCacheKey& key, ARASamplePosition samplePosition, ARASampleCount sampleCount,
+                               float* const* buffers, ARASampleCount bufferOffset) noexcept
+{
+    if (sampleCount <= 0)
+        return true;
+
+    std::unique_lock<std::mutex> lock { _mutex, std::try_to_lock };
+    if (!lock.owns_lock ())
+        return false;
+
+    // validate that all blocks are present before modifying the buffers
+    const auto firstBlockStart { getBlockStart (samplePosition) };
+    const auto endPosition { samplePosition + sampleCount };
+    for (auto blockStart { firstBlockStart }; blockStart < endPosition; blockStart += _blockSampleCount)
+    {
+        if (_buckets[findBucket ({ key, blockStart })] == kEmptyBucket)
+            return false;
+    }
+
+    for (auto blockStart { firstBlockStart }; blockStart < endPosition; blockStart += _blockSampleCount)
+    {
+        const auto slotIndex { _buckets[findBucket ({ key, blockStart })] };
+        _slots[slotIndex].wasRead = true;
+
+        const auto copyStart { std::max (blockStart, samplePosition) };
+        const auto copyEnd { std::min (blockStart + _blockSampleCount, endPosition) };
+        for (auto c { 0 }; c < _channelCount; ++c)
+            std::memcpy (buffers[c] + bufferOffset + (copyStart - samplePosition),
+                         getSlotChannel (slotIndex, c) + (copyStart - blockStart),
+                         static_cast<size_t> (copyEnd - copyStart) * sizeof (float));
+    }
+    return true;
+}
+
+bool RenderCache::containsBlock (const RenderCacheKey& key, ARASamplePosition blockStart) noexcept
+{
+    ARA_INTERNAL_ASSERT (blockStart == getBlockStart (blockStart));
+
+    std::lock_guard<std::mutex> lock { _mutex };
+    return _buckets[findBucket ({ key, blockStart })] != kEmptyBucket;
+}
+
+void RenderCache::storeBlock (const RenderCacheKey& key, ARASamplePosition blockStart, const float* const* buffers) noexcept
+{
+    ARA_INTERNAL_ASSERT (blockStart == getBlockStart (blockStart));
+
+    std::lock_guard<std::mutex> lock { _mutex };
+
+    const BlockID blockID { key, blockStart };
+    auto slotIndex { _buckets[findBucket (blockID)] };
+    if (slotIndex == kEmptyBucket)
+    {
+        slotIndex = findSlotToEvict ();
+        if (_slots[slotIndex].isUsed)
+            removeSlot (slotIndex);
+        _slots[slotIndex] = { blockID, true, false };
+        _buckets[findBucket (blockID)] = slotIndex;     // must search again since removing may have moved buckets
+    }
+
+    for (auto c { 0 }; c < _channelCount; ++c)
+        std::memcpy (getSlotChannel (slotIndex, c), buffers[c], static_cast<size_t> (_blockSampleCount) * sizeof (float));
+}
+
+void RenderCache::purge (const PlaybackRegion* playbackRegion) noexcept
+{
+    std::lock_guard<std::mutex> lock { _mutex };
+    for (size_t i { 0 }; i < _slots.size (); ++i)
+    {
+        if (_slots[i].isUsed && (_slots[i].blockID.key.playbackRegion == playbackRegion))
+            removeSlot (i);
+    }
+}
+
+void RenderCache::purgeAll () noexcept
+{
+    std::lock_guard<std::mutex> lock { _mutex };
+    std::fill (_buckets.begin (), _buckets.end (), kEmptyBucket);
+    for (auto& slot : _slots)
+        slot.isUsed = false;
+}
+
+size_t RenderCache::getHomeBucket (const BlockID& blockID) const noexcept
+{
+    // head, tail and sample rate are rarely the only difference between keys, so they are not hashed
+    auto hash { static_cast<uint64_t> (reinterpret_cast<uintptr_t> (blockID.key.playbackRegion)) };
+    hash = hash * 31 + blockID.key.playbackRegionRenderGeneration;
+    hash = hash * 31 + blockID.key.audioModificationRenderGeneration;
+    hash = hash * 31 + static_cast<uint64_t> (blockID.blockStart / _blockSampleCount);
+
+    // the bucket is determined by the lower bits, so mix all bits into them (finalizer of MurmurHash3)
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<size_t> (hash) & _bucketsMask;
+}
+
+size_t RenderCache::findBucket (const BlockID& blockID) const noexcept
+{
+    // since the load factor is limited, there always is an empty bucket that terminates the search
+    auto bucket { getHomeBucket (blockID) };
+    while ((_buckets[bucket] != kEmptyBucket) && !(_slots[_buckets[bucket]].blockID == blockID))
+        bucket = (bucket + 1) & _bucketsMask;
+    return bucket;
+}
+
+void RenderCache::eraseBucket (size_t bucket) noexcept
+{
+    // instead of marking the bucket as deleted, move subsequent entries of the probe sequence back
+    // into the gap if their home bucket does not lie between the gap and their current bucket
+    auto gap { bucket };
+    for (auto next { (bucket + 1) & _bucketsMask }; _buckets[next] != kEmptyBucket; next = (next + 1) & _bucketsMask)
+    {
+        const auto home { getHomeBucket (_slots[_buckets[next]].blockID) };
+        if (((next - home) & _bucketsMask) >= ((next - gap) & _bucketsMask))
+        {
+            _buckets[gap] = _buckets[next];
+            gap = next;
+        }
+    }
+    _buckets[gap] = kEmptyBucket;
+}
+
+size_t RenderCache::findSlotToEvict () noexcept
+{
+    // clock algorithm: blocks that have been read since the hand last passed get a second chance,
+    // so after at most one full cycle an unused or not recently read block is found
+    while (true)
+    {
+        auto& slot { _slots[_clockHand] };
+        const auto slotIndex { _clockHand };
+        _clockHand = (_clockHand + 1) % _slots.size ();
+
+        if (!slot.isUsed || !slot.wasRead)
+            return slotIndex;
+        slot.wasRead = false;
+    }
+}
+
+void RenderCache::removeSlot (size_t slotIndex) noexcept
+{
+    auto& slot { _slots[slotIndex] };
+    ARA_INTERNAL_ASSERT (slot.isUsed);
+    const auto bucket { findBucket (slot.blockID) };
+    ARA_INTERNAL_ASSERT (_buckets[bucket] == slotIndex);
+    eraseBucket (bucket);
+    slot.isUsed = false;
+}
+
+}   // namespace PlugIn
+}   // namespace ARA
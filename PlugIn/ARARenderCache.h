@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+//! \file       ARARenderCache.h
+//!             memory-bounded cache of rendered playback region audio
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARARenderCache_h
+#define ARARenderCache_h
+
+#include "ARA_Library/PlugIn/ARAPlug.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace ARA
+{
+namespace PlugIn
+{
+
+//! @addtogroup ARA_Library_ARAPlug_Utility_Classes
+//! @{
+
+/*******************************************************************************/
+//! Identifies the rendered audio of a playback region.
+//! As long as the key is unchanged, the region renders the same samples at the same playback
+//! sample positions, so cached samples remain valid.
+//! The render generations reflect changes of the musical context only for regions that reflect the
+//! tempo, see PlaybackRegion::isTimeStretchReflectingTempo (). Plug-ins whose rendering depends on
+//! the musical context in other ways (e.g. when snapping pitches to the chords) must call
+//! DocumentController::notifyPlaybackRegionContentChanged () with a scope that affects samples for
+//! the affected regions from DocumentControllerDelegate::doUpdateMusicalContextContent ().
+struct RenderCacheKey
+{
+    const PlaybackRegion* playbackRegion;           //!< Only used for identification, see PlaybackRegion::getRenderGeneration ().
+    uint64_t playbackRegionRenderGeneration;        //!< See PlaybackRegion::getRenderGeneration ().
+    uint64_t audioModificationRenderGeneration;     //!< See AudioModification::getRenderGeneration ().
+    ARASampleCount headSampleCount;                 //!< See PlaybackRenderer::RenderSegment::headSampleCount.
+    ARASampleCount tailSampleCount;                 //!< See PlaybackRenderer::RenderSegment::tailSampleCount.
+    ARASampleRate playbackSampleRate;               //!< Sample rate of the renderer.
+
+    //! Key for the region rendered by the given segment (realtime safe).
+    static RenderCacheKey fromRenderSegment (const PlaybackRenderer::RenderSegment& segment, ARASampleRate playbackSampleRate) noexcept
+    {
+        return { segment.playbackRegion, segment.playbackRegionRenderGeneration, segment.audioModificationRenderGeneration,
+                 segment.headSampleCount, segment.tailSampleCount, playbackSampleRate };
+    }
+
+    //! Key for the current state of the given region with the given head and tail time (as returned
+    //! from DocumentControllerDelegate::doGetPlaybackRegionHeadAndTailTime ()), e.g. to prepare
+    //! background rendering. To be called from the model thread only.
+    static RenderCacheKey fromPlaybackRegion (const PlaybackRegion* playbackRegion, ARATimeDuration headTime, ARATimeDuration tailTime, ARASampleRate playbackSampleRate) noexcept;
+
+    bool operator== (const RenderCacheKey& other) const noexcept
+    {
+        return (playbackRegion == other.playbackRegion) &&
+               (playbackRegionRenderGeneration == other.playbackRegionRenderGeneration) &&
+               (audioModificationRenderGeneration == other.audioModificationRenderGeneration) &&
+               (headSampleCount == other.headSampleCount) &&
+               (tailSampleCount == other.tailSampleCount) &&
+               (playbackSampleRate == other.playbackSampleRate);
+    }
+    bool operator!= (const RenderCacheKey& other) const noexcept { return !(*this == other); }
+};
+
+/*******************************************************************************/
+//! Memory-bounded cache of the audio rendered for playback regions, so that plug-ins with
+//! expensive rendering (such as time stretching or pitch editing) need not re-run their DSP for
+//! each playback pass if neither the region nor its audio modification have been changed.
+//! The cache stores blocks of getBlockSampleCount () samples, aligned to multiples of the block size
+//! in playback samples. All storage is allocated upon construction - when full, storing a new
+//! block evicts a block that has not been read recently.
+//! Blocks are typically rendered and stored by a background thread, and read by the render thread
+//! for the segments provided by PlaybackRenderer::getRenderSegments (). Since the keys contain the
+//! render generations of regions and modifications, blocks rendered before an edit are never
+//! returned after it, and eventually get evicted. Plug-ins may additionally purge the blocks of a
+//! region when it is destroyed or removed from the renderer, to make room for other regions.
+//! All functions are thread safe.
+class RenderCache
+{
+public:
+    //! Create a cache for the given channel count and block size, the capacity is determined by the
+    //! given memory budget, with a minimum of a single block.
+    RenderCache (ARAChannelCount channelCount, ARASampleCount blockSampleCount, size_t maxMemorySize) noexcept;
+
+    ARAChannelCount getChannelCount () const noexcept { return _channelCount; }
+    ARASampleCount getBlockSampleCount () const noexcept { return _blockSampleCount; }
+    size_t getBlockCapacity () const noexcept { return _slots.size (); }
+
+    //! Start of the block that contains the given playback sample position.
+    ARASamplePosition getBlockStart (ARASamplePosition samplePosition) const noexcept
+    {
+        const auto offset { samplePosition % _blockSampleCount };
+        return samplePosition - ((offset < 0) ? offset + _blockSampleCount : offset);
+    }
+
+    //! Copy the cached samples of the given range into the non-interleaved buffers, starting at
+    //! \p bufferOffset, if all blocks covering the range are present.
+    //! Returns false if any of the blocks is missing, or if the cache is currently being modified
+    //! by another thread - in that case, the buffers are not modified.
+    //! Realtime safe: does not allocate and does not block.
+    bool readSamples (const RenderCacheKey& key, ARASamplePosition samplePosition, ARASampleCount sampleCount,
+                      float* const* buffers, ARASampleCount bufferOffset = 0) noexcept;
+
+    //! Test whether the block starting at \p blockStart is present, e.g. to determine which blocks
+    //! still need to be rendered in the background.
+    bool containsBlock (const RenderCacheKey& key, ARASamplePosition blockStart) noexcept;
+
+    //! Store the samples of the block starting at \p blockStart, which must be aligned to the block size.
+    //! The buffers must provide getBlockSampleCount () samples for each of the getChannelCount () channels.
+    void storeBlock (const RenderCacheKey& key, ARASamplePosition blockStart, const float* const* buffers) noexcept;
+
+    //! Remove all blocks of the given region, regardless of their render generations.
+    void purge (const PlaybackRegion* playbackRegion) noexcept;
+
+    //! Remove all blocks.
+    void purgeAll () noexcept;
+
+private:
+    struct BlockID
+    {
+        RenderCacheKey key;
+        ARASamplePosition blockStart;
+
+        bool operator== (const BlockID& other) const noexcept { return (key == other.key) && (blockStart == other.blockStart); }
+    };
+
+    struct Slot
+    {
+        BlockID blockID;
+        bool isUsed;
+        bool wasRead;       // second chance flag for the clock eviction
+    };
+
+    float* getSlotChannel (size_t slotIndex, ARAChannelCount channel) noexcept
+    {
+        return _samples.data () + (slotIndex * static_cast<size_t> (_channelCount) + static_cast<size_t> (channel)) * static_cast<size_t> (_blockSampleCount);
+    }
+
+    // the slot index is an open addressing hash table with linear probing, which unlike std containers
+    // allows for allocating all storage upon construction
+    size_t getHomeBucket (const BlockID& blockID) const noexcept;
+    size_t findBucket (const BlockID& blockID) const noexcept;  // bucket containing the block, or the empty bucket to insert it
+    void eraseBucket (size_t bucket) noexcept;
+
+    size_t findSlotToEvict () noexcept;
+    void removeSlot (size_t slotIndex) noexcept;
+
+private:
+    const ARAChannelCount _channelCount;
+    const ARASampleCount _blockSampleCount;
+
+    std::mutex _mutex;
+    std::vector<float> _samples;
+    std::vector<Slot> _slots;
+    std::vector<size_t> _buckets;       // slot indices, or kEmptyBucket
+    size_t _bucketsMask;
+    size_t _clockHand { 0 };
+
+    ARA_DISABLE_COPY_AND_MOVE (RenderCache)
+};
+
+//! @} ARA_Library_ARAPlug_Utility_Classes
+
+}   // namespace PlugIn
+}   // namespace ARA
+
+#endif // ARARenderCache_h
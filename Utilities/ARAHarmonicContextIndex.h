@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+//! \file       ARAHarmonicContextIndex.h
+//!             class to efficiently determine the key signature and chord active
+//!             at given musical positions
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARAHarmonicContextIndex_h
+#define ARAHarmonicContextIndex_h
+
+#include "ARA_API/ARAInterface.h"
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ARA {
+
+//! @addtogroup ARA_Library_Utility_Harmonic_Context_Index
+//! @{
+
+/*******************************************************************************/
+// HarmonicContextIndex
+/** Compact, position-sorted representation of key signature and chord content, to efficiently
+    determine the key signature and chord that is active at a given quarter position.
+    Instead of the full content structs, the index stores the pitch classes used by each key
+    signature or chord as a 12 bit mask (bit 0 representing C, bit 1 C#/Db, etc.), which can be
+    used directly when processing notes.
+    As with the timeline conversion utilities, construction is templated so that it can be used
+    with host or plug-in content readers, or with any other container of the content structs.
+    A key signature or chord is active from its position until the position of the next one.
+    Before the first key signature, the first key signature is considered to be active (like for
+    bar signatures), whereas before the first chord, no chord is active.
+ */
+/*******************************************************************************/
+
+class HarmonicContextIndex
+{
+public:
+    //! Index returned if no key signature or chord is active.
+    static constexpr int32_t kNoIndex { -1 };
+
+    //! Bit mask of pitch classes, bit 0 representing C.
+    using PitchClassMask = uint16_t;
+
+    //! Pitch class (0 being C, 1 being C#/Db, etc.) for the given ::ARACircleOfFifthsIndex.
+    static int32_t getPitchClassForCircleOfFifthsIndex (ARACircleOfFifthsIndex index) noexcept
+    {
+        return ((index * 7) % 12 + 12) % 12;
+    }
+
+    //! Construct from key signature and chord content, both must be sorted by position.
+    template <typename KeySignatureContainer, typename ChordContainer>
+    HarmonicContextIndex (const KeySignatureContainer& keySignatures, const ChordContainer& chords)
+    {
+        for (const ARAContentKeySignature& keySignature : keySignatures)
+        {
+            ARA_INTERNAL_ASSERT (_keySignaturePositions.empty () || (_keySignaturePositions.back () <= keySignature.position));
+            const auto root { getPitchClassForCircleOfFifthsIndex (keySignature.root) };
+            PitchClassMask mask { 0 };
+            for (auto i { 0 }; i < 12; ++i)
+            {
+                if (keySignature.intervals[i] != kARAKeySignatureIntervalUnused)
+                    mask |= static_cast<PitchClassMask> (1 << ((root + i) % 12));
+            }
+            _keySignaturePositions.push_back (keySignature.position);
+            _keySignatureRoots.push_back (static_cast<int8_t> (root));
+            _keySignatureMasks.push_back (mask);
+        }
+
+        for (const ARAContentChord& chord : chords)
+        {
+            ARA_INTERNAL_ASSERT (_chordPositions.empty () || (_chordPositions.back () <= chord.position));
+            const auto root { getPitchClassForCircleOfFifthsIndex (chord.root) };
+            PitchClassMask mask { 0 };
+            for (auto i { 0 }; i < 12; ++i)
+            {
+                if (chord.intervals[i] != kARAChordIntervalUnused)
+                    mask |= static_cast<PitchClassMask> (1 << ((root + i) % 12));
+            }
+            _chordPositions.push_back (chord.position);
+            _chordRoots.push_back (static_cast<int8_t> (root));
+            _chordBasses.push_back (static_cast<int8_t> (getPitchClassForCircleOfFifthsIndex (chord.bass)));
+            _chordMasks.push_back (mask);
+        }
+    }
+
+//! @name Key Signatures
+//! Arrays indexed by the key signature indices returned from the queries.
+//@{
+    size_t getKeySignatureCount () const noexcept { return _keySignaturePositions.size (); }
+    const std::vector<ARAQuarterPosition>& getKeySignaturePositions () const noexcept { return _keySignaturePositions; }
+    const std::vector<int8_t>& getKeySignatureRootPitchClasses () const noexcept { return _keySignatureRoots; }
+    const std::vector<PitchClassMask>& getKeySignaturePitchClassMasks () const noexcept { return _keySignatureMasks; }
+//@}
+
+//! @name Chords
+//! Arrays indexed by the chord indices returned from the queries.
+//! The "no chord" has an empty pitch class mask.
+//@{
+    size_t getChordCount () const noexcept { return _chordPositions.size (); }
+    const std::vector<ARAQuarterPosition>& getChordPositions () const noexcept { return _chordPositions; }
+    const std::vector<int8_t>& getChordRootPitchClasses () const noexcept { return _chordRoots; }
+    const std::vector<int8_t>& getChordBassPitchClasses () const noexcept { return _chordBasses; }
+    const std::vector<PitchClassMask>& getChordPitchClassMasks () const noexcept { return _chordMasks; }
+//@}
+
+//! @name Queries
+//@{
+    //! Index of the key signature active at the given position, or kNoIndex if there are no key signatures.
+    int32_t getKeySignatureIndexAtPosition (ARAQuarterPosition position) const noexcept
+    {
+        if (_keySignaturePositions.empty ())
+            return kNoIndex;
+        return std::max (getLastIndexAtOrBefore (_keySignaturePositions, position), 0);
+    }
+
+    //! Index of the chord active at the given position, or kNoIndex if no chord is active.
+    int32_t getChordIndexAtPosition (ARAQuarterPosition position) const noexcept
+    {
+        return getLastIndexAtOrBefore (_chordPositions, position);
+    }
+
+    //! Determine the indices of the key signatures and chords active at each of the given positions,
+    //! which must be sorted in ascending order (as is the case e.g. for the notes of a content reader).
+    //! Since subsequent positions are typically close to each other, this is done in a single merge
+    //! pass instead of searching for each position individually.
+    //! Either output array may be nullptr if the respective indices are not needed.
+    void getIndicesAtPositions (const ARAQuarterPosition* positions, size_t count, int32_t* keySignatureIndices, int32_t* chordIndices) const noexcept
+    {
+        if (keySignatureIndices)
+        {
+            mergeIndices (_keySignaturePositions, positions, count, keySignatureIndices);
+            if (!_keySignaturePositions.empty ())
+            {
+                for (size_t i { 0 }; (i < count) && (keySignatureIndices[i] == kNoIndex); ++i)
+                    keySignatureIndices[i] = 0;
+            }
+        }
+        if (chordIndices)
+            mergeIndices (_chordPositions, positions, count, chordIndices);
+    }
+//@}
+
+private:
+    static int32_t getLastIndexAtOrBefore (const std::vector<ARAQuarterPosition>& eventPositions, ARAQuarterPosition position) noexcept
+    {
+        const auto it { std::upper_bound (eventPositions.begin (), eventPositions.end (), position) };
+        return static_cast<int32_t> (it - eventPositions.begin ()) - 1;
+    }
+
+    static void mergeIndices (const std::vector<ARAQuarterPosition>& eventPositions, const ARAQuarterPosition* positions, size_t count, int32_t* indices) noexcept
+    {
+        const auto eventCount { static_cast<int32_t> (eventPositions.size ()) };
+        int32_t index { kNoIndex };
+        for (size_t i { 0 }; i < count; ++i)
+        {
+            ARA_INTERNAL_ASSERT ((i == 0) || (positions[i - 1] <= positions[i]));
+            while ((index + 1 < eventCount) && (eventPositions[static_cast<size_t> (index + 1)] <= positions[i]))
+                ++index;
+            indices[i] = index;
+        }
+    }
+
+private:
+    std::vector<ARAQuarterPosition> _keySignaturePositions;
+    std::vector<int8_t> _keySignatureRoots;
+    std::vector<PitchClassMask> _keySignatureMasks;
+
+    std::vector<ARAQuarterPosition> _chordPositions;
+    std::vector<int8_t> _chordRoots;
+    std::vector<int8_t> _chordBasses;
+    std::vector<PitchClassMask> _chordMasks;
+};
+
+//! @} ARA_Library_Utility_Harmonic_Context_Index
+
+}   // namespace ARA
+
+#endif // ARAHarmonicContextIndex_h
@@ -23,6 +23,7 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace ARA {
 
@@ -56,6 +57,29 @@ inline ARATimePosition timeAtSamplePosition (SamplePositionType samplePositon, A
 
 //@}
 
+/*******************************************************************************/
+//! @name Converting Arrays Of Positions
+//! Batch variants of the above conversions, yielding the exact same results for each element.
+//! The loops are kept trivial so that compilers can vectorize them. Input and output may be the
+//! same array where the types match.
+//@{
+
+template<typename SamplePositionType = ARASamplePosition>
+inline void samplePositionsAtTimes (const ARATimePosition* timePositions, SamplePositionType* samplePositions, size_t count, ARASampleRate sampleRate)
+{
+    for (size_t i { 0 }; i < count; ++i)
+        samplePositions[i] = samplePositionAtTime<SamplePositionType> (timePositions[i], sampleRate);
+}
+
+template<typename SamplePositionType = ARASamplePosition>
+inline void timesAtSamplePositions (const SamplePositionType* samplePositions, ARATimePosition* timePositions, size_t count, ARASampleRate sampleRate)
+{
+    for (size_t i { 0 }; i < count; ++i)
+        timePositions[i] = timeAtSamplePosition<SamplePositionType> (samplePositions[i], sampleRate);
+}
+
+//@}
+
 //! @} ARA_Library_Utility_Rounding
 
 }   // namespace ARA
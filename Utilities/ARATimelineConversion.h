@@ -20,12 +20,16 @@
 #ifndef ARATimelineConversion_h
 #define ARATimelineConversion_h
 
+#include "ARA_Library/Debug/ARADebug.h"
 #include "ARA_Library/Dispatch/ARAContentReader.h"
 #include "ARA_Library/Utilities/ARASamplePositionConversion.h"
 
 #include <algorithm>
 #include <iterator>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace ARA {
 
@@ -349,6 +353,174 @@ private:
     mutable double _entryStartBeatCache { 0.0 };
 };
 
+/*******************************************************************************/
+//! Grid specification for GridQuantizer.
+struct QuantizationGrid
+{
+    //! Musical unit that the grid is derived from.
+    enum Unit
+    {
+        kBars = 0,
+        kBeats = 1
+    };
+    Unit unit { kBeats };
+
+    //! Count of grid steps per unit, e.g. 4 to quantize to 16th notes when using kBeats in a 4/4 bar signature.
+    int32_t subdivisions { 1 };
+
+    //! Amount of swing in range [0, 1], delaying every second grid line by up to a third of the grid step.
+    //! 0 results in a straight grid, 1 in a triplet feel.
+    double swing { 0.0 };
+};
+
+/*******************************************************************************/
+// GridQuantizer
+/** Batch quantization of sorted time positions (such as the start positions of the notes of a
+    content reader) to a musical grid.
+    Instead of converting each position individually via TempoConverter and BarSignaturesConverter,
+    the positions are processed in linear merge passes over the tempo map and the bar signatures.
+    Within each tempo or bar signature segment, the conversion is performed in branch-free loops
+    over the positions falling into the segment, which can be vectorized by the compiler (depending
+    on the compiler settings - GCC for example requires -fno-trapping-math for the quantization loop).
+    Grid lines are aligned to the start of each bar signature, so bar signatures are expected to
+    start at bar boundaries. Beat and bar indices are counted from the first bar signature like in
+    BarSignaturesConverter, with negative indices before the first bar signature.
+    templated so it can be used in both hosts and plug-ins with content readers,
+    or with any other data structure that provides a matching interface.
+ */
+/*******************************************************************************/
+
+template <typename TempoContentReader, typename BarSignaturesContentReader>
+class GridQuantizer
+{
+public:
+    //! Construct using host or plug-in ::kARAContentTypeTempoEntries and ::kARAContentTypeBarSignatures readers.
+    GridQuantizer (const TempoContentReader& tempoReader, const BarSignaturesContentReader& barSignaturesReader) noexcept
+    : _tempoReader { tempoReader },
+      _barSignaturesReader { barSignaturesReader }
+    {}
+
+    //! Quantize \p count time positions, which must be sorted in ascending order.
+    //! \p quantizedTimePositions may be identical to \p timePositions to quantize in place.
+    //! If not nullptr, \p beatIndices and \p barIndices receive the indices of the beat and bar
+    //! that contain the respective quantized position.
+    void quantizeTimePositions (const QuantizationGrid& grid, const ARATimePosition* timePositions, size_t count,
+                                ARATimePosition* quantizedTimePositions, int32_t* beatIndices = nullptr, int32_t* barIndices = nullptr) const noexcept
+    {
+        ARA_INTERNAL_ASSERT (grid.subdivisions > 0);
+        ARA_INTERNAL_ASSERT ((0.0 <= grid.swing) && (grid.swing <= 1.0));
+#if ARA_ENABLE_INTERNAL_ASSERTS
+        for (size_t i { 1 }; i < count; ++i)
+            ARA_INTERNAL_ASSERT (timePositions[i - 1] <= timePositions[i]);
+#endif
+
+        // since quantization preserves the order, all passes can operate in place on sorted data
+        this->convertSortedPositions<&ARAContentTempoEntry::timePosition, &ARAContentTempoEntry::quarterPosition> (timePositions, quantizedTimePositions, count);
+        this->quantizeSortedQuarterPositions (grid, quantizedTimePositions, count, beatIndices, barIndices);
+        this->convertSortedPositions<&ARAContentTempoEntry::quarterPosition, &ARAContentTempoEntry::timePosition> (quantizedTimePositions, quantizedTimePositions, count);
+    }
+
+private:
+    // convert between time and quarters using the same interpolation and extrapolation as TempoConverter
+    template <double ARAContentTempoEntry::* from, double ARAContentTempoEntry::* to>
+    void convertSortedPositions (const double* positions, double* results, size_t count) const noexcept
+    {
+        auto left { this->_tempoReader.begin () };
+        auto right { std::next (left) };
+        const auto last { std::prev (this->_tempoReader.end ()) };
+        size_t runStart { 0 };
+        while (runStart < count)
+        {
+            while ((right != last) && ((*right).*from <= positions[runStart]))
+                left = right++;
+
+            auto runEnd { runStart + 1 };
+            if (right == last)
+                runEnd = count;
+            else
+                while ((runEnd < count) && (positions[runEnd] < (*right).*from))
+                    ++runEnd;
+
+            const auto leftFrom { (*left).*from };
+            const auto leftTo { (*left).*to };
+            const auto slope { ((*right).*to - leftTo) / ((*right).*from - leftFrom) };
+            for (auto i { runStart }; i < runEnd; ++i)
+                results[i] = leftTo + (positions[i] - leftFrom) * slope;
+
+            runStart = runEnd;
+        }
+    }
+
+    void quantizeSortedQuarterPositions (const QuantizationGrid& grid, double* quarterPositions, size_t count, int32_t* beatIndices, int32_t* barIndices) const noexcept
+    {
+        // tolerance when deriving indices from quantized positions, which may be off by rounding errors
+        constexpr double kIndexTolerance { 1.0e-9 };
+
+        auto entry { this->_barSignaturesReader.begin () };
+        double entryStartBeat { 0.0 };
+        int32_t entryStartBar { 0 };
+        size_t runStart { 0 };
+        while (runStart < count)
+        {
+            while (true)
+            {
+                const auto next { std::next (entry) };
+                if ((next == this->_barSignaturesReader.end ()) || (next->position > quarterPositions[runStart]))
+                    break;
+
+                // to avoid errors adding up over time, we round to integer values (like BarSignaturesConverter)
+                const auto entryQuarterCount { next->position - entry->position };
+                entryStartBeat = std::round (entryStartBeat + entryQuarterCount * BarSignaturesConverter<BarSignaturesContentReader>::getBeatsPerQuarter (*entry));
+                entryStartBar += static_cast<int32_t> (std::round (entryQuarterCount / BarSignaturesConverter<BarSignaturesContentReader>::getQuartersPerBar (*entry)));
+                entry = next;
+            }
+
+            const auto next { std::next (entry) };
+            const auto entryEnd { (next == this->_barSignaturesReader.end ()) ? std::numeric_limits<double>::max () : next->position };
+            auto runEnd { runStart + 1 };
+            while ((runEnd < count) && (quarterPositions[runEnd] < entryEnd))
+                ++runEnd;
+
+            // grid lines are located at the start of each pair of steps, and in between delayed by the swing offset
+            const auto entryStart { entry->position };
+            const auto beatsPerQuarter { BarSignaturesConverter<BarSignaturesContentReader>::getBeatsPerQuarter (*entry) };
+            const auto beatsPerBar { static_cast<double> (entry->numerator) };
+            const auto stepBeats { ((grid.unit == QuantizationGrid::kBars) ? beatsPerBar : 1.0) / grid.subdivisions };
+            const auto pairBeats { 2.0 * stepBeats };
+            const auto swungStepBeats { stepBeats * (1.0 + grid.swing / 3.0) };
+            const auto firstThreshold { 0.5 * swungStepBeats };
+            const auto secondThreshold { 0.5 * (swungStepBeats + pairBeats) };
+            for (auto i { runStart }; i < runEnd; ++i)
+            {
+                const auto quarterPosition { quarterPositions[i] };
+                const auto beatDistance { (quarterPosition - entryStart) * beatsPerQuarter };
+                const auto pairIndex { std::floor (beatDistance / pairBeats) };
+                const auto offset { beatDistance - pairIndex * pairBeats };
+                const auto isAfterFirstThreshold { (offset >= firstThreshold) ? 1.0 : 0.0 };
+                const auto isAfterSecondThreshold { (offset >= secondThreshold) ? 1.0 : 0.0 };
+                const auto quantizedBeatDistance { (pairIndex + isAfterSecondThreshold) * pairBeats + (isAfterFirstThreshold - isAfterSecondThreshold) * swungStepBeats };
+                const auto gridQuarterPosition { entryStart + quantizedBeatDistance / beatsPerQuarter };
+
+                // if the last grid step of the entry is cut short by the next entry, the start of the next entry may be the closest grid line
+                const auto quantizedQuarterPosition { ((entryEnd - quarterPosition) < std::fabs (gridQuarterPosition - quarterPosition)) ? entryEnd : gridQuarterPosition };
+                quarterPositions[i] = quantizedQuarterPosition;
+
+                const auto quantizedBeats { (quantizedQuarterPosition - entryStart) * beatsPerQuarter };
+                if (beatIndices)
+                    beatIndices[i] = static_cast<int32_t> (std::floor (entryStartBeat + quantizedBeats + kIndexTolerance));
+                if (barIndices)
+                    barIndices[i] = entryStartBar + static_cast<int32_t> (std::floor (quantizedBeats / beatsPerBar + kIndexTolerance));
+            }
+
+            runStart = runEnd;
+        }
+    }
+
+private:
+    const TempoContentReader& _tempoReader;
+    const BarSignaturesContentReader& _barSignaturesReader;
+};
+
 //! @} ARA_Library_Utility_Timeline_Conversion
 
 }   // namespace ARA
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//! \file       ARATuningConversion.cpp
+//!             classes and functions to convert between frequency and pitch
+//!             according to a given ARAContentTuning
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#include "ARATuningConversion.h"
+
+namespace ARA {
+
+/*******************************************************************************/
+
+TuningConverter::TuningConverter () noexcept
+{
+    const float tunings[12] { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    initialize (440.0f, 0, tunings);
+}
+
+TuningConverter::TuningConverter (const ARAContentTuning& tuning) noexcept
+{
+    initialize (tuning.concertPitchFrequency, tuning.root, tuning.tunings);
+}
+
+void TuningConverter::initialize (float concertPitchFrequency, ARACircleOfFifthsIndex root, const float tunings[12]) noexcept
+{
+    ARA_INTERNAL_ASSERT (concertPitchFrequency > 0.0f);
+    _concertPitchFrequency = concertPitchFrequency;
+    _equalTemperedLog2Offset = 69.0f / 12.0f - std::log2 (concertPitchFrequency);
+
+    const auto rootPitchClass { ((root * 7) % 12 + 12) % 12 };
+    for (auto i { 0 }; i < 12; ++i)
+        _pitchClassOffsets[(rootPitchClass + i) % 12] = tunings[i] / 100.0f;
+}
+
+/*******************************************************************************/
+
+// Each batch conversion is split into a pass performing the pitch class table lookups and a pass
+// performing the log2 () or exp2 () arithmetic. Vectorizing table lookups requires gather instructions,
+// which are not available (or not used when tuning for generic targets) on many platforms - splitting
+// the passes allows for vectorizing the expensive arithmetic while doing the cheap lookups sequentially.
+
+void TuningConverter::getFrequenciesForPitches (const float* pitches, float* frequencies, size_t count) const noexcept
+{
+    // the lookup pass also clamps to the range of fastExp2Unchecked (), see fastExp2 ()
+    const auto log2Offset { _equalTemperedLog2Offset };
+    for (size_t i { 0 }; i < count; ++i)
+    {
+        const auto exponent { (pitches[i] + getPitchClassOffsetForPitch (pitches[i])) * (1.0f / 12.0f) - log2Offset };
+        frequencies[i] = (exponent < -125.0f) ? -125.0f : ((exponent > 127.0f) ? 127.0f : exponent);
+    }
+
+    for (size_t i { 0 }; i < count; ++i)
+        frequencies[i] = fastExp2Unchecked (frequencies[i]);
+}
+
+void TuningConverter::getPitchesForFrequencies (const float* frequencies, float* pitches, size_t count) const noexcept
+{
+    const auto log2Offset { _equalTemperedLog2Offset };
+    for (size_t i { 0 }; i < count; ++i)
+        pitches[i] = 12.0f * (fastLog2 (frequencies[i]) + log2Offset);
+
+    for (size_t i { 0 }; i < count; ++i)
+        pitches[i] = getTunedPitch (pitches[i]);
+}
+
+void TuningConverter::getCentsForFrequencies (const float* frequencies, const ARAPitchNumber* pitchNumbers, float* cents, size_t count) const noexcept
+{
+    const auto log2Offset { _equalTemperedLog2Offset };
+    for (size_t i { 0 }; i < count; ++i)
+        cents[i] = 1200.0f * (fastLog2 (frequencies[i]) + log2Offset) - 100.0f * static_cast<float> (pitchNumbers[i]);
+
+    for (size_t i { 0 }; i < count; ++i)
+        cents[i] -= 100.0f * getPitchClassOffset (getPitchClassForPitchNumber (pitchNumbers[i]));
+}
+
+}   // namespace ARA
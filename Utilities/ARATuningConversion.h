@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//! \file       ARATuningConversion.h
+//!             classes and functions to convert between frequency and pitch
+//!             according to a given ARAContentTuning
+//! \project    ARA SDK Library
+//! \copyright  Copyright (c) 2022, Celemony Software GmbH, All Rights Reserved.
+//! \license    Licensed under the Apache License, Version 2.0 (the "License");
+//!             you may not use this file except in compliance with the License.
+//!             You may obtain a copy of the License at
+//!
+//!               http://www.apache.org/licenses/LICENSE-2.0
+//!
+//!             Unless required by applicable law or agreed to in writing, software
+//!             distributed under the License is distributed on an "AS IS" BASIS,
+//!             WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//!             See the License for the specific language governing permissions and
+//!             limitations under the License.
+//------------------------------------------------------------------------------
+
+#ifndef ARATuningConversion_h
+#define ARATuningConversion_h
+
+#include "ARA_API/ARAInterface.h"
+#include "ARA_Library/Debug/ARADebug.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ARA {
+
+//! @addtogroup ARA_Library_Utility_Tuning_Conversion
+//! @{
+
+/*******************************************************************************/
+//! @name Fast Approximations
+//! Polynomial approximations of log2 () and exp2 () that avoid library calls and branches,
+//! so that loops using them can be vectorized by the compiler.
+//@{
+
+//! Approximate log2 (x) for positive, normalized \p x.
+//! The absolute error is below 2e-5, which corresponds to 0.025 cent when converting frequencies.
+//! Zero, negative, denormalized or non-finite arguments yield undefined results.
+inline float fastLog2 (float x) noexcept
+{
+    uint32_t bits;
+    std::memcpy (&bits, &x, sizeof (bits));
+    const auto exponent { static_cast<float> (static_cast<int32_t> (bits >> 23) - 127) };
+    bits = (bits & 0x007FFFFFU) | 0x3F800000U;
+    float mantissa;
+    std::memcpy (&mantissa, &bits, sizeof (mantissa));
+    const auto m { mantissa - 1.0f };
+    return exponent + m * (1.44187990f + m * (-0.708865219f + m * (0.415245563f + m * (-0.193516528f + m * 0.0452682940f))));
+}
+
+//! Approximate exp2 (x) for \p x in [-125, 127], without any range checks.
+//! The relative error is below 3e-7, i.e. close to single precision float resolution.
+inline float fastExp2Unchecked (float x) noexcept
+{
+    // adding 1.5 * 2^23 rounds to the nearest integer, which can then be read from the mantissa bits
+    const auto shifted { x + 12582912.0f };
+    uint32_t shiftedBits;
+    std::memcpy (&shiftedBits, &shifted, sizeof (shiftedBits));
+    const auto exponent { static_cast<int32_t> (shiftedBits) - 0x4B400000 };
+    const auto f { x - static_cast<float> (exponent) };
+    const auto mantissa { 1.00000008f + f * (0.693147207f + f * (0.240221074f + f * (0.0555032721f + f * (0.00967603710f + f * 0.00134004320f)))) };
+
+    uint32_t bits;
+    std::memcpy (&bits, &mantissa, sizeof (bits));
+    bits += static_cast<uint32_t> (exponent) << 23;
+    float result;
+    std::memcpy (&result, &bits, sizeof (result));
+    return result;
+}
+
+//! Approximate exp2 (x) with the same error as fastExp2Unchecked ().
+//! Arguments are clamped to [-125, 127] so that the result is always a normalized float.
+//! Note that depending on the compiler settings, the clamping may prevent vectorization (GCC for
+//! example only vectorizes it with -fno-trapping-math), in which case it is preferable to ensure
+//! the valid range in a separate pass and use fastExp2Unchecked () in the vectorized loop.
+inline float fastExp2 (float x) noexcept
+{
+    x = (x < -125.0f) ? -125.0f : x;
+    x = (x > 127.0f) ? 127.0f : x;
+    return fastExp2Unchecked (x);
+}
+//@}
+
+/*******************************************************************************/
+// TuningConverter
+/** Converts between frequencies and (fractional) MIDI pitch numbers according to an ARAContentTuning.
+    The tuning is interpreted as 12 tone equal temperament based on the concert pitch frequency of
+    A4 (MIDI pitch 69), with ARAContentTuning::tunings providing the offset in cent of each pitch
+    class, starting at the pitch class of ARAContentTuning::root. Note that this means the frequency
+    of A4 will only match the concert pitch frequency if the tuning offset for A is 0.
+    A fractional pitch p denotes a deviation of (p - round (p)) semitones from the tuned pitch round (p),
+    so that integer pitches always map to the exact frequencies of the tuning.
+    The per-pitch-class offsets are precomputed upon construction.
+    The scalar conversions use the precise standard library functions, while the batch conversions
+    use fastLog2 () and fastExp2Unchecked () in loops designed to be auto-vectorized by the compiler,
+    which is considerably faster when processing analysis frames or large note collections.
+    Frequency to pitch conversion picks the tuned pitch closest to the given frequency, so it inverts
+    pitch to frequency conversion unless the deviation from the tuned pitch is close to a semitone
+    boundary (where the tuning offsets of adjacent pitch classes differ).
+ */
+/*******************************************************************************/
+
+class TuningConverter
+{
+public:
+    //! Construct for 12 tone equal temperament with A4 at 440 Hz.
+    TuningConverter () noexcept;
+
+    //! Construct for the given tuning.
+    explicit TuningConverter (const ARAContentTuning& tuning) noexcept;
+
+    //! Pitch class (0 being C, 1 being C#/Db, etc.) for the given MIDI pitch number.
+    static int32_t getPitchClassForPitchNumber (ARAPitchNumber pitchNumber) noexcept
+    {
+        return ((pitchNumber % 12) + 12) % 12;
+    }
+
+    //! Concert pitch frequency of the tuning.
+    float getConcertPitchFrequency () const noexcept { return _concertPitchFrequency; }
+
+    //! Offset of the given pitch class (0 being C) from equal temperament, in semitones.
+    float getPitchClassOffset (int32_t pitchClass) const noexcept
+    {
+        ARA_INTERNAL_ASSERT ((0 <= pitchClass) && (pitchClass < 12));
+        return _pitchClassOffsets[pitchClass];
+    }
+
+//! @name Scalar Conversions
+//@{
+    //! Frequency in Hz for the given fractional MIDI pitch.
+    float getFrequencyForPitch (float pitch) const noexcept
+    {
+        const auto tunedPitch { pitch + getPitchClassOffsetForPitch (pitch) };
+        return static_cast<float> (std::exp2 (tunedPitch / 12.0f - _equalTemperedLog2Offset));
+    }
+
+    //! Frequency in Hz for the given MIDI pitch number.
+    float getFrequencyForPitchNumber (ARAPitchNumber pitchNumber) const noexcept
+    {
+        return getFrequencyForPitch (static_cast<float> (pitchNumber));
+    }
+
+    //! Fractional MIDI pitch for the given frequency in Hz, which must be positive.
+    float getPitchForFrequency (float frequency) const noexcept
+    {
+        ARA_INTERNAL_ASSERT (frequency > 0.0f);
+        return getTunedPitch (12.0f * (std::log2 (frequency) + _equalTemperedLog2Offset));
+    }
+
+    //! Nearest MIDI pitch number for the given frequency in Hz, which must be positive.
+    ARAPitchNumber getPitchNumberForFrequency (float frequency) const noexcept
+    {
+        return static_cast<ARAPitchNumber> (std::lround (getPitchForFrequency (frequency)));
+    }
+
+    //! Deviation in cent of the given frequency from the tuned frequency of the given MIDI pitch number.
+    float getCentsForFrequency (float frequency, ARAPitchNumber pitchNumber) const noexcept
+    {
+        ARA_INTERNAL_ASSERT (frequency > 0.0f);
+        const auto equalTemperedPitch { 12.0f * (std::log2 (frequency) + _equalTemperedLog2Offset) };
+        return 100.0f * (equalTemperedPitch - getPitchClassOffset (getPitchClassForPitchNumber (pitchNumber)) - static_cast<float> (pitchNumber));
+    }
+//@}
+
+//! @name Batch Conversions
+//! Conversions of \p count values using fastLog2 () and fastExp2Unchecked ().
+//! Input and output arrays may be identical, but must not overlap otherwise.
+//@{
+    //! Frequencies in Hz for the given fractional MIDI pitches.
+    void getFrequenciesForPitches (const float* pitches, float* frequencies, size_t count) const noexcept;
+
+    //! Fractional MIDI pitches for the given frequencies in Hz, which must all be positive.
+    void getPitchesForFrequencies (const float* frequencies, float* pitches, size_t count) const noexcept;
+
+    //! Deviations in cent of the given frequencies from the tuned frequencies of the given MIDI pitch numbers.
+    void getCentsForFrequencies (const float* frequencies, const ARAPitchNumber* pitchNumbers, float* cents, size_t count) const noexcept;
+//@}
+
+private:
+    void initialize (float concertPitchFrequency, ARACircleOfFifthsIndex root, const float tunings[12]) noexcept;
+
+    float getPitchClassOffsetForPitch (float pitch) const noexcept
+    {
+        return getPitchClassOffset (getPitchClassForPitchNumber (static_cast<ARAPitchNumber> (std::lround (pitch))));
+    }
+
+    // maps an equal tempered fractional pitch to the fractional pitch relative to the closest tuned pitch
+    float getTunedPitch (float equalTemperedPitch) const noexcept
+    {
+        const auto nearestPitchNumber { static_cast<ARAPitchNumber> (std::lround (equalTemperedPitch)) };
+        auto result { equalTemperedPitch - getPitchClassOffset (getPitchClassForPitchNumber (nearestPitchNumber)) };
+        auto deviation { std::fabs (result - static_cast<float> (nearestPitchNumber)) };
+        for (auto pitchNumber { nearestPitchNumber - 1 }; pitchNumber <= nearestPitchNumber + 1; pitchNumber += 2)
+        {
+            const auto candidate { equalTemperedPitch - getPitchClassOffset (getPitchClassForPitchNumber (pitchNumber)) };
+            const auto candidateDeviation { std::fabs (candidate - static_cast<float> (pitchNumber)) };
+            if (candidateDeviation < deviation)
+            {
+                result = candidate;
+                deviation = candidateDeviation;
+            }
+        }
+        return result;
+    }
+
+private:
+    float _concertPitchFrequency;
+    float _equalTemperedLog2Offset;     // 69 / 12 - log2 (concertPitchFrequency)
+    float _pitchClassOffsets[12];       // in semitones, indexed by pitch class
+};
+
+//! @} ARA_Library_Utility_Tuning_Conversion
+
+}   // namespace ARA
+
+#endif // ARATuningConversion_h